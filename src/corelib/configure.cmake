@@ -238,6 +238,26 @@ inotify_rm_watch(0, 1);
 }
 ")
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"#include <sys/epoll.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct epoll_event ev;
+ev.events = EPOLLIN | EPOLLOUT | EPOLLPRI;
+ev.data.fd = 0;
+int epfd = epoll_create1(EPOLL_CLOEXEC);
+epoll_ctl(epfd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(epfd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 qt_config_compile_test(sysv_shm
     LABEL "System V/XSI shared memory"
     CODE
@@ -396,6 +416,33 @@ renameat2(AT_FDCWD, argv[1], AT_FDCWD, argv[2], RENAME_NOREPLACE | RENAME_WHITEO
 }
 ")
 
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+struct io_uring_sqe sqe = {};
+sqe.opcode = IORING_OP_STATX;
+sqe.statx_flags = AT_STATX_SYNC_AS_STAT;
+struct statx buf;
+(void)buf;
+int fd = syscall(__NR_io_uring_setup, 64, &params);
+syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, nullptr, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # cpp_winrt
 qt_config_compile_test(cpp_winrt
     LABEL "cpp/winrt"
@@ -477,6 +524,10 @@ qt_feature("inotify" PUBLIC PRIVATE
     CONDITION TEST_inotify
 )
 qt_feature_definition("inotify" "QT_NO_INOTIFY" NEGATE VALUE "1")
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    CONDITION LINUX AND TEST_epoll
+)
 qt_feature("ipc_posix"
     LABEL "Defaulting legacy IPC to POSIX"
     CONDITION TEST_posix_shm AND TEST_posix_sem AND (
@@ -567,6 +618,11 @@ qt_feature("renameat2" PRIVATE
     LABEL "renameat2()"
     CONDITION ( LINUX OR HURD ) AND TEST_renameat2
 )
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    PURPOSE "Provides asynchronous file I/O using io_uring."
+    CONDITION LINUX AND QT_FEATURE_future AND TEST_io_uring
+)
 qt_feature("slog2" PRIVATE
     LABEL "slog2"
     CONDITION Slog2_FOUND
@@ -836,6 +892,12 @@ qt_feature("ctf" PRIVATE
     ENABLE INPUT_trace STREQUAL 'ctf'
     DISABLE INPUT_trace STREQUAL 'etw' OR INPUT_trace STREQUAL 'no' OR INPUT_trace STREQUAL 'lttng'
 )
+qt_feature("lock_statistics" PUBLIC
+    LABEL "Lock contention statistics"
+    AUTODETECT OFF
+    CONDITION QT_FEATURE_thread
+    PURPOSE "Keeps per-lock acquisition, contention and wait time counters for QMutex and QReadWriteLock."
+)
 qt_feature("forkfd_pidfd" PRIVATE
     LABEL "CLONE_PIDFD support in forkfd"
     CONDITION LINUX
@@ -873,6 +935,8 @@ qt_configure_add_summary_entry(ARGS "backtrace")
 qt_configure_add_summary_entry(ARGS "doubleconversion")
 qt_configure_add_summary_entry(ARGS "system-doubleconversion")
 qt_configure_add_summary_entry(ARGS "forkfd_pidfd" CONDITION LINUX)
+qt_configure_add_summary_entry(ARGS "epoll" CONDITION LINUX)
+qt_configure_add_summary_entry(ARGS "io_uring" CONDITION LINUX)
 qt_configure_add_summary_entry(ARGS "glib")
 qt_configure_add_summary_entry(ARGS "icu")
 qt_configure_add_summary_entry(ARGS "system-libb2")
@@ -0,0 +1,10 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+qint64 total = 0;
+QParallelDirIterator it("/usr/share", QDir::Files, QParallelDirIterator::FetchMetaData);
+while (it.hasNext())
+    total += it.nextFileInfo().size();
+qDebug() << total << "bytes";
+//! [0]
@@ -0,0 +1,36 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+using namespace Qt::StringLiterals;
+
+//! [0]
+    QJsonStreamReader reader(&file);
+    QString name;
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::Name:
+            name = reader.text();
+            break;
+        case QJsonStreamReader::String:
+            if (reader.depth() == 1 && name == "id"_L1)
+                ids << reader.text();
+            break;
+        default:
+            break;
+        }
+    }
+    if (reader.hasError())
+        qWarning() << reader.errorString() << "at offset" << reader.offset();
+//! [0]
+
+//! [1]
+    QJsonStreamWriter writer(&file);
+    for (const Record &record : records) {
+        writer.writeStartObject();
+        writer.writeName("id"_L1);
+        writer.writeString(record.id);
+        writer.writeName("size"_L1);
+        writer.writeInteger(record.size);
+        writer.writeEndObject();    // ends the line
+    }
+//! [1]
@@ -0,0 +1,12 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    const QMultiByteArrayMatcher matcher({ "error", "warning", "timeout" },
+                                         Qt::CaseInsensitive);
+    while (!log.atEnd()) {
+        const QByteArray line = log.readLine();
+        if (matcher.indexIn(line) >= 0)
+            interesting << line;
+    }
+//! [0]
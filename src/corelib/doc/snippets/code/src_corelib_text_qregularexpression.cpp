@@ -339,4 +339,16 @@ if (m.hasMatch()) {
 //! [36]
 }
 
+{
+//! [37]
+const QRegularExpressionSet routes({
+    R"(^/users/\d+$)",
+    R"(^/users/\w+/avatar$)",
+    R"(^/static/)",
+});
+qsizetype route = routes.firstMatchingPattern(u"/users/42"); // route == 0
+QList<qsizetype> all = routes.matchingPatterns(u"/static/logo.png"); // all == { 2 }
+//! [37]
+}
+
 }
@@ -0,0 +1,847 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qasyncfileio_p.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qloggingcategory.h>
+
+#include <QtCore/private/qabstractfileengine_p.h>
+#include <QtCore/private/qfilesystemengine_p.h>
+#include <QtCore/private/qfilesystementry_p.h>
+
+#ifdef Q_OS_UNIX
+#include <QtCore/private/qcore_unix_p.h>
+#endif
+
+#if QT_CONFIG(io_uring)
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(lcAsyncFileIO, "qt.core.io.async", QtWarningMsg)
+
+namespace {
+// The results of a readFiles() call, filled in by any thread
+struct ReadBatch
+{
+    QFutureInterface<QByteArray> result;
+    QAtomicInt remaining;
+
+    void reportResult(QByteArray &&data, int index)
+    {
+        result.reportAndMoveResult(std::move(data), index);
+        if (!remaining.deref())
+            result.reportFinished();
+    }
+};
+
+QByteArray readWholeFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QByteArray data = file.readAll();
+    if (file.error() != QFileDevice::NoError)
+        return QByteArray();
+    if (data.isNull())
+        data = QByteArray("", 0);       // empty, but not an error
+    return data;
+}
+
+#ifdef Q_OS_UNIX
+QByteArray preadAll(int fd, qint64 offset, qint64 maxSize)
+{
+    QByteArray data(maxSize, Qt::Uninitialized);
+    qint64 done = 0;
+    while (done < maxSize) {
+        ssize_t ret;
+        EINTR_LOOP(ret, ::pread(fd, data.data() + done, maxSize - done, offset + done));
+        if (ret < 0)
+            return QByteArray();
+        if (ret == 0)
+            break;
+        done += ret;
+    }
+    data.truncate(done);
+    return data;
+}
+
+qint64 pwriteAll(int fd, qint64 offset, const QByteArray &data)
+{
+    qint64 done = 0;
+    while (done < data.size()) {
+        ssize_t ret;
+        EINTR_LOOP(ret, ::pwrite(fd, data.constData() + done, data.size() - done, offset + done));
+        if (ret < 0)
+            return done ? done : -1;
+        done += ret;
+    }
+    return done;
+}
+#endif // Q_OS_UNIX
+} // unnamed namespace
+
+#if QT_CONFIG(io_uring)
+/*
+    A minimal io_uring, used from any thread under a mutex, whose completions
+    are reaped by a thread of its own.
+
+    Reading a file takes an OPENAT and a STATX submitted together, then READs
+    into a buffer of the file's size and a CLOSE; the steps of many files are
+    submitted with one io_uring_enter(2), so that the number of system calls
+    doesn't grow with the number of files.
+*/
+class QIoUring
+{
+public:
+    static std::unique_ptr<QIoUring> create();
+    ~QIoUring();
+
+    void readFiles(const QList<std::pair<QByteArray, int>> &files,
+                   const std::shared_ptr<ReadBatch> &batch);
+    void read(int fd, qint64 offset, qint64 maxSize, const std::shared_ptr<ReadBatch> &batch);
+    void write(int fd, qint64 offset, const QByteArray &data,
+               const QFutureInterface<qint64> &result);
+
+private:
+    // Each job has at most two operations in flight, so completions can't
+    // overflow a completion queue twice the size of the submission queue.
+    static constexpr unsigned QueueSize = 256;
+    static constexpr int MaxActiveJobs = QueueSize / 2;
+    // Reads of files of unknown size start with this much, and double
+    static constexpr qint64 InitialChunkSize = 16 * 1024;
+    // A single read or write transfers at most this much
+    static constexpr qint64 MaxTransferSize = 1 << 30;
+
+    enum Operation : quint64 {
+        // 0 is the wake-up NOP
+        OpenOp = 1,
+        StatxOp,
+        ReadOp,
+        WriteOp,
+        CloseOp,
+        OperationMask = 7
+    };
+
+    struct alignas(8) Job
+    {
+        enum Kind : quint8 { ReadFile, ReadFd, WriteFd };
+
+        explicit Job(Kind kind) : kind(kind) {}
+
+        Kind kind;
+        bool failed = false;
+        bool reported = false;
+        int pendingOps = 0;
+        int fd = -1;
+        int index = 0;
+        qint64 offset = 0;          // where the transfer starts in the file
+        qint64 size = -1;           // to transfer, or -1 if unknown
+        qint64 done = 0;
+        QByteArray path;
+        QByteArray buffer;
+        struct statx stx;
+        std::shared_ptr<ReadBatch> readBatch;
+        QFutureInterface<qint64> writeResult;
+    };
+
+    QIoUring() = default;
+    bool setup();
+    void run();
+
+    void enqueue(Job *job);
+    void startPendingJobs();
+    void startJob(Job *job);
+    void handleCompletion(Job *job, Operation op, int res);
+    void continueTransfer(Job *job);
+    void reportResult(Job *job);
+    void finishJob(Job *job);
+    void flushReports(QMutexLocker<QMutex> &lock);
+
+    io_uring_sqe *nextSqe(Job *job, Operation op, quint8 opcode);
+    void submit();
+    bool submitQueued();
+    void failUnsubmitted();
+
+    QMutex mutex;
+    std::deque<Job *> pendingJobs;
+    // Reported once the mutex is released, as continuations attached to the
+    // futures may run right away and start more I/O
+    std::vector<std::function<void()>> pendingReports;
+    int activeJobs = 0;
+    bool stopping = false;
+    std::unique_ptr<QThread> thread;
+
+    int ringFd = -1;
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqLocalTail = 0;
+    unsigned toSubmit = 0;
+    // SQEs the kernel refused, as (user_data, fd to close)
+    std::vector<std::pair<quint64, int>> unsubmitted;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+};
+
+static_assert(sizeof(std::atomic<unsigned>) == sizeof(unsigned)
+              && std::atomic<unsigned>::is_always_lock_free);
+
+// The kernel reads and writes the ring indexes concurrently
+static unsigned loadAcquire(const unsigned *p)
+{
+    return reinterpret_cast<const std::atomic<unsigned> *>(p)->load(std::memory_order_acquire);
+}
+
+static void storeRelease(unsigned *p, unsigned value)
+{
+    reinterpret_cast<std::atomic<unsigned> *>(p)->store(value, std::memory_order_release);
+}
+
+static int qt_io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+std::unique_ptr<QIoUring> QIoUring::create()
+{
+    std::unique_ptr<QIoUring> ring(new QIoUring);
+    if (!ring->setup())
+        return nullptr;
+    ring->thread.reset(QThread::create([r = ring.get()] { r->run(); }));
+    ring->thread->setObjectName(QStringLiteral("Qt io_uring"));
+    ring->thread->start();
+    return ring;
+}
+
+bool QIoUring::setup()
+{
+    io_uring_params params = {};
+    ringFd = int(syscall(__NR_io_uring_setup, QueueSize, &params));
+    if (ringFd < 0) {
+        qCDebug(lcAsyncFileIO, "io_uring_setup failed: %s", strerror(errno));
+        return false;
+    }
+
+    // OPENAT, STATX, READ and CLOSE came with Linux 5.6
+    constexpr quint8 requiredOps[] = {
+        IORING_OP_NOP, IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_WRITE,
+        IORING_OP_CLOSE
+    };
+    constexpr int ProbeOps = 256;
+    std::unique_ptr<char[]> probeData(
+            new char[sizeof(io_uring_probe) + ProbeOps * sizeof(io_uring_probe_op)]());
+    auto probe = reinterpret_cast<io_uring_probe *>(probeData.get());
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, ProbeOps) < 0) {
+        qCDebug(lcAsyncFileIO, "io_uring probe failed: %s", strerror(errno));
+        return false;
+    }
+    for (quint8 op : requiredOps) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            qCDebug(lcAsyncFileIO, "io_uring doesn't support operation %d", op);
+            return false;
+        }
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+        return false;
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return false;
+    }
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd, IORING_OFF_SQES);
+    if (sqesMap == MAP_FAILED)
+        return false;
+    sqes = static_cast<io_uring_sqe *>(sqesMap);
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+    sqLocalTail = *sqTail;
+    // We always fill the SQEs in ring order, so the indirection is the identity
+    unsigned *sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < sqEntries; ++i)
+        sqArray[i] = i;
+
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+}
+
+QIoUring::~QIoUring()
+{
+    if (thread) {
+        {
+            // Let the thread finish the jobs in flight, then wake it up
+            QMutexLocker lock(&mutex);
+            stopping = true;
+            nextSqe(nullptr, Operation(0), IORING_OP_NOP);
+            submit();
+        }
+        thread->wait();
+    }
+
+    if (sqes != MAP_FAILED)
+        munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+/*
+    Returns a cleared SQE for \a op of \a job, submitting the queued ones
+    first if the submission queue is full. Must be called with the mutex
+    held.
+*/
+io_uring_sqe *QIoUring::nextSqe(Job *job, Operation op, quint8 opcode)
+{
+    // The jobs of SQEs that couldn't be submitted are only failed later, as
+    // the caller may still be setting up one of them
+    if (sqLocalTail - loadAcquire(sqHead) == sqEntries)
+        submitQueued();
+
+    io_uring_sqe *sqe = &sqes[sqLocalTail & sqMask];
+    ++sqLocalTail;
+    ++toSubmit;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->user_data = quintptr(job) | op;
+    if (job)
+        ++job->pendingOps;
+    return sqe;
+}
+
+/*
+    Submits the queued SQEs, failing the jobs of those the kernel doesn't
+    accept. Must be called with the mutex held, and not while setting up a
+    job.
+*/
+void QIoUring::submit()
+{
+    while (!submitQueued()) {
+        failUnsubmitted();
+        // Failed jobs made room for pending ones, which may fare better
+        startPendingJobs();
+    }
+}
+
+/*
+    Hands the queued SQEs to the kernel. If it refuses them, takes back the
+    ones it didn't consume, records them in unsubmitted and returns \c false.
+*/
+bool QIoUring::submitQueued()
+{
+    if (!toSubmit)
+        return true;
+
+    storeRelease(sqTail, sqLocalTail);
+    // EAGAIN means the kernel is short of memory for the moment; as we never
+    // have more operations in flight than the completion queue holds, waiting
+    // for completions wouldn't help, so back off for a while, then give up
+    constexpr int MaxRetries = 10;
+    int retries = 0;
+    while (toSubmit) {
+        const int ret = qt_io_uring_enter(ringFd, toSubmit, 0, 0);
+        if (ret >= 0) {
+            toSubmit -= unsigned(ret);
+            continue;
+        }
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN && retries < MaxRetries) {
+            QThread::usleep(1ul << (2 * retries++));     // from 1 us to about 0.26 s
+            continue;
+        }
+        qCWarning(lcAsyncFileIO, "io_uring_enter failed: %s", strerror(errno));
+
+        // Without SQPOLL, the kernel only consumes SQEs inside io_uring_enter(),
+        // which nobody else calls while we hold the mutex
+        const unsigned head = loadAcquire(sqHead);
+        for (unsigned i = head; i != sqLocalTail; ++i) {
+            const io_uring_sqe &sqe = sqes[i & sqMask];
+            unsubmitted.emplace_back(sqe.user_data, sqe.opcode == IORING_OP_CLOSE ? sqe.fd : -1);
+        }
+        sqLocalTail = head;
+        storeRelease(sqTail, sqLocalTail);
+        toSubmit = 0;
+        return false;
+    }
+    return true;
+}
+
+/*
+    Completes the operations that couldn't be submitted as failed, without
+    going through the ring again.
+*/
+void QIoUring::failUnsubmitted()
+{
+    for (const auto &[userData, closeFd] : std::exchange(unsubmitted, {})) {
+        const auto op = Operation(userData & OperationMask);
+        if (!op)
+            continue;       // the wake-up NOP
+        Job *job = reinterpret_cast<Job *>(userData & ~quint64(OperationMask));
+        if (op == CloseOp)
+            qt_safe_close(closeFd);
+        else
+            job->failed = true;
+        if (--job->pendingOps)
+            continue;       // the other operation was submitted and completes normally
+
+        if (job->fd >= 0) {
+            qt_safe_close(job->fd);
+            job->fd = -1;
+        }
+        reportResult(job);
+        delete job;
+        --activeJobs;
+    }
+}
+
+void QIoUring::run()
+{
+    for (;;) {
+        if (qt_io_uring_enter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+            qCWarning(lcAsyncFileIO, "io_uring_enter failed: %s", strerror(errno));
+            return;
+        }
+
+        QMutexLocker lock(&mutex);
+        unsigned head = *cqHead;
+        const unsigned tail = loadAcquire(cqTail);
+        for ( ; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & cqMask];
+            const auto op = Operation(cqe.user_data & OperationMask);
+            if (op)
+                handleCompletion(reinterpret_cast<Job *>(cqe.user_data & ~quint64(OperationMask)),
+                                 op, cqe.res);
+        }
+        storeRelease(cqHead, head);
+
+        startPendingJobs();
+        submit();
+        const bool done = stopping && activeJobs == 0;
+        flushReports(lock);
+        if (done)
+            return;
+    }
+}
+
+void QIoUring::flushReports(QMutexLocker<QMutex> &lock)
+{
+    if (pendingReports.empty())
+        return;
+    const auto reports = std::exchange(pendingReports, {});
+    lock.unlock();
+    for (const auto &report : reports)
+        report();
+}
+
+void QIoUring::enqueue(Job *job)
+{
+    pendingJobs.push_back(job);
+}
+
+void QIoUring::readFiles(const QList<std::pair<QByteArray, int>> &files,
+                         const std::shared_ptr<ReadBatch> &batch)
+{
+    QMutexLocker lock(&mutex);
+    for (const auto &[path, index] : files) {
+        Job *job = new Job(Job::ReadFile);
+        job->path = path;
+        job->index = index;
+        job->readBatch = batch;
+        enqueue(job);
+    }
+    startPendingJobs();
+    submit();
+    flushReports(lock);
+}
+
+void QIoUring::read(int fd, qint64 offset, qint64 maxSize, const std::shared_ptr<ReadBatch> &batch)
+{
+    Job *job = new Job(Job::ReadFd);
+    job->fd = fd;
+    job->offset = offset;
+    job->size = maxSize;
+    job->readBatch = batch;
+
+    QMutexLocker lock(&mutex);
+    enqueue(job);
+    startPendingJobs();
+    submit();
+    flushReports(lock);
+}
+
+void QIoUring::write(int fd, qint64 offset, const QByteArray &data,
+                     const QFutureInterface<qint64> &result)
+{
+    Job *job = new Job(Job::WriteFd);
+    job->fd = fd;
+    job->offset = offset;
+    job->size = data.size();
+    job->buffer = data;
+    job->writeResult = result;
+
+    QMutexLocker lock(&mutex);
+    enqueue(job);
+    startPendingJobs();
+    submit();
+    flushReports(lock);
+}
+
+void QIoUring::startPendingJobs()
+{
+    while (activeJobs < MaxActiveJobs && !pendingJobs.empty()) {
+        Job *job = pendingJobs.front();
+        pendingJobs.pop_front();
+        ++activeJobs;
+        startJob(job);
+    }
+}
+
+void QIoUring::startJob(Job *job)
+{
+    switch (job->kind) {
+    case Job::ReadFile:
+        if (job->readBatch->result.isCanceled()) {
+            job->failed = true;
+            return finishJob(job);
+        } else {
+            io_uring_sqe *sqe = nextSqe(job, OpenOp, IORING_OP_OPENAT);
+            sqe->fd = AT_FDCWD;
+            sqe->addr = quintptr(job->path.constData());
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+
+            sqe = nextSqe(job, StatxOp, IORING_OP_STATX);
+            sqe->fd = AT_FDCWD;
+            sqe->addr = quintptr(job->path.constData());
+            sqe->len = STATX_TYPE | STATX_SIZE;
+            sqe->off = quintptr(&job->stx);
+        }
+        break;
+
+    case Job::ReadFd:
+        job->buffer.resize(job->size);
+        continueTransfer(job);
+        break;
+
+    case Job::WriteFd:
+        continueTransfer(job);
+        break;
+    }
+}
+
+/*
+    Submits the next read or write of \a job, or completes it if the
+    transfer is done.
+*/
+void QIoUring::continueTransfer(Job *job)
+{
+    if (job->size >= 0 && job->done == job->size) {
+        reportResult(job);
+        return finishJob(job);
+    }
+
+    if (job->kind == Job::WriteFd) {
+        io_uring_sqe *sqe = nextSqe(job, WriteOp, IORING_OP_WRITE);
+        sqe->fd = job->fd;
+        sqe->addr = quintptr(job->buffer.constData() + job->done);
+        sqe->len = unsigned(qMin(job->size - job->done, MaxTransferSize));
+        sqe->off = quint64(job->offset + job->done);
+        return;
+    }
+
+    // Unknown size: grow the buffer as it fills up
+    if (job->size < 0 && job->done == job->buffer.size())
+        job->buffer.resize(qMax(job->buffer.size() * 2, InitialChunkSize));
+
+    io_uring_sqe *sqe = nextSqe(job, ReadOp, IORING_OP_READ);
+    sqe->fd = job->fd;
+    sqe->addr = quintptr(job->buffer.data() + job->done);
+    sqe->len = unsigned(qMin(job->buffer.size() - job->done, MaxTransferSize));
+    sqe->off = quint64(job->offset + job->done);
+}
+
+void QIoUring::handleCompletion(Job *job, Operation op, int res)
+{
+    --job->pendingOps;
+
+    switch (op) {
+    case OpenOp:
+        if (res < 0)
+            job->failed = true;
+        else
+            job->fd = res;
+        break;
+
+    case StatxOp:
+        if (res < 0) {
+            job->failed = true;
+        } else if (S_ISDIR(job->stx.stx_mode)) {
+            job->failed = true;         // like QFile::open()
+        } else if (S_ISREG(job->stx.stx_mode) && job->stx.stx_size > 0) {
+            // Files in /proc and /sys claim a size of 0
+            job->size = qint64(job->stx.stx_size);
+        }
+        break;
+
+    case ReadOp:
+    case WriteOp:
+        if (res == -EINTR || res == -EAGAIN) {
+            // try again
+        } else if (res < 0) {
+            job->failed = true;
+        } else if (res == 0) {
+            // end of file
+            if (op == WriteOp)
+                job->failed = true;
+            else
+                job->size = job->done;
+        } else {
+            job->done += res;
+        }
+        break;
+
+    case CloseOp:
+        break;
+
+    case OperationMask:
+        Q_UNREACHABLE();
+    }
+
+    if (job->pendingOps)
+        return;     // wait for the other one
+
+    if (op == CloseOp || (job->failed && job->fd < 0))
+        return finishJob(job);
+
+    if (job->failed) {
+        reportResult(job);
+        return finishJob(job);
+    }
+
+    if (op == OpenOp || op == StatxOp)
+        job->buffer.resize(job->size >= 0 ? job->size : InitialChunkSize);
+    continueTransfer(job);
+}
+
+void QIoUring::reportResult(Job *job)
+{
+    if (job->reported)
+        return;
+    job->reported = true;
+
+    if (job->kind == Job::WriteFd) {
+        // a partial write is still progress
+        const qint64 written = job->failed && job->done == 0 ? -1 : job->done;
+        pendingReports.push_back([result = std::exchange(job->writeResult, {}), written]() mutable {
+            result.reportAndMoveResult(qint64(written));
+            result.reportFinished();
+        });
+    } else {
+        QByteArray data;
+        if (!job->failed) {
+            data = std::move(job->buffer);
+            data.truncate(job->done);
+        }
+        pendingReports.push_back([batch = std::move(job->readBatch), data = std::move(data),
+                                  index = job->index]() mutable {
+            batch->reportResult(std::move(data), index);
+        });
+    }
+    job->buffer = QByteArray();
+}
+
+/*
+    Closes the file of \a job if it has one, then releases it.
+*/
+void QIoUring::finishJob(Job *job)
+{
+    reportResult(job);
+
+    if (job->fd >= 0) {
+        io_uring_sqe *sqe = nextSqe(job, CloseOp, IORING_OP_CLOSE);
+        sqe->fd = job->fd;
+        job->fd = -1;
+        return;
+    }
+
+    delete job;
+    --activeJobs;
+}
+#endif // QT_CONFIG(io_uring)
+
+QAsyncFileIO::QAsyncFileIO(Backend backend)
+{
+#if QT_CONFIG(io_uring)
+    if (backend == Backend::Automatic)
+        ring = QIoUring::create();
+#else
+    Q_UNUSED(backend);
+#endif
+}
+
+QAsyncFileIO::~QAsyncFileIO()
+{
+    pool.waitForDone();
+}
+
+Q_GLOBAL_STATIC(QAsyncFileIO, asyncFileIO)
+
+QAsyncFileIO *QAsyncFileIO::instance()
+{
+    return asyncFileIO();
+}
+
+bool QAsyncFileIO::usesIoUring() const
+{
+#if QT_CONFIG(io_uring)
+    return bool(ring);
+#else
+    return false;
+#endif
+}
+
+QFuture<QByteArray> QAsyncFileIO::readFiles(const QStringList &fileNames)
+{
+    auto batch = std::make_shared<ReadBatch>();
+    batch->result.reportStarted();
+    QFuture<QByteArray> future = batch->result.future();
+    if (fileNames.isEmpty()) {
+        batch->result.reportFinished();
+        return future;
+    }
+    batch->remaining.storeRelaxed(int(fileNames.size()));
+
+#if QT_CONFIG(io_uring)
+    QList<std::pair<QByteArray, int>> nativeFiles;
+#endif
+    for (int i = 0; i < fileNames.size(); ++i) {
+        const QString &fileName = fileNames.at(i);
+#if QT_CONFIG(io_uring)
+        if (ring && !fileName.isEmpty()) {
+            QFileSystemEntry entry(fileName);
+            QFileSystemMetaData metaData;
+            std::unique_ptr<QAbstractFileEngine> engine(
+                    QFileSystemEngine::resolveEntryAndCreateLegacyEngine(entry, metaData));
+            if (!engine) {
+                nativeFiles.append({ entry.nativeFilePath(), i });
+                continue;
+            }
+        }
+#endif
+        // Resources and other file engines, or no io_uring
+        pool.start([batch, fileName, i] {
+            batch->reportResult(readWholeFile(fileName), i);
+        });
+    }
+#if QT_CONFIG(io_uring)
+    if (!nativeFiles.isEmpty())
+        ring->readFiles(nativeFiles, batch);
+#endif
+    return future;
+}
+
+#ifdef Q_OS_UNIX
+QFuture<QByteArray> QAsyncFileIO::read(int fd, qint64 offset, qint64 maxSize)
+{
+    auto batch = std::make_shared<ReadBatch>();
+    batch->result.reportStarted();
+    batch->remaining.storeRelaxed(1);
+    QFuture<QByteArray> future = batch->result.future();
+
+    fd = qt_safe_dup(fd);
+    if (fd < 0) {
+        batch->reportResult(QByteArray(), 0);
+        return future;
+    }
+
+#if QT_CONFIG(io_uring)
+    if (ring) {
+        ring->read(fd, offset, maxSize, batch);
+        return future;
+    }
+#endif
+    pool.start([batch, fd, offset, maxSize] {
+        batch->reportResult(preadAll(fd, offset, maxSize), 0);
+        qt_safe_close(fd);
+    });
+    return future;
+}
+
+QFuture<qint64> QAsyncFileIO::write(int fd, qint64 offset, const QByteArray &data)
+{
+    QFutureInterface<qint64> result;
+    result.reportStarted();
+    QFuture<qint64> future = result.future();
+
+    fd = qt_safe_dup(fd);
+    if (fd < 0) {
+        result.reportAndMoveResult(qint64(-1));
+        result.reportFinished();
+        return future;
+    }
+
+#if QT_CONFIG(io_uring)
+    if (ring) {
+        ring->write(fd, offset, data, result);
+        return future;
+    }
+#endif
+    pool.start([result, fd, offset, data]() mutable {
+        result.reportAndMoveResult(pwriteAll(fd, offset, data));
+        result.reportFinished();
+        qt_safe_close(fd);
+    });
+    return future;
+}
+#endif // Q_OS_UNIX
+
+QT_END_NAMESPACE
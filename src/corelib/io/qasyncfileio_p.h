@@ -0,0 +1,71 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QASYNCFILEIO_P_H
+#define QASYNCFILEIO_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qthreadpool.h>
+
+#include <memory>
+
+QT_REQUIRE_CONFIG(future);
+
+QT_BEGIN_NAMESPACE
+
+class QIoUring;
+
+// Backs QFile's asynchronous functions. On Linux, the operations are
+// submitted to an io_uring, many at once, and a single thread reaps their
+// completions; elsewhere, or if the kernel doesn't support io_uring, they run
+// as blocking calls on the threads of a private pool.
+class Q_AUTOTEST_EXPORT QAsyncFileIO
+{
+public:
+    enum class Backend {
+        Automatic,
+        ThreadPool
+    };
+
+    explicit QAsyncFileIO(Backend backend = Backend::Automatic);
+    ~QAsyncFileIO();
+
+    static QAsyncFileIO *instance();
+
+    bool usesIoUring() const;
+
+    // One result per file, in the same order; a null QByteArray if the file
+    // couldn't be read.
+    QFuture<QByteArray> readFiles(const QStringList &fileNames);
+#ifdef Q_OS_UNIX
+    // The file descriptor is duplicated, so the caller may close it before
+    // the operation has finished.
+    QFuture<QByteArray> read(int fd, qint64 offset, qint64 maxSize);
+    QFuture<qint64> write(int fd, qint64 offset, const QByteArray &data);
+#endif
+
+private:
+    Q_DISABLE_COPY_MOVE(QAsyncFileIO)
+
+    QThreadPool pool;
+#if QT_CONFIG(io_uring)
+    std::unique_ptr<QIoUring> ring;
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QASYNCFILEIO_P_H
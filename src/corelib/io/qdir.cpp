@@ -6,6 +6,7 @@
 #include "qdir_p.h"
 #include "qabstractfileengine_p.h"
 #include "qfsfileengine_p.h"
+#include "qfileinfo_p.h"
 #ifndef QT_NO_DEBUG_STREAM
 #include "qdebug.h"
 #endif
@@ -313,6 +314,18 @@ inline void QDirPrivate::sortFileList(QDir::SortFlags sort, const QFileInfoList
                 names->append(fi.fileName());
         }
     } else {
+        // Sorting by size or time stats every entry; do it for all of them
+        // up front rather than from the comparisons.
+        QFileSystemMetaData::MetaDataFlags needed;
+        if (sort & (QDir::DirsFirst | QDir::DirsLast))
+            needed |= QFileSystemMetaData::DirectoryType;
+        if ((sort & QDir::SortByMask) == QDir::Time)
+            needed |= QFileSystemMetaData::ModificationTime;
+        else if ((sort & QDir::SortByMask) == QDir::Size)
+            needed |= QFileSystemMetaData::SizeAttribute;
+        if (needed)
+            QFileInfoPrivate::prefetchMetaData(l, needed);
+
         QScopedArrayPointer<QDirSortItem> si(new QDirSortItem[n]);
         for (qsizetype i = 0; i < n; ++i)
             si[i] = QDirSortItem{l.at(i), sort};
@@ -0,0 +1,47 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QDIRENTRYFILTER_P_H
+#define QDIRENTRYFILTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qstringlist.h>
+#if QT_CONFIG(regularexpression)
+#include <QtCore/qregularexpression.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+// The name filters and entry filters of QDirIterator, which
+// QParallelDirIterator applies the same way
+class QDirEntryFilter
+{
+public:
+    QDirEntryFilter(const QStringList &nameFilters, QDir::Filters filters);
+
+    bool matches(const QString &fileName, const QFileInfo &fi) const;
+
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+
+private:
+#if QT_CONFIG(regularexpression)
+    QList<QRegularExpression> nameRegExps;
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QDIRENTRYFILTER_P_H
@@ -56,13 +56,11 @@
 #include "qdiriterator.h"
 #include "qdir_p.h"
 #include "qabstractfileengine_p.h"
+#include "qdirentryfilter_p.h"
 
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
-#if QT_CONFIG(regularexpression)
-#include <QtCore/qregularexpression.h>
-#endif
 
 #include <QtCore/private/qfilesystemiterator_p.h>
 #include <QtCore/private/qfilesystementry_p.h>
@@ -98,19 +96,13 @@ public:
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
     void pushDirectory(const QFileInfo &fileInfo);
     void checkAndPushDirectory(const QFileInfo &);
-    bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
 
     std::unique_ptr<QAbstractFileEngine> engine;
 
     QFileSystemEntry dirEntry;
-    const QStringList nameFilters;
-    const QDir::Filters filters;
+    const QDirEntryFilter entryFilter;
     const QDirIterator::IteratorFlags iteratorFlags;
 
-#if QT_CONFIG(regularexpression)
-    QList<QRegularExpression> nameRegExps;
-#endif
-
     QDirIteratorPrivateIteratorStack<QAbstractFileEngineIterator> fileEngineIterators;
 #ifndef QT_NO_FILESYSTEMITERATOR
     QDirIteratorPrivateIteratorStack<QFileSystemIterator> nativeIterators;
@@ -129,18 +121,9 @@ public:
 QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
                                          QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine)
     : dirEntry(entry)
-      , nameFilters(nameFilters.contains("*"_L1) ? QStringList() : nameFilters)
-      , filters(QDir::NoFilter == _filters ? QDir::AllEntries : _filters)
+      , entryFilter(nameFilters, _filters)
       , iteratorFlags(flags)
 {
-#if QT_CONFIG(regularexpression)
-    nameRegExps.reserve(nameFilters.size());
-    for (const auto &filter : nameFilters) {
-        auto re = QRegularExpression::fromWildcard(filter, (filters & QDir::CaseSensitive ?
-                                                            Qt::CaseSensitive : Qt::CaseInsensitive));
-        nameRegExps.append(re);
-    }
-#endif
     QFileSystemMetaData metaData;
     if (resolveEngine)
         engine.reset(QFileSystemEngine::resolveEntryAndCreateLegacyEngine(dirEntry, metaData));
@@ -171,7 +154,8 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
 
     if (engine) {
         engine->setFileName(path);
-        QAbstractFileEngineIterator *it = engine->beginEntryList(filters, nameFilters);
+        QAbstractFileEngineIterator *it = engine->beginEntryList(entryFilter.filters,
+                                                                    entryFilter.nameFilters);
         if (it) {
             it->setPath(path);
             fileEngineIterators << it;
@@ -181,7 +165,7 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
     } else {
 #ifndef QT_NO_FILESYSTEMITERATOR
         QFileSystemIterator *it = new QFileSystemIterator(fileInfo.d_ptr->fileEntry,
-            filters, nameFilters, iteratorFlags);
+            entryFilter.filters, entryFilter.nameFilters, iteratorFlags);
         nativeIterators << it;
 #else
         qWarning("Qt was built with -no-feature-filesystemiterator: no files/plugins will be found!");
@@ -193,7 +177,7 @@ inline bool QDirIteratorPrivate::entryMatches(const QString & fileName, const QF
 {
     checkAndPushDirectory(fileInfo);
 
-    if (matchesFilters(fileName, fileInfo)) {
+    if (entryFilter.matches(fileName, fileInfo)) {
         currentFileInfo = nextFileInfo;
         nextFileInfo = fileInfo;
 
@@ -271,12 +255,34 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
         return;
 
     // No hidden directories unless requested
+    const QDir::Filters filters = entryFilter.filters;
     if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fileInfo.isHidden())
         return;
 
     pushDirectory(fileInfo);
 }
 
+/*!
+    \internal
+
+    Normalizes \a nameFilters and \a filters as the iterators expect them:
+    a "*" name filter matches everything, and QDir::NoFilter means
+    QDir::AllEntries.
+*/
+QDirEntryFilter::QDirEntryFilter(const QStringList &nameFilters, QDir::Filters filters)
+    : nameFilters(nameFilters.contains("*"_L1) ? QStringList() : nameFilters)
+      , filters(QDir::NoFilter == filters ? QDir::AllEntries : filters)
+{
+#if QT_CONFIG(regularexpression)
+    nameRegExps.reserve(nameFilters.size());
+    for (const auto &filter : nameFilters) {
+        auto re = QRegularExpression::fromWildcard(filter, (this->filters & QDir::CaseSensitive ?
+                                                            Qt::CaseSensitive : Qt::CaseInsensitive));
+        nameRegExps.append(re);
+    }
+#endif
+}
+
 /*!
     \internal
 
@@ -288,7 +294,7 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
     otherwise, false is returned.
 */
 
-bool QDirIteratorPrivate::matchesFilters(const QString &fileName, const QFileInfo &fi) const
+bool QDirEntryFilter::matches(const QString &fileName, const QFileInfo &fi) const
 {
     if (fileName.isEmpty())
         return false;
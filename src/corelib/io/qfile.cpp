@@ -15,6 +15,10 @@
 #include "private/qfilesystemengine_p.h"
 #include "private/qsystemerror_p.h"
 #include "private/qtemporaryfile_p.h"
+#if QT_CONFIG(future)
+#include "qfuture.h"
+#include "private/qasyncfileio_p.h"
+#endif
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
@@ -1158,6 +1162,146 @@ qint64 QFile::size() const
     return QFileDevice::size(); // for now
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.7
+
+    Starts reading at most \a maxSize bytes from the file, starting at
+    \a offset, and returns a future that provides the bytes read when the
+    read has finished. The result is a null QByteArray if the read failed,
+    and is shorter than \a maxSize if the end of the file was reached.
+
+    The file must be open for reading, and must not be sequential. The
+    read doesn't use or move the current position, and is independent of
+    the data buffered by read() and write(). Data that write() buffered is
+    flushed first. The file may be closed, or this QFile destroyed, before
+    the read has finished.
+
+    On Linux, the read is submitted to an io_uring if the kernel supports
+    it; on other Unix systems, it is done by a thread of a pool private to
+    Qt. On other platforms, and for a file that has no native handle, such
+    as a resource, the file is read before this function returns, and the
+    returned future has already finished.
+
+    \sa writeAsync(), readAllAsync()
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 maxSize)
+{
+    if (!isReadable()) {
+        qWarning("QFile::readAsync: File not open for reading");
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    }
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QFile::readAsync: Invalid offset or size");
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    }
+    if (isSequential()) {
+        qWarning("QFile::readAsync: Cannot read from a sequential file at an offset");
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    }
+    if (isWritable())
+        flush();
+    maxSize = qBound(qint64(0), size() - offset, maxSize);
+
+#ifdef Q_OS_UNIX
+    if (const int fd = handle(); fd != -1)
+        return QAsyncFileIO::instance()->read(fd, offset, maxSize);
+#endif
+
+    // No native handle: read here, restoring the position afterwards
+    QByteArray data;
+    const qint64 oldPos = pos();
+    if (seek(offset)) {
+        data = read(maxSize);
+        if (data.isNull() && error() == NoError)
+            data = QByteArray("", 0);
+    }
+    seek(oldPos);
+    return QtFuture::makeReadyValueFuture(std::move(data));
+}
+
+/*!
+    \since 6.7
+
+    Starts writing \a data to the file at \a offset, and returns a future
+    that provides the number of bytes written when the write has finished,
+    or -1 if nothing could be written.
+
+    The file must be open for writing. The write doesn't use or move the
+    current position, and bypasses the buffer of write(), which is flushed
+    first. The size() of this QFile may not reflect the write until the
+    file is reopened. The file may be closed, or this QFile destroyed,
+    before the write has finished.
+
+    On Unix systems, the write is done asynchronously as described for
+    readAsync(). On other platforms, and for a file that has no native
+    handle, the data is written before this function returns, and the
+    returned future has already finished.
+
+    \sa readAsync()
+*/
+QFuture<qint64> QFile::writeAsync(qint64 offset, const QByteArray &data)
+{
+    if (!isWritable()) {
+        qWarning("QFile::writeAsync: File not open for writing");
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    }
+    if (offset < 0) {
+        qWarning("QFile::writeAsync: Invalid offset");
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    }
+    flush();
+
+#ifdef Q_OS_UNIX
+    if (const int fd = handle(); fd != -1)
+        return QAsyncFileIO::instance()->write(fd, offset, data);
+#endif
+
+    // No native handle: write here, restoring the position afterwards
+    qint64 written = -1;
+    const qint64 oldPos = pos();
+    if (seek(offset)) {
+        written = write(data);
+        flush();
+    }
+    seek(oldPos);
+    return QtFuture::makeReadyValueFuture(std::move(written));
+}
+
+/*!
+    \since 6.7
+
+    Starts reading the files named \a fileNames, and returns a future that
+    provides the contents of each file as a separate result, in the same
+    order as \a fileNames. The result for a file that couldn't be read is
+    a null QByteArray; an empty file results in an empty, non-null one.
+
+    This is meant for loading many files at once, for example at startup.
+    On Linux, the files are opened, measured and read with an io_uring if
+    the kernel supports it, with the steps of many files submitted to the
+    kernel together, so that the number of system calls doesn't grow with
+    the number of files. Elsewhere, and for files that are not accessed
+    natively, such as resources, each file is read by a thread of a pool
+    private to Qt.
+
+    Canceling the future stops reading files that haven't been started
+    yet.
+
+    \code
+    const QFuture<QByteArray> future = QFile::readAllAsync(fileNames);
+    future.waitForFinished();
+    for (int i = 0; i < fileNames.size(); ++i)
+        load(fileNames.at(i), future.resultAt(i));
+    \endcode
+
+    \sa readAsync()
+*/
+QFuture<QByteArray> QFile::readAllAsync(const QStringList &fileNames)
+{
+    return QAsyncFileIO::instance()->readFiles(fileNames);
+}
+#endif // QT_CONFIG(future)
+
 /*!
     \fn QFile::QFile(const std::filesystem::path &name)
     \since 6.0
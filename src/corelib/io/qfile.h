@@ -81,6 +81,9 @@ using ForceFilesystemPath = typename std::enable_if_t<std::is_same_v<std::filesy
 
 class QTemporaryFile;
 class QFilePrivate;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 // ### Qt 7: remove this, and make constructors always explicit.
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)) || defined(QT_EXPLICIT_QFILE_CONSTRUCTION_FROM_PATH)
@@ -312,6 +315,12 @@ public:
     }
 #endif // QT_CONFIG(cxx17_filesystem)
 
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+    static QFuture<QByteArray> readAllAsync(const QStringList &fileNames);
+#endif
+
 protected:
 #ifdef QT_NO_QOBJECT
     QFile(QFilePrivate &dd);
@@ -7,6 +7,15 @@
 #include "qdir.h"
 #include "qfileinfo_p.h"
 #include "qdebug.h"
+#include "qvarlengtharray.h"
+
+#if QT_CONFIG(thread)
+#  include "qsemaphore.h"
+#  include "qthread.h"
+#  include "qthreadpool.h"
+#endif
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -186,6 +195,71 @@ QDateTime &QFileInfoPrivate::getFileTime(QAbstractFileEngine::FileTime request)
     return fileTimes[request];
 }
 
+/*!
+    \internal
+
+    Fetches the metadata in \a what for all the native entries in \a list
+    that don't have it cached yet, so that accessing it afterwards, e.g. while
+    sorting, doesn't go to the file system one entry at a time. Large lists are
+    split in chunks that are stat'ed by threads of the global thread pool,
+    with the calling thread taking part; the function returns once all of
+    them are done.
+
+    As with QFileInfo's own lazy fetching, the metadata is stored in the
+    shared private, so all copies of the entries see it.
+*/
+void QFileInfoPrivate::prefetchMetaData(const QFileInfoList &list,
+                                        QFileSystemMetaData::MetaDataFlags what)
+{
+    QVarLengthArray<const QFileInfoPrivate *, 256> pending;
+    for (const QFileInfo &fi : list) {
+        const QFileInfoPrivate *d = fi.d_ptr.constData();
+        if (d->isDefaultConstructed || d->fileEngine || !d->cache_enabled
+                || d->metaData.hasFlags(what)) {
+            continue;
+        }
+        pending.append(d);
+    }
+    // copies of the same QFileInfo share the private; fetch it only once
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+    const auto fetch = [&pending, what](qsizetype from, qsizetype to) {
+        for (qsizetype i = from; i < to; ++i) {
+            const QFileInfoPrivate *d = pending[i];
+            // ignore errors, fillMetaData will have cleared the flags
+            QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, what);
+        }
+    };
+
+#if QT_CONFIG(thread)
+    constexpr qsizetype ChunkSize = 64;
+    const qsizetype chunks = (pending.size() + ChunkSize - 1) / ChunkSize;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype maxHelpers = qMin(chunks, qsizetype(QThread::idealThreadCount())) - 1;
+    if (pool && maxHelpers > 0) {
+        QAtomicInteger<qsizetype> nextChunk = 0;
+        const auto work = [&] {
+            qsizetype chunk;
+            while ((chunk = nextChunk.fetchAndAddRelaxed(1)) < chunks)
+                fetch(chunk * ChunkSize, qMin((chunk + 1) * ChunkSize, pending.size()));
+        };
+
+        // Only take threads that are idle right now: queueing behind
+        // unrelated tasks would make us wait for those, too.
+        QSemaphore done;
+        int helpers = 0;
+        while (helpers < maxHelpers && pool->tryStart([&] { work(); done.release(); }))
+            ++helpers;
+        work();
+        done.acquire(helpers);
+        return;
+    }
+#endif
+
+    fetch(0, pending.size());
+}
+
 //************* QFileInfo
 
 /*!
@@ -1723,6 +1797,30 @@ void QFileInfo::stat()
     QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::AllMetaDataFlags);
 }
 
+/*!
+    \since 6.7
+    \overload
+
+    Reads all attributes from the file system for each of \a infos that
+    doesn't have them cached yet.
+
+    Large lists are read by several threads of the global thread pool, so
+    this is faster than calling stat() on each entry, or letting each entry
+    read its attributes when they are first asked for, when many entries
+    will be queried anyway, for example before sorting them by size or
+    date. Entries with caching disabled, and entries that are not files on
+    the native file system, such as resources, are skipped.
+
+    As the attributes are cached in the shared data of each QFileInfo, all
+    copies of the entries benefit.
+
+    \sa setCaching(), refresh()
+*/
+void QFileInfo::stat(const QList<QFileInfo> &infos)
+{
+    QFileInfoPrivate::prefetchMetaData(infos, QFileSystemMetaData::AllMetaDataFlags);
+}
+
 /*!
     \typedef QFileInfoList
     \relates QFileInfo
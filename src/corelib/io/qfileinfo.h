@@ -21,6 +21,7 @@ class QFileInfoPrivate;
 class Q_CORE_EXPORT QFileInfo
 {
     friend class QDirIteratorPrivate;
+    friend class QFileInfoPrivate;
 public:
     explicit QFileInfo(QFileInfoPrivate *d);
 
@@ -166,6 +167,7 @@ public:
     bool caching() const;
     void setCaching(bool on);
     void stat();
+    static void stat(const QList<QFileInfo> &infos);
 
 protected:
     QSharedDataPointer<QFileInfoPrivate> d_ptr;
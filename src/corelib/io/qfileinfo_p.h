@@ -126,6 +126,9 @@ public:
     QString getFileName(QAbstractFileEngine::FileName) const;
     QString getFileOwner(QAbstractFileEngine::FileOwner own) const;
 
+    Q_AUTOTEST_EXPORT static void prefetchMetaData(const QFileInfoList &list,
+                                                     QFileSystemMetaData::MetaDataFlags what);
+
     QFileSystemEntry fileEntry;
     mutable QFileSystemMetaData metaData;
 
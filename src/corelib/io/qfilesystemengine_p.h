@@ -92,6 +92,9 @@ public:
 #if defined(Q_OS_UNIX)
     static bool cloneFile(int srcfd, int dstfd, const QFileSystemMetaData &knownData);
     static bool fillMetaData(int fd, QFileSystemMetaData &data); // what = PosixStatFlags
+    // what = LinkType | PosixStatFlags | ExistsAttribute, of name in dirFd, which is entry:
+    static bool fillMetaData(int dirFd, const char *name, const QFileSystemEntry &entry,
+                             QFileSystemMetaData &data);
     static QByteArray id(int fd);
     static bool setFileTime(int fd, const QDateTime &newDate,
                             QAbstractFileEngine::FileTime whatTime, QSystemError &error);
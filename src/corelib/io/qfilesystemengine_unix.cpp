@@ -288,6 +288,11 @@ static int qt_fstatx(int fd, struct statx *statxBuffer)
     return qt_real_statx(fd, "", AT_EMPTY_PATH, statxBuffer);
 }
 
+static int qt_statxat(int dirFd, const char *name, int flags, struct statx *statxBuffer)
+{
+    return qt_real_statx(dirFd, name, flags, statxBuffer);
+}
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
 {
     // Permissions
@@ -349,6 +354,9 @@ static int qt_lstatx(const char *, struct statx *)
 static int qt_fstatx(int, struct statx *)
 { return -ENOSYS; }
 
+static int qt_statxat(int, const char *, int, struct statx *)
+{ return -ENOSYS; }
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &)
 { }
 #endif
@@ -380,6 +388,41 @@ bool QFileSystemEngine::fillMetaData(int fd, QFileSystemMetaData &data)
     return false;
 }
 
+//static
+bool QFileSystemEngine::fillMetaData(int dirFd, const char *name, const QFileSystemEntry &entry,
+                                     QFileSystemMetaData &data)
+{
+    constexpr auto what = QFileSystemMetaData::LinkType | QFileSystemMetaData::PosixStatFlags
+            | QFileSystemMetaData::ExistsAttribute;
+
+    // Like fillMetaData() below, but with statx(2) relative to the directory,
+    // which spares the kernel walking the whole path again.
+    struct statx statxBuffer;
+    int ret = qt_statxat(dirFd, name, AT_SYMLINK_NOFOLLOW, &statxBuffer);
+    if (ret == -ENOSYS)
+        return fillMetaData(entry, data, what);
+
+    data.entryFlags &= ~what;
+    data.knownFlagsMask |= what;
+    if (ret == 0 && S_ISLNK(statxBuffer.stx_mode)) {
+        data.entryFlags |= QFileSystemMetaData::LinkType;
+        ret = qt_statxat(dirFd, name, 0, &statxBuffer);
+    }
+    if (ret != 0) {
+        // gone, or a broken symlink
+        data.birthTime_ = 0;
+        data.metadataChangeTime_ = 0;
+        data.modificationTime_ = 0;
+        data.accessTime_ = 0;
+        data.size_ = 0;
+        data.userId_ = (uint) -2;
+        data.groupId_ = (uint) -2;
+        return false;
+    }
+    data.fillFromStatxBuf(statxBuffer);
+    return true;
+}
+
 #if defined(_DEXTRA_FIRST)
 static void fillStat64fromStat32(struct stat64 *statBuf64, const struct stat &statBuf32)
 {
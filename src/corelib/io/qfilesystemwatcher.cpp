@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -71,6 +72,14 @@ void QFileSystemWatcherPrivate::init()
                          SIGNAL(directoryChanged(QString,bool)),
                          q,
                          SLOT(_q_directoryChanged(QString,bool)));
+        QObject::connect(native,
+                         SIGNAL(pathsChanged(QStringList)),
+                         q,
+                         SLOT(_q_pathsChanged(QStringList)));
+        QObject::connect(native,
+                         SIGNAL(recursiveDirectoryRemoved(QString)),
+                         q,
+                         SLOT(_q_recursiveDirectoryRemoved(QString)));
 #if defined(Q_OS_WIN)
         QObject::connect(static_cast<QWindowsFileSystemWatcherEngine *>(native),
                          &QWindowsFileSystemWatcherEngine::driveLockForRemoval,
@@ -112,6 +121,11 @@ void QFileSystemWatcherPrivate::_q_fileChanged(const QString &path, bool removed
     }
     if (removed)
         files.removeAll(path);
+    if (coalescingInterval > std::chrono::milliseconds::zero()) {
+        pendingFiles.add(path);
+        coalesce();
+        return;
+    }
     emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
@@ -125,9 +139,89 @@ void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool re
     }
     if (removed)
         directories.removeAll(path);
+    if (coalescingInterval > std::chrono::milliseconds::zero()) {
+        pendingDirectories.add(path);
+        coalesce();
+        return;
+    }
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
+void QFileSystemWatcherPrivate::_q_pathsChanged(const QStringList &paths)
+{
+    Q_Q(QFileSystemWatcher);
+    qCDebug(lcWatcher) << "paths changed" << paths;
+    if (coalescingInterval > std::chrono::milliseconds::zero()) {
+        for (const QString &path : paths)
+            pendingPaths.add(path);
+        coalesce();
+        return;
+    }
+    emit q->pathsChanged(paths, QFileSystemWatcher::QPrivateSignal());
+}
+
+void QFileSystemWatcherPrivate::_q_recursiveDirectoryRemoved(const QString &path)
+{
+    qCDebug(lcWatcher) << "recursively watched directory removed" << path;
+    recursiveDirectories.removeAll(path);
+}
+
+void QFileSystemWatcherPrivate::coalesce()
+{
+    Q_Q(QFileSystemWatcher);
+    if (!coalescingTimer) {
+        coalescingTimer = new QTimer(q);
+        coalescingTimer->setSingleShot(true);
+        QObject::connect(coalescingTimer, &QTimer::timeout, q, [this] { flushPendingChanges(); });
+    }
+    // the window starts with the first change of a burst; later changes
+    // don't push it out
+    if (!coalescingTimer->isActive())
+        coalescingTimer->start(coalescingInterval);
+}
+
+void QFileSystemWatcherPrivate::flushPendingChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    if (coalescingTimer)
+        coalescingTimer->stop();
+
+    // the slots may add or remove paths, or change the interval
+    const QStringList changedFiles = pendingFiles.take();
+    const QStringList changedDirectories = pendingDirectories.take();
+    const QStringList changedPaths = pendingPaths.take();
+
+    for (const QString &path : changedFiles)
+        emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
+    for (const QString &path : changedDirectories)
+        emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (!changedPaths.isEmpty())
+        emit q->pathsChanged(changedPaths, QFileSystemWatcher::QPrivateSignal());
+}
+
+// The user stopped watching \a paths; don't report changes they're
+// no longer interested in.
+void QFileSystemWatcherPrivate::dropPendingChanges(const QStringList &paths)
+{
+    if (pendingFiles.paths.isEmpty() && pendingDirectories.paths.isEmpty())
+        return;
+    const QSet<QString> dropped(paths.cbegin(), paths.cend());
+    const auto isDropped = [&dropped](const QString &path) { return dropped.contains(path); };
+    pendingFiles.removeIf(isDropped);
+    pendingDirectories.removeIf(isDropped);
+}
+
+void QFileSystemWatcherPrivate::dropPendingTreeChanges(const QString &directory)
+{
+    const auto isInTree = [&directory](const QString &path) {
+        if (!path.startsWith(directory))
+            return false;
+        return path.size() == directory.size() || directory.endsWith(u'/')
+                || path.at(directory.size()) == u'/';
+    };
+    pendingPaths.removeIf(isInTree);
+}
+
 #if defined(Q_OS_WIN)
 
 void QFileSystemWatcherPrivate::_q_winDriveLockForRemoval(const QString &path)
@@ -195,6 +289,12 @@ void  QFileSystemWatcherPrivate::_q_winDriveRemoved(const QString &path)
     they have been renamed or removed from disk, and directories once
     they have been removed from disk.
 
+    To watch a whole directory tree, such as a source checkout, call
+    addRecursivePath(). Subdirectories are then watched as they appear, and
+    changes anywhere in the tree are reported in batches by the
+    pathsChanged() signal. With setCoalescingInterval(), bursts of changes
+    to the same paths are reported once per interval.
+
     \list
     \li \b Notes:
     \list
@@ -407,10 +507,130 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
         p = d->native->removePaths(p, &d->files, &d->directories);
     if (d->poller)
         p = d->poller->removePaths(p, &d->files, &d->directories);
+    d->dropPendingChanges(paths);
 
     return p;
 }
 
+/*!
+    \since 6.7
+
+    Adds \a directory, all the directories below it, and the directories
+    that are later created or moved below it, to the file system watcher.
+    Symbolic links to directories are not followed.
+
+    Changes anywhere in the tree, including files being created, modified,
+    renamed or removed, are reported by the pathsChanged() signal. When the
+    directory itself is removed or renamed, its path is reported and it is
+    no longer watched.
+
+    Returns \c true if the watch was successful. Recursive watching is
+    currently only supported on Linux; on other platforms this function
+    returns \c false. It also returns \c false if \a directory is not a
+    directory, or is already part of a recursively watched tree.
+
+    \note The system limit on the number of watches applies to each
+    directory in the tree. If it is reached, the directories that could not
+    be watched are skipped with a warning.
+
+    \sa removeRecursivePath(), recursiveDirectories(), setCoalescingInterval()
+*/
+bool QFileSystemWatcher::addRecursivePath(const QString &directory)
+{
+    Q_D(QFileSystemWatcher);
+    if (directory.isEmpty()) {
+        qWarning("QFileSystemWatcher::addRecursivePath: path is empty");
+        return false;
+    }
+    if (!d->native)
+        return false;
+
+    qCDebug(lcWatcher) << "adding recursively" << directory;
+    return d->native->addRecursivePaths(QStringList(directory),
+                                        &d->recursiveDirectories).isEmpty();
+}
+
+/*!
+    \since 6.7
+
+    Stops watching the tree that was added with addRecursivePath() for
+    \a directory.
+
+    Returns \c true if the watch was successfully removed.
+
+    \sa addRecursivePath()
+*/
+bool QFileSystemWatcher::removeRecursivePath(const QString &directory)
+{
+    Q_D(QFileSystemWatcher);
+    if (directory.isEmpty()) {
+        qWarning("QFileSystemWatcher::removeRecursivePath: path is empty");
+        return false;
+    }
+    if (!d->native)
+        return false;
+
+    qCDebug(lcWatcher) << "removing recursively" << directory;
+    const bool removed = d->native->removeRecursivePaths(QStringList(directory),
+                                                         &d->recursiveDirectories).isEmpty();
+    if (removed)
+        d->dropPendingTreeChanges(directory);
+    return removed;
+}
+
+/*!
+    \since 6.7
+
+    Returns a list of the directories that are being watched recursively.
+
+    \sa addRecursivePath(), directories()
+*/
+QStringList QFileSystemWatcher::recursiveDirectories() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->recursiveDirectories;
+}
+
+/*!
+    \since 6.7
+
+    Sets the coalescing interval to \a interval.
+
+    With a positive interval, changes are not reported as they happen.
+    Instead, the first change starts a window of \a interval, and when it
+    has passed, fileChanged() and directoryChanged() are emitted once for
+    each path that changed during the window, and pathsChanged() once with
+    all the changed paths below the recursively watched directories. This
+    avoids flooding the event loop when many files change in a burst, for
+    example during a checkout.
+
+    The default interval is 0, which reports changes as soon as they are
+    read from the system. Setting it to 0 reports any pending changes
+    immediately.
+
+    \sa coalescingInterval()
+*/
+void QFileSystemWatcher::setCoalescingInterval(std::chrono::milliseconds interval)
+{
+    Q_D(QFileSystemWatcher);
+    d->coalescingInterval = qMax(interval, std::chrono::milliseconds::zero());
+    if (d->coalescingInterval == std::chrono::milliseconds::zero())
+        d->flushPendingChanges();
+}
+
+/*!
+    \since 6.7
+
+    Returns the coalescing interval.
+
+    \sa setCoalescingInterval()
+*/
+std::chrono::milliseconds QFileSystemWatcher::coalescingInterval() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->coalescingInterval;
+}
+
 /*!
     \fn void QFileSystemWatcher::fileChanged(const QString &path)
 
@@ -439,6 +659,22 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     \sa fileChanged()
 */
 
+/*!
+    \fn void QFileSystemWatcher::pathsChanged(const QStringList &paths)
+    \since 6.7
+
+    This signal is emitted when entries below a directory that is watched
+    with addRecursivePath() are created, modified, renamed or removed.
+    \a paths contains each changed path once; a path can be reported after
+    the entry was removed, or was created and removed again.
+
+    If the system dropped events because too many happened at once, the
+    paths of the recursively watched directories are reported instead, and
+    the receiver should rescan them.
+
+    \sa addRecursivePath(), setCoalescingInterval()
+*/
+
 /*!
     \fn QStringList QFileSystemWatcher::directories() const
 
@@ -6,6 +6,8 @@
 
 #include <QtCore/qobject.h>
 
+#include <chrono>
+
 QT_REQUIRE_CONFIG(filesystemwatcher);
 
 QT_BEGIN_NAMESPACE
@@ -31,13 +33,23 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    bool addRecursivePath(const QString &directory);
+    bool removeRecursivePath(const QString &directory);
+    QStringList recursiveDirectories() const;
+
+    void setCoalescingInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds coalescingInterval() const;
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void pathsChanged(const QStringList &paths, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
     Q_PRIVATE_SLOT(d_func(), void _q_directoryChanged(const QString &path, bool removed))
+    Q_PRIVATE_SLOT(d_func(), void _q_pathsChanged(const QStringList &paths))
+    Q_PRIVATE_SLOT(d_func(), void _q_recursiveDirectoryRemoved(const QString &path))
 };
 
 QT_END_NAMESPACE
@@ -8,6 +8,7 @@
 #include "private/qsystemerror_p.h"
 
 #include <qdebug.h>
+#include <qdiriterator.h>
 #include <qfile.h>
 #include <qfileinfo.h>
 #include <qscopeguard.h>
@@ -173,6 +174,10 @@ struct inotify_event {
 #define IN_Q_OVERFLOW           0x00004000
 #define IN_IGNORED              0x00008000
 
+#define IN_ONLYDIR              0x01000000
+#define IN_DONT_FOLLOW          0x02000000
+#define IN_ISDIR                0x40000000
+
 #define IN_CLOSE                (IN_CLOSE_WRITE | IN_CLOSE_NOWRITE)
 #define IN_MOVE                 (IN_MOVED_FROM | IN_MOVED_TO)
 }
@@ -197,17 +202,22 @@ static inline int inotify_init1(int flags)
 
 QT_BEGIN_NAMESPACE
 
-QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+static int createInotifyFd()
 {
     int fd = -1;
 #if defined(IN_CLOEXEC)
     fd = inotify_init1(IN_CLOEXEC);
 #endif
-    if (fd == -1) {
+    if (fd == -1)
         fd = inotify_init();
-        if (fd == -1)
-            return nullptr;
-    }
+    return fd;
+}
+
+QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+{
+    int fd = createInotifyFd();
+    if (fd == -1)
+        return nullptr;
     return new QInotifyFileSystemWatcherEngine(fd, parent);
 }
 
@@ -227,6 +237,11 @@ QInotifyFileSystemWatcherEngine::~QInotifyFileSystemWatcherEngine()
         inotify_rm_watch(inotifyFd, id < 0 ? -id : id);
 
     ::close(inotifyFd);
+
+    if (treeNotifier) {
+        treeNotifier->setEnabled(false);
+        ::close(treeFd); // removes all of its watches
+    }
 }
 
 QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
@@ -388,6 +403,269 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
     }
 }
 
+static constexpr quint32 TreeWatchMask = 0
+        | IN_ATTRIB
+        | IN_CLOSE_WRITE
+        | IN_MODIFY
+        | IN_MOVE
+        | IN_CREATE
+        | IN_DELETE
+        | IN_DELETE_SELF
+        | IN_MOVE_SELF
+        | IN_ONLYDIR
+        ;
+
+static QString treeChildPath(const QString &directory, const QString &name)
+{
+    if (directory.endsWith(u'/'))
+        return directory + name;
+    return directory + u'/' + name;
+}
+
+bool QInotifyFileSystemWatcherEngine::ensureTreeInotify()
+{
+    if (treeNotifier)
+        return true;
+    treeFd = createInotifyFd();
+    if (treeFd == -1)
+        return false;
+    fcntl(treeFd, F_SETFD, FD_CLOEXEC);
+    treeNotifier = new QSocketNotifier(treeFd, QSocketNotifier::Read, this);
+    connect(treeNotifier, SIGNAL(activated(QSocketDescriptor)), SLOT(readFromTreeInotify()));
+    return true;
+}
+
+// Watches the directory \a name at \a path below the directory watched as
+// \a parent, and the directories below it. If \a changes is set, the
+// entries found are reported, as they may have been created before the
+// watch was in place. Returns the new watch descriptor, or -1 if there was
+// an error or the directory was already watched.
+int QInotifyFileSystemWatcherEngine::addTreeDirectory(int parent, const QString &name,
+                                                      const QString &path,
+                                                      QFileSystemWatcherPathList *changes)
+{
+    // only the roots may be symlinks
+    const quint32 mask = parent < 0 ? TreeWatchMask : TreeWatchMask | IN_DONT_FOLLOW;
+    const int wd = inotify_add_watch(treeFd, QFile::encodeName(path), mask);
+    if (wd < 0) {
+        if (errno != ENOENT && errno != ENOTDIR)
+            qErrnoWarning("inotify_add_watch(%ls) failed:", path.constData());
+        return -1;
+    }
+    if (treeDirectories.contains(wd))
+        return -1;
+    attachTreeDirectory(wd, parent, name);
+
+    const QDir::Filters filters = changes
+            ? QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot
+            : QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot | QDir::NoSymLinks;
+    QDirIterator it(path, filters);
+    while (it.hasNext()) {
+        const QFileInfo fi = it.nextFileInfo();
+        if (changes)
+            changes->add(fi.filePath());
+        if (fi.isDir() && !fi.isSymLink())
+            addTreeDirectory(wd, fi.fileName(), fi.filePath(), changes);
+    }
+    return wd;
+}
+
+// Makes the directory \a wd the child \a name of \a parent, which is -1
+// for a root.
+void QInotifyFileSystemWatcherEngine::attachTreeDirectory(int wd, int parent, const QString &name)
+{
+    TreeDirectory &dir = treeDirectories[wd];
+    dir.parent = parent;
+    dir.name = name;
+    if (parent > 0)
+        treeChildren[parent].insert(name, wd);
+}
+
+// Takes the directory \a wd out of its parent, as when it's being moved.
+void QInotifyFileSystemWatcherEngine::detachTreeDirectory(int wd)
+{
+    const auto dir = treeDirectories.find(wd);
+    if (dir == treeDirectories.end())
+        return;
+    if (dir->parent > 0) {
+        const auto siblings = treeChildren.find(dir->parent);
+        if (siblings != treeChildren.end() && siblings->value(dir->name) == wd) {
+            siblings->remove(dir->name);
+            if (siblings->isEmpty())
+                treeChildren.erase(siblings);
+        }
+    }
+    dir->parent = 0;
+}
+
+// Stops watching the directory \a wd and all the directories below it.
+void QInotifyFileSystemWatcherEngine::removeTree(int wd)
+{
+    detachTreeDirectory(wd);
+    QVarLengthArray<int, 64> toRemove = { wd };
+    for (qsizetype i = 0; i < toRemove.size(); ++i) {
+        const int dir = toRemove.at(i);
+        for (int child : treeChildren.take(dir))
+            toRemove.append(child);
+        inotify_rm_watch(treeFd, dir);
+        treeDirectories.remove(dir);
+    }
+}
+
+int QInotifyFileSystemWatcherEngine::findTreeChild(int parent, const QString &name) const
+{
+    const auto children = treeChildren.constFind(parent);
+    return children == treeChildren.cend() ? -1 : children->value(name, -1);
+}
+
+QString QInotifyFileSystemWatcherEngine::treePath(int wd) const
+{
+    QVarLengthArray<const TreeDirectory *, 16> chain;
+    for (auto it = treeDirectories.constFind(wd); it != treeDirectories.cend();
+         it = treeDirectories.constFind(it->parent)) {
+        chain.append(&*it);
+        if (it->parent < 0)
+            break;
+    }
+    // the directory, or one of its ancestors, is no longer watched
+    if (chain.isEmpty() || chain.last()->parent >= 0)
+        return QString();
+
+    QString path = chain.last()->name;
+    for (qsizetype i = chain.size() - 2; i >= 0; --i)
+        path = treeChildPath(path, chain.at(i)->name);
+    return path;
+}
+
+QStringList QInotifyFileSystemWatcherEngine::addRecursivePaths(const QStringList &paths,
+                                                               QStringList *directories)
+{
+    QStringList unhandled;
+    for (const QString &path : paths) {
+        auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
+        if (treeRoots.contains(path) || !QFileInfo(path).isDir() || !ensureTreeInotify())
+            continue;
+
+        const int wd = addTreeDirectory(-1, path, path, nullptr);
+        if (wd < 0)
+            continue;
+
+        sg.dismiss();
+        treeRoots.insert(path, wd);
+        directories->append(path);
+    }
+    return unhandled;
+}
+
+QStringList QInotifyFileSystemWatcherEngine::removeRecursivePaths(const QStringList &paths,
+                                                                  QStringList *directories)
+{
+    QStringList unhandled;
+    for (const QString &path : paths) {
+        const auto it = treeRoots.constFind(path);
+        if (it == treeRoots.cend()) {
+            unhandled.push_back(path);
+            continue;
+        }
+        removeTree(*it);
+        treeRoots.erase(it);
+        directories->removeAll(path);
+    }
+    return unhandled;
+}
+
+void QInotifyFileSystemWatcherEngine::readFromTreeInotify()
+{
+    int buffSize = 0;
+    if (ioctl(treeFd, FIONREAD, (char *) &buffSize) == -1 || buffSize == 0)
+        return;
+
+    QVarLengthArray<char, 4096> buffer(buffSize);
+    buffSize = int(read(treeFd, buffer.data(), buffSize));
+    const char *at = buffer.data();
+    const char * const end = at + qMax(buffSize, 0);
+
+    // the paths changed in this batch of events
+    QFileSystemWatcherPathList changes;
+    QStringList removedRoots;
+    QHash<quint32, int> movedFrom; // cookie -> directory that was moved
+    while (at < end) {
+        const inotify_event *event = reinterpret_cast<const inotify_event *>(at);
+        at += sizeof(inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW) {
+            // events were lost; the receivers need to rescan everything
+            for (auto it = treeRoots.cbegin(); it != treeRoots.cend(); ++it)
+                changes.add(it.key());
+            continue;
+        }
+
+        // an event queued before we stopped watching is ignored
+        const auto dir = treeDirectories.constFind(event->wd);
+        if (dir == treeDirectories.cend())
+            continue;
+
+        if (event->len == 0 || event->name[0] == '\0' || (event->mask & IN_IGNORED)) {
+            // Changes of the directory itself are reported through its
+            // parent, unless it is a root
+            if (dir->parent >= 0) {
+                if (event->mask & IN_IGNORED) {
+                    detachTreeDirectory(event->wd);
+                    treeChildren.remove(event->wd);
+                    treeDirectories.remove(event->wd);
+                }
+                continue;
+            }
+            const QString root = dir->name;
+            changes.add(root);
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT | IN_IGNORED)) {
+                removeTree(event->wd);
+                treeRoots.remove(root);
+                removedRoots.append(root);
+            }
+            continue;
+        }
+
+        const QString dirPath = treePath(event->wd);
+        if (dirPath.isEmpty())
+            continue;
+        const QString name = QFile::decodeName(event->name);
+        const QString path = treeChildPath(dirPath, name);
+        changes.add(path);
+        if (!(event->mask & IN_ISDIR))
+            continue;
+
+        if (event->mask & IN_CREATE) {
+            addTreeDirectory(event->wd, name, path, &changes);
+        } else if (event->mask & IN_MOVED_FROM) {
+            // until its IN_MOVED_TO, the events below it aren't reported
+            const int child = findTreeChild(event->wd, name);
+            if (child >= 0) {
+                detachTreeDirectory(child);
+                movedFrom.insert(event->cookie, child);
+            }
+        } else if (event->mask & IN_MOVED_TO) {
+            // moved within the tree: the watches stay valid
+            const auto from = movedFrom.constFind(event->cookie);
+            if (from != movedFrom.cend() && treeDirectories.contains(*from)) {
+                attachTreeDirectory(*from, event->wd, name);
+                movedFrom.erase(from);
+            } else {
+                addTreeDirectory(event->wd, name, path, &changes);
+            }
+        }
+    }
+
+    // directories moved out of the trees
+    for (int wd : std::as_const(movedFrom))
+        removeTree(wd);
+
+    for (const QString &root : std::as_const(removedRoots))
+        emit recursiveDirectoryRemoved(root);
+    if (!changes.paths.isEmpty())
+        emit pathsChanged(changes.paths);
+}
+
 template <typename Hash, typename Key>
 typename Hash::const_iterator
 find_last_in_equal_range(const Hash &c, const Key &key)
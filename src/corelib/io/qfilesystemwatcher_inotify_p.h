@@ -36,19 +36,50 @@ public:
 
     QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
     QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
+    QStringList addRecursivePaths(const QStringList &paths, QStringList *directories) override;
+    QStringList removeRecursivePaths(const QStringList &paths, QStringList *directories) override;
 
 private Q_SLOTS:
     void readFromInotify();
+    void readFromTreeInotify();
 
 private:
     QString getPathFromID(int id) const;
 
+    // A directory of a recursively watched tree, keyed by its watch
+    // descriptor. Only the roots store their path; the other directories
+    // store their name, and their paths are built when they're reported.
+    struct TreeDirectory
+    {
+        int parent; // -1 for a root, 0 while it's being moved
+        QString name;
+    };
+
+    bool ensureTreeInotify();
+    int addTreeDirectory(int parent, const QString &name, const QString &path,
+                         QFileSystemWatcherPathList *changes);
+    void attachTreeDirectory(int wd, int parent, const QString &name);
+    void detachTreeDirectory(int wd);
+    void removeTree(int wd);
+    int findTreeChild(int parent, const QString &name) const;
+    QString treePath(int wd) const;
+
 private:
     QInotifyFileSystemWatcherEngine(int fd, QObject *parent);
     int inotifyFd;
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
     QSocketNotifier notifier;
+
+    // Recursive watches use their own inotify instance, so that their watch
+    // descriptors don't collide with the ones of addPaths() when both watch
+    // the same directory.
+    int treeFd = -1;
+    QSocketNotifier *treeNotifier = nullptr;
+    QHash<int, TreeDirectory> treeDirectories;
+    // parent -> name -> child, for the directories that have a parent
+    QHash<int, QHash<QString, int>> treeChildren;
+    QHash<QString, int> treeRoots;
 };
 
 
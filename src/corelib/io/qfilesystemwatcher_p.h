@@ -23,9 +23,44 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
+class QTimer;
+
+// changed paths, each once, in the order of the first change
+struct QFileSystemWatcherPathList
+{
+    QStringList paths;
+    QSet<QString> seen;
+
+    void add(const QString &path)
+    {
+        if (!seen.contains(path)) {
+            seen.insert(path);
+            paths.append(path);
+        }
+    }
+    QStringList take()
+    {
+        seen.clear();
+        return std::exchange(paths, {});
+    }
+    template <typename Predicate>
+    void removeIf(Predicate pred)
+    {
+        paths.removeIf([&](const QString &path) {
+            if (!pred(path))
+                return false;
+            seen.remove(path);
+            return true;
+        });
+    }
+};
+
 class QFileSystemWatcherEngine : public QObject
 {
     Q_OBJECT
@@ -49,9 +84,28 @@ public:
                                     QStringList *files,
                                     QStringList *directories) = 0;
 
+    // watches each directory in \a paths and every directory below it,
+    // including ones created later, and appends them to \a directories;
+    // returns the paths this engine could not watch that way
+    virtual QStringList addRecursivePaths(const QStringList &paths,
+                                          QStringList *directories)
+    {
+        Q_UNUSED(directories);
+        return paths;
+    }
+    virtual QStringList removeRecursivePaths(const QStringList &paths,
+                                             QStringList *directories)
+    {
+        Q_UNUSED(directories);
+        return paths;
+    }
+
 Q_SIGNALS:
     void fileChanged(const QString &path, bool removed);
     void directoryChanged(const QString &path, bool removed);
+    // changes below the recursively watched directories
+    void pathsChanged(const QStringList &paths);
+    void recursiveDirectoryRemoved(const QString &path);
 };
 
 class QFileSystemWatcherPrivate : public QObjectPrivate
@@ -66,11 +120,23 @@ public:
     void initPollerEngine();
 
     QFileSystemWatcherEngine *native, *poller;
-    QStringList files, directories;
+    QStringList files, directories, recursiveDirectories;
+
+    // changes waiting for the coalescing interval to pass
+    void coalesce();
+    void flushPendingChanges();
+    void dropPendingChanges(const QStringList &paths);
+    void dropPendingTreeChanges(const QString &directory);
+    std::chrono::milliseconds coalescingInterval{0};
+    QTimer *coalescingTimer = nullptr;
+
+    QFileSystemWatcherPathList pendingFiles, pendingDirectories, pendingPaths;
 
     // private slots
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
+    void _q_pathsChanged(const QStringList &paths);
+    void _q_recursiveDirectoryRemoved(const QString &path);
 
 #if defined(Q_OS_WIN)
     void _q_winDriveLockForRemoval(const QString &);
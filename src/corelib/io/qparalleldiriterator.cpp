@@ -0,0 +1,615 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+/*!
+    \since 6.7
+    \class QParallelDirIterator
+    \inmodule QtCore
+    \brief The QParallelDirIterator class lists a directory tree using several threads.
+
+    QParallelDirIterator lists all entries below a directory, recursively,
+    like QDirIterator does when constructed with QDirIterator::Subdirectories.
+    The directories of the tree are read concurrently by the threads of a
+    private QThreadPool, and the entries they find are handed to the thread
+    that iterates, in batches, through a queue of limited size. Reading
+    stops when the queue is full, so that a slow consumer does not cause the
+    whole tree to be held in memory.
+
+    The entries are returned in no particular order: entries of different
+    directories interleave, and the order changes from one run to the next.
+    Sort the results if the order matters. The "." and ".." entries are never
+    returned.
+
+    \snippet code/src_corelib_io_qparalleldiriterator.cpp 0
+
+    On Unix systems, each subdirectory is opened relative to the already
+    opened parent directory, which spares the kernel from resolving the full
+    path of every directory again. If FetchMetaData is passed, the metadata
+    of every entry is also read by the worker threads, so that calling
+    QFileInfo functions such as QFileInfo::size() or
+    QFileInfo::lastModified() on the results does not touch the file system
+    again.
+
+    Paths that are handled by a file engine, such as resources, are listed
+    by a single thread.
+
+    \sa QDirIterator, QThreadPool
+*/
+
+/*! \enum QParallelDirIterator::IteratorFlag
+
+    This enum describes flags that you can combine to configure the behavior
+    of QParallelDirIterator.
+
+    \value NoIteratorFlags The default value, representing no flags.
+
+    \value FollowSymlinks Descend into symbolic links to directories as well.
+    Symbolic link loops are detected and not followed.
+
+    \value FetchMetaData Read all the metadata of each entry while listing,
+    in the worker threads. Without this flag, only what the directory
+    listing provides for free (typically, the type of the entry) is known in
+    advance, and QFileInfo fetches the rest on demand.
+*/
+
+#include "qparalleldiriterator.h"
+
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <QtCore/private/qabstractfileengine_p.h>
+#include <QtCore/private/qdirentryfilter_p.h>
+#include <QtCore/private/qfileinfo_p.h>
+#include <QtCore/private/qfilesystemengine_p.h>
+#include <QtCore/private/qfilesystementry_p.h>
+#include <QtCore/private/qfilesystemiterator_p.h>
+#include <QtCore/private/qfilesystemmetadata_p.h>
+#include <QtCore/private/qstringconverter_p.h>
+
+#ifdef Q_OS_UNIX
+#include <QtCore/private/qcore_unix_p.h>
+#include "qplatformdefs.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#endif
+
+#include <deque>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+class QParallelDirIteratorPrivate
+{
+public:
+    // Entries are handed to the consumer in batches of this size...
+    static constexpr qsizetype BatchSize = 256;
+    // ... and reading stops while this many batches are queued.
+    static constexpr qsizetype MaxQueuedBatches = 64;
+    // Subdirectories are opened relative to their parent while fewer than
+    // this many directory descriptors are open, and by path otherwise.
+    static constexpr int MaxOpenDirFds = 256;
+
+    struct Directory
+    {
+        QFileSystemEntry entry;
+        int fd = -1;        // already opened, or -1 to open by path
+    };
+
+    QParallelDirIteratorPrivate(const QString &path, const QStringList &nameFilters,
+                                QDir::Filters filters, QParallelDirIterator::IteratorFlags flags);
+    ~QParallelDirIteratorPrivate();
+
+    void start();
+    bool fetchBatch();
+
+    void schedule(Directory &&dir);
+    void scanDirectory(Directory dir);
+    void listWithDirIterator();
+    bool shouldDescend(const QFileInfo &fi) const;
+    bool pushBatch(QList<QFileInfo> &batch);
+    void finishDirectory(QList<QFileInfo> &batch);
+
+    bool isCancelled() const
+    {
+        QMutexLocker lock(&mutex);
+        return cancelled;
+    }
+
+    const QFileSystemEntry rootEntry;
+    const QDirEntryFilter entryFilter;
+    const QParallelDirIterator::IteratorFlags iteratorFlags;
+
+    QThreadPool pool;
+
+    // Shared between the workers and the consumer
+    mutable QMutex mutex;
+    QWaitCondition resultsAvailable;
+    QWaitCondition spaceAvailable;
+    std::deque<QList<QFileInfo>> batches;
+    int pendingDirectories = 0;
+    bool cancelled = false;
+#ifdef Q_OS_UNIX
+    QAtomicInt openDirFds;
+    QSet<std::pair<quint64, quint64>> visitedDirectories;
+#else
+    QSet<QString> visitedDirectories;
+#endif
+
+    // Consumer only
+    bool started = false;
+    QList<QFileInfo> currentBatch;
+    qsizetype currentIndex = 0;
+    QFileInfo currentFileInfo;
+};
+
+/*!
+    \internal
+*/
+QParallelDirIteratorPrivate::QParallelDirIteratorPrivate(const QString &path,
+                                                         const QStringList &nameFilters,
+                                                         QDir::Filters _filters,
+                                                         QParallelDirIterator::IteratorFlags flags)
+    : rootEntry(path)
+      , entryFilter(nameFilters, _filters)
+      , iteratorFlags(flags)
+{
+}
+
+/*!
+    \internal
+
+    Stops the workers: they notice the cancellation when they next queue a
+    batch, or start on a directory, and release their directories.
+*/
+QParallelDirIteratorPrivate::~QParallelDirIteratorPrivate()
+{
+    {
+        QMutexLocker lock(&mutex);
+        cancelled = true;
+        spaceAvailable.wakeAll();
+    }
+    pool.waitForDone();
+}
+
+/*!
+    \internal
+*/
+void QParallelDirIteratorPrivate::start()
+{
+    started = true;
+
+    QFileSystemEntry entry = rootEntry;
+    QFileSystemMetaData metaData;
+    std::unique_ptr<QAbstractFileEngine> engine(
+            QFileSystemEngine::resolveEntryAndCreateLegacyEngine(entry, metaData));
+    if (engine) {
+        // File engines only offer QAbstractFileEngineIterator, which can't
+        // be shared between threads; let one worker do it all.
+        {
+            QMutexLocker lock(&mutex);
+            ++pendingDirectories;
+        }
+        pool.start([this] { listWithDirIterator(); });
+        return;
+    }
+
+    schedule(Directory{ rootEntry });
+}
+
+/*!
+    \internal
+
+    Waits until the workers have queued a batch of entries, or have all
+    finished. Returns \c false if there is nothing left to iterate.
+*/
+bool QParallelDirIteratorPrivate::fetchBatch()
+{
+    if (!started)
+        start();
+
+    QMutexLocker lock(&mutex);
+    while (batches.empty() && pendingDirectories > 0)
+        resultsAvailable.wait(&mutex);
+    if (batches.empty())
+        return false;
+
+    currentBatch = std::move(batches.front());
+    batches.pop_front();
+    currentIndex = 0;
+    spaceAvailable.wakeOne();
+    return true;
+}
+
+/*!
+    \internal
+*/
+void QParallelDirIteratorPrivate::schedule(Directory &&dir)
+{
+    {
+        QMutexLocker lock(&mutex);
+        ++pendingDirectories;
+    }
+    pool.start([this, dir = std::move(dir)]() mutable { scanDirectory(std::move(dir)); });
+}
+
+/*!
+    \internal
+
+    Queues \a batch for the consumer, waiting for room in the queue if
+    necessary. Returns \c false if the iteration was cancelled meanwhile.
+*/
+bool QParallelDirIteratorPrivate::pushBatch(QList<QFileInfo> &batch)
+{
+    if (batch.isEmpty())
+        return true;
+
+    QMutexLocker lock(&mutex);
+    while (qsizetype(batches.size()) >= MaxQueuedBatches && !cancelled)
+        spaceAvailable.wait(&mutex);
+    if (cancelled)
+        return false;
+
+    batches.push_back(std::exchange(batch, {}));
+    resultsAvailable.wakeOne();
+    return true;
+}
+
+/*!
+    \internal
+*/
+void QParallelDirIteratorPrivate::finishDirectory(QList<QFileInfo> &batch)
+{
+    pushBatch(batch);
+
+    QMutexLocker lock(&mutex);
+    if (--pendingDirectories == 0)
+        resultsAvailable.wakeOne();
+}
+
+/*!
+    \internal
+
+    Runs in a worker thread. Lists \a dir, queues its entries and schedules
+    its subdirectories.
+*/
+void QParallelDirIteratorPrivate::scanDirectory(Directory dir)
+{
+    QList<QFileInfo> batch;
+
+#if defined(Q_OS_UNIX)
+    int fd = dir.fd;
+    if (isCancelled()) {
+        if (fd != -1) {
+            qt_safe_close(fd);
+            openDirFds.deref();
+        }
+        return finishDirectory(batch);
+    }
+
+    if (fd == -1) {
+        fd = qt_safe_open(dir.entry.nativeFilePath().constData(), O_RDONLY | O_DIRECTORY);
+        if (fd == -1)
+            return finishDirectory(batch);
+        openDirFds.ref();
+    }
+
+    if (iteratorFlags & QParallelDirIterator::FollowSymlinks) {
+        // Stop link loops
+        QT_STATBUF st;
+        if (QT_FSTAT(fd, &st) == 0) {
+            const std::pair<quint64, quint64> id(quint64(st.st_dev), quint64(st.st_ino));
+            QMutexLocker lock(&mutex);
+            if (visitedDirectories.contains(id)) {
+                lock.unlock();
+                qt_safe_close(fd);
+                openDirFds.deref();
+                return finishDirectory(batch);
+            }
+            visitedDirectories.insert(id);
+        }
+    }
+
+    DIR *d = ::fdopendir(fd);
+    if (!d) {
+        qt_safe_close(fd);
+        openDirFds.deref();
+        return finishDirectory(batch);
+    }
+
+    QByteArray nativePath = dir.entry.nativeFilePath();
+    if (!nativePath.endsWith('/'))
+        nativePath.append('/');
+
+    const bool fetchMetaData = iteratorFlags.testAnyFlag(QParallelDirIterator::FetchMetaData);
+    batch.reserve(BatchSize);
+    while (QT_DIRENT *dirEntry = QT_READDIR(d)) {
+        const char *name = dirEntry->d_name;
+        const qsizetype len = qstrlen(name);
+        if (name[0] == '.' && (len == 1 || (len == 2 && name[1] == '.')))
+            continue;
+        if (!QUtf8::isValidUtf8(QByteArrayView(name, len)).isValidUtf8)
+            continue;
+
+        const QFileSystemEntry entry(nativePath + QByteArrayView(name, len),
+                                     QFileSystemEntry::FromNativePath());
+        QFileSystemMetaData metaData;
+        metaData.fillFromDirEnt(*dirEntry);
+        // The listing doesn't tell what symlinks point to, and some file
+        // systems don't report the type at all: stat them here rather than
+        // in the consumer.
+        if (fetchMetaData || !metaData.hasFlags(QFileSystemMetaData::DirectoryType))
+            QFileSystemEngine::fillMetaData(fd, name, entry, metaData);
+
+        const QFileInfo fi(new QFileInfoPrivate(entry, metaData));
+        if (shouldDescend(fi)) {
+            Directory subdir{ entry };
+            if (openDirFds.loadRelaxed() < MaxOpenDirFds) {
+                int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+                if (!(iteratorFlags & QParallelDirIterator::FollowSymlinks))
+                    flags |= O_NOFOLLOW;
+                EINTR_LOOP(subdir.fd, ::openat(fd, name, flags));
+                if (subdir.fd != -1)
+                    openDirFds.ref();
+            }
+            schedule(std::move(subdir));
+        }
+
+        if (entryFilter.matches(entry.fileName(), fi)) {
+            batch.append(fi);
+            if (batch.size() == BatchSize) {
+                if (!pushBatch(batch))
+                    break;
+                batch.reserve(BatchSize);
+            }
+        }
+    }
+
+    ::closedir(d);
+    openDirFds.deref();
+#elif !defined(QT_NO_FILESYSTEMITERATOR)
+    if (isCancelled())
+        return finishDirectory(batch);
+
+    if (iteratorFlags & QParallelDirIterator::FollowSymlinks) {
+        // Stop link loops
+        const QString canonicalPath = QFileInfo(dir.entry.filePath()).canonicalFilePath();
+        QMutexLocker lock(&mutex);
+        if (visitedDirectories.contains(canonicalPath))
+            return finishDirectory(batch);
+        visitedDirectories.insert(canonicalPath);
+    }
+
+    QFileSystemIterator it(dir.entry, entryFilter.filters, entryFilter.nameFilters);
+    QFileSystemEntry entry;
+    QFileSystemMetaData metaData;
+    batch.reserve(BatchSize);
+    while (it.advance(entry, metaData)) {
+        const QString fileName = entry.fileName();
+        if (fileName == "."_L1 || fileName == ".."_L1)
+            continue;
+        if (iteratorFlags & QParallelDirIterator::FetchMetaData)
+            QFileSystemEngine::fillMetaData(entry, metaData, QFileSystemMetaData::AllMetaDataFlags);
+
+        const QFileInfo fi(new QFileInfoPrivate(entry, metaData));
+        if (shouldDescend(fi))
+            schedule(Directory{ entry });
+
+        if (entryFilter.matches(fileName, fi)) {
+            batch.append(fi);
+            if (batch.size() == BatchSize) {
+                if (!pushBatch(batch))
+                    break;
+                batch.reserve(BatchSize);
+            }
+        }
+        metaData = QFileSystemMetaData();
+    }
+#else
+    Q_UNUSED(dir);
+    qWarning("Qt was built with -no-feature-filesystemiterator: no files/plugins will be found!");
+#endif
+
+    finishDirectory(batch);
+}
+
+/*!
+    \internal
+
+    Runs in a worker thread, for paths handled by a file engine.
+*/
+void QParallelDirIteratorPrivate::listWithDirIterator()
+{
+    QDirIterator::IteratorFlags flags = QDirIterator::Subdirectories;
+    if (iteratorFlags & QParallelDirIterator::FollowSymlinks)
+        flags |= QDirIterator::FollowSymlinks;
+
+    QList<QFileInfo> batch;
+    batch.reserve(BatchSize);
+    QDirIterator it(rootEntry.filePath(), entryFilter.nameFilters,
+                    entryFilter.filters | QDir::NoDotAndDotDot, flags);
+    while (it.hasNext()) {
+        batch.append(it.nextFileInfo());
+        if (batch.size() == BatchSize) {
+            if (!pushBatch(batch))
+                break;
+            batch.reserve(BatchSize);
+        }
+    }
+    finishDirectory(batch);
+}
+
+/*!
+    \internal
+
+    Returns \c true if the directory \a fi should be listed, following the
+    same rules as QDirIterator.
+*/
+bool QParallelDirIteratorPrivate::shouldDescend(const QFileInfo &fi) const
+{
+    // Never follow non-directory entries
+    if (!fi.isDir())
+        return false;
+
+    // Follow symlinks only when asked
+    if (!(iteratorFlags & QParallelDirIterator::FollowSymlinks) && fi.isSymLink())
+        return false;
+
+    // No hidden directories unless requested
+    const QDir::Filters filters = entryFilter.filters;
+    if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fi.isHidden())
+        return false;
+
+    return true;
+}
+
+/*!
+    Constructs a QParallelDirIterator that lists \a path recursively, with no
+    name filtering. You can pass options via \a flags to decide how the
+    directory should be iterated.
+
+    \sa hasNext(), next(), IteratorFlags
+*/
+QParallelDirIterator::QParallelDirIterator(const QString &path, IteratorFlags flags)
+    : d(new QParallelDirIteratorPrivate(path, QStringList(), QDir::NoFilter, flags))
+{
+}
+
+/*!
+    Constructs a QParallelDirIterator that lists \a path recursively, with no
+    name filtering and \a filters for entry filtering. You can pass options
+    via \a flags to decide how the directory should be iterated.
+
+    As with QDirIterator, hidden directories are only descended into if
+    \a filters contains QDir::Hidden or QDir::AllDirs.
+
+    \note To list symlinks that point to non existing files, QDir::System must be
+     passed to the flags.
+
+    \sa hasNext(), next(), IteratorFlags
+*/
+QParallelDirIterator::QParallelDirIterator(const QString &path, QDir::Filters filters,
+                                           IteratorFlags flags)
+    : d(new QParallelDirIteratorPrivate(path, QStringList(), filters, flags))
+{
+}
+
+/*!
+    Constructs a QParallelDirIterator that lists \a path recursively, using
+    \a nameFilters and \a filters. You can pass options via \a flags to
+    decide how the directory should be iterated.
+
+    \note To list symlinks that point to non existing files, QDir::System must be
+     passed to the flags.
+
+    \sa hasNext(), next(), IteratorFlags
+*/
+QParallelDirIterator::QParallelDirIterator(const QString &path, const QStringList &nameFilters,
+                                           QDir::Filters filters, IteratorFlags flags)
+    : d(new QParallelDirIteratorPrivate(path, nameFilters, filters, flags))
+{
+}
+
+/*!
+    Destroys the QParallelDirIterator. Stops the worker threads, waiting for
+    them to release the directories they are reading.
+*/
+QParallelDirIterator::~QParallelDirIterator()
+{
+}
+
+/*!
+    Sets the maximum number of threads used to read directories to \a count.
+    The default is QThread::idealThreadCount().
+
+    \sa maxThreadCount()
+*/
+void QParallelDirIterator::setMaxThreadCount(int count)
+{
+    d->pool.setMaxThreadCount(count);
+}
+
+/*!
+    Returns the maximum number of threads used to read directories.
+
+    \sa setMaxThreadCount()
+*/
+int QParallelDirIterator::maxThreadCount() const
+{
+    return d->pool.maxThreadCount();
+}
+
+/*!
+    Advances the iterator to the next entry, and returns the file path of
+    this new entry. If hasNext() returns \c false, this function does nothing,
+    and returns an empty QString.
+
+    \sa hasNext(), nextFileInfo()
+*/
+QString QParallelDirIterator::next()
+{
+    return nextFileInfo().filePath();
+}
+
+/*!
+    Advances the iterator to the next entry, and returns the file info of
+    this new entry. If hasNext() returns \c false, this function does nothing,
+    and returns an empty QFileInfo.
+
+    \sa hasNext(), next()
+*/
+QFileInfo QParallelDirIterator::nextFileInfo()
+{
+    if (!hasNext())
+        return QFileInfo();
+    d->currentFileInfo = d->currentBatch.at(d->currentIndex++);
+    return d->currentFileInfo;
+}
+
+/*!
+    Returns \c true if there is at least one more entry in the directory
+    tree; otherwise, false is returned.
+
+    The first call starts the worker threads. This function blocks until
+    one of them has found an entry, or until they have all finished.
+
+    \sa next(), nextFileInfo()
+*/
+bool QParallelDirIterator::hasNext() const
+{
+    return d->currentIndex < d->currentBatch.size() || d->fetchBatch();
+}
+
+/*!
+    Returns the full file path for the current directory entry.
+
+    \sa fileInfo()
+*/
+QString QParallelDirIterator::filePath() const
+{
+    return d->currentFileInfo.filePath();
+}
+
+/*!
+    Returns a QFileInfo for the current directory entry.
+
+    \sa filePath()
+*/
+QFileInfo QParallelDirIterator::fileInfo() const
+{
+    return d->currentFileInfo;
+}
+
+/*!
+    Returns the root directory being iterated, as passed to the constructor.
+*/
+QString QParallelDirIterator::path() const
+{
+    return d->rootEntry.filePath();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,56 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPARALLELDIRITERATOR_H
+#define QPARALLELDIRITERATOR_H
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+
+#include <memory>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QParallelDirIteratorPrivate;
+class Q_CORE_EXPORT QParallelDirIterator
+{
+public:
+    enum IteratorFlag {
+        NoIteratorFlags = 0x0,
+        FollowSymlinks = 0x1,
+        FetchMetaData = 0x2
+    };
+    Q_DECLARE_FLAGS(IteratorFlags, IteratorFlag)
+
+    explicit QParallelDirIterator(const QString &path, IteratorFlags flags = NoIteratorFlags);
+    QParallelDirIterator(const QString &path, QDir::Filters filters,
+                         IteratorFlags flags = NoIteratorFlags);
+    QParallelDirIterator(const QString &path, const QStringList &nameFilters,
+                         QDir::Filters filters = QDir::NoFilter,
+                         IteratorFlags flags = NoIteratorFlags);
+    ~QParallelDirIterator();
+
+    void setMaxThreadCount(int count);
+    int maxThreadCount() const;
+
+    QString next();
+    QFileInfo nextFileInfo();
+    bool hasNext() const;
+
+    QString filePath() const;
+    QFileInfo fileInfo() const;
+    QString path() const;
+
+private:
+    Q_DISABLE_COPY(QParallelDirIterator)
+
+    std::unique_ptr<QParallelDirIteratorPrivate> d;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(QParallelDirIterator::IteratorFlags)
+
+QT_END_NAMESPACE
+
+#endif // QPARALLELDIRITERATOR_H
@@ -17,6 +17,10 @@
 #include "qendian.h"
 #include <qshareddata.h>
 #include <qplatformdefs.h>
+#ifndef QT_BOOTSTRAPPED
+#  include <qcache.h>
+#  include <qmutex.h>
+#endif
 #include <qendian.h>
 #include "private/qabstractfileengine_p.h"
 #include "private/qduplicatetracker_p.h"
@@ -170,6 +174,37 @@ struct QResourceGlobalData
 };
 Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
 
+#ifndef QT_BOOTSTRAPPED
+// Decompressed contents of the compressed resources, so that opening one
+// repeatedly decompresses it once. They're keyed by the address of the
+// compressed data, which is valid until the resource is unregistered; the
+// cost is the size in bytes. Clearing the cache bumps the generation, so that
+// data decompressed meanwhile from a now unregistered address isn't added.
+struct QResourceDecompressionCache
+{
+    QResourceDecompressionCache()
+    {
+        bool ok;
+        const int kilobytes = qEnvironmentVariableIntValue("QT_RESOURCE_CACHE_SIZE", &ok);
+        cache.setMaxCost(ok ? qMax(kilobytes, 0) * qsizetype(1024) : 8 * 1024 * 1024);
+    }
+
+    QMutex mutex;
+    QCache<const uchar *, QByteArray> cache;
+    quint64 generation = 0;
+};
+Q_GLOBAL_STATIC(QResourceDecompressionCache, decompressionCache)
+
+static void clearDecompressionCache()
+{
+    if (!decompressionCache.exists())
+        return;
+    QMutexLocker locker(&decompressionCache->mutex);
+    decompressionCache->cache.clear();
+    ++decompressionCache->generation;
+}
+#endif // QT_BOOTSTRAPPED
+
 static inline QRecursiveMutex &resourceMutex()
 { return resourceGlobalData->resourceMutex; }
 
@@ -660,8 +695,11 @@ const uchar *QResource::data() const
     compressed. If the resource is a directory or an error occurs while
     decompressing, a null QByteArray is returned.
 
-    \note If the data was compressed, this function will decompress every time
-    it is called. The result is not cached between calls.
+    \note Decompressed data is kept in a process-wide cache of limited size,
+    so calling this function again for the same resource usually returns a
+    shallow copy of the same data. The size of the cache, in kilobytes, can be
+    set with the \c QT_RESOURCE_CACHE_SIZE environment variable; the default
+    is 8 MB.
 
     \sa uncompressedSize(), size(), compressionAlgorithm(), isFile()
 */
@@ -679,13 +717,34 @@ QByteArray QResource::uncompressedData() const
     if (d->compressionAlgo == NoCompression)
         return QByteArray::fromRawData(reinterpret_cast<const char *>(d->data), n);
 
+#ifndef QT_BOOTSTRAPPED
+    QResourceDecompressionCache *cache = decompressionCache();
+    quint64 generation = 0;
+    if (cache) {
+        QMutexLocker locker(&cache->mutex);
+        if (cache->cache.maxCost() == 0)
+            cache = nullptr;
+        else if (const QByteArray *cached = cache->cache.object(d->data))
+            return *cached;
+        else
+            generation = cache->generation;
+    }
+#endif
+
     // decompress
     QByteArray result(n, Qt::Uninitialized);
     n = d->decompress(result.data(), n);
     if (n < 0)
-        result.clear();
-    else
-        result.truncate(n);
+        return QByteArray();
+    result.truncate(n);
+
+#ifndef QT_BOOTSTRAPPED
+    if (cache && n <= cache->cache.maxCost()) {
+        QMutexLocker locker(&cache->mutex);
+        if (cache->generation == generation)
+            cache->cache.insert(d->data, new QByteArray(result), n);
+    }
+#endif
     return result;
 }
 
@@ -1013,6 +1072,10 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
                 ++i;
             }
         }
+#ifndef QT_BOOTSTRAPPED
+        // the data goes away with the library that contains it
+        clearDecompressionCache();
+#endif
         return true;
     }
     return false;
@@ -1027,7 +1090,11 @@ class QDynamicBufferResourceRoot : public QResourceRoot
 
 public:
     inline QDynamicBufferResourceRoot(const QString &_root) : root(_root), buffer(nullptr) { }
+#ifndef QT_BOOTSTRAPPED
+    inline ~QDynamicBufferResourceRoot() { clearDecompressionCache(); }
+#else
     inline ~QDynamicBufferResourceRoot() { }
+#endif
     inline const uchar *mappingBuffer() const { return buffer; }
     QString mappingRoot() const override { return root; }
     ResourceRootType type() const override { return Resource_Buffer; }
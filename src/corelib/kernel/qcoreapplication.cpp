@@ -124,6 +124,8 @@ Q_TRACE_POINT(qtcore, QCoreApplication_sendEvent, QObject *receiver, QEvent *eve
 Q_TRACE_POINT(qtcore, QCoreApplication_sendSpontaneousEvent, QObject *receiver, QEvent *event, QEvent::Type type);
 Q_TRACE_POINT(qtcore, QCoreApplication_notify_entry, QObject *receiver, QEvent *event, QEvent::Type type);
 Q_TRACE_POINT(qtcore, QCoreApplication_notify_exit, bool consumed, bool filtered);
+Q_TRACE_POINT(qtcore, QCoreApplication_sendPostedEvents_entry, QObject *receiver, int eventType);
+Q_TRACE_POINT(qtcore, QCoreApplication_sendPostedEvents_exit);
 
 #if defined(Q_OS_WIN) || defined(Q_OS_DARWIN)
 extern QString qAppFileName();
@@ -339,7 +341,7 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 qsizetype qGlobalPostedEventsCount()
 {
     const QPostEventList &l = QThreadData::current()->postEventList;
-    return l.size() - l.startOffset;
+    return l.size() - l.startOffset + l.inbox.size();
 }
 
 Q_CONSTINIT QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = nullptr;
@@ -488,6 +490,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->flushPostEventInbox();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -1595,6 +1598,7 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     if (!object) {
         locker.threadData = QThreadData::current();
         locker.locker = qt_unique_lock(locker.threadData->postEventList.mutex);
+        locker.threadData->flushPostEventInbox();
         return locker;
     }
 
@@ -1617,9 +1621,56 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     }
 
     Q_ASSERT(locker.threadData);
+    // keep events posted through the lock-free path ahead of the caller's
+    locker.threadData->flushPostEventInbox();
     return locker;
 }
 
+/*!
+    \internal
+
+    Pushes \a event into the inbox of \a receiver's thread. Returns \c false
+    if the caller has to fall back to the locked path, i.e. if \a receiver is
+    being destroyed or moved to another thread, or if the inbox is full.
+*/
+bool QCoreApplicationPrivate::postEventLockFree(QObject *receiver, QEvent *event)
+{
+    QObjectPrivate *d = QObjectPrivate::get(receiver);
+    QThreadData *data = d->threadData.loadAcquire();
+    if (!data)
+        return false;
+
+    QPostEventInbox &inbox = data->postEventList.inbox;
+    if (!inbox.enter())
+        return false;
+
+    // QObject::moveToThread() blocks the inbox before changing the thread
+    // data, so once we're in the receiver cannot move until we leave; but it
+    // may already have moved since we loaded the thread data above.
+    if (d->threadData.loadAcquire() != data) {
+        inbox.leave();
+        return false;
+    }
+
+    const QEvent::Type type = event->type();
+    event->m_posted = true;
+    ++d->postedEvents;
+    if (!inbox.push(receiver, event)) {
+        --d->postedEvents;
+        event->m_posted = false;
+        inbox.leave();
+        return false;
+    }
+    inbox.leave();
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, type);
+    Q_UNUSED(type);
+
+    QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+    return true;
+}
+
 /*!
     \since 4.3
 
@@ -1658,6 +1709,14 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // Queued slot invocations at the default priority are never compressed
+    // and need none of the DeferredDelete bookkeeping below, so they can be
+    // handed over without taking the receiving thread's post event list lock.
+    if (priority == Qt::NormalEventPriority && event->type() == QEvent::MetaCall
+        && QCoreApplicationPrivate::postEventLockFree(receiver, event)) {
+        return;
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1808,9 +1867,14 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         return;
     }
 
+    // start a new iteration for the calls this thread queues through
+    // batched connections
+    QObjectPrivate::closeMetaCallBatches();
+
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->flushPostEventInbox();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1824,6 +1888,8 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
     data->canWait = true;
 
+    Q_TRACE_SCOPE(QCoreApplication_sendPostedEvents, receiver, event_type);
+
     // okay. here is the tricky loop. be careful about optimizing
     // this, it looks the way it does for good reasons.
     qsizetype startOffset = data->postEventList.startOffset;
@@ -2030,6 +2096,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->flushPostEventInbox();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -16,6 +16,7 @@
 //
 
 #include "QtCore/qcoreevent.h"
+#include "private/qeventmemorypool_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -24,6 +25,7 @@ class QCoreApplication;
 class Q_AUTOTEST_EXPORT QDeferredDeleteEvent : public QEvent
 {
     Q_DECL_EVENT_COMMON(QDeferredDeleteEvent)
+    Q_EVENT_MEMORY_POOL_ALLOCATED
 public:
     explicit QDeferredDeleteEvent();
     int loopLevel() const { return m_loopLevel; }
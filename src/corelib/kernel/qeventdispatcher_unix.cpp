@@ -13,6 +13,7 @@
 #include <private/qthread_p.h>
 #include <private/qcoreapplication_p.h>
 #include <private/qcore_unix_p.h>
+#include <qtcore_tracepoints_p.h>
 
 #include <errno.h>
 #include <stdio.h>
@@ -29,10 +30,20 @@ static constexpr bool UsingEventfd = false;
 #  include <pipeDrv.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <qdeadlinetimer.h>
+#  include <sys/epoll.h>
+#endif
+
 using namespace std::chrono_literals;
 
 QT_BEGIN_NAMESPACE
 
+Q_TRACE_POINT(qtcore, QEventDispatcherUNIX_processEvents_entry, int flags);
+Q_TRACE_POINT(qtcore, QEventDispatcherUNIX_processEvents_exit, int events);
+Q_TRACE_POINT(qtcore, QEventDispatcherUNIX_wait_entry, int timeoutMsecs);
+Q_TRACE_POINT(qtcore, QEventDispatcherUNIX_wait_exit);
+
 static const char *socketType(QSocketNotifier::Type type)
 {
     switch (type) {
@@ -169,18 +180,185 @@ int QThreadPipe::check(const pollfd &pfd)
     return readyread;
 }
 
+#if QT_CONFIG(epoll)
+static uint32_t epollEventsFromPoll(short events)
+{
+    uint32_t result = 0;
+    if (events & POLLIN)
+        result |= EPOLLIN;
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+    if (events & POLLPRI)
+        result |= EPOLLPRI;
+    return result;
+}
+
+static short pollEventsFromEpoll(uint32_t events)
+{
+    short result = 0;
+    if (events & EPOLLIN)
+        result |= POLLIN;
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+    if (events & EPOLLPRI)
+        result |= POLLPRI;
+    if (events & EPOLLERR)
+        result |= POLLERR;
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+    return result;
+}
+
+static int qt_safe_epoll_wait(int epfd, epoll_event *events, int maxevents,
+                              const timespec *timeout_ts)
+{
+    int ret;
+    if (!timeout_ts) {
+        // no timeout -> block forever
+        EINTR_LOOP(ret, epoll_wait(epfd, events, maxevents, -1));
+        return ret;
+    }
+
+    // the timeout always comes from QTimerInfoList::timerWait(), so it is
+    // already a whole number of milliseconds
+    const QDeadlineTimer deadline(timespecToChronoMs(*timeout_ts));
+    forever {
+        const qint64 msecs = deadline.remainingTime();
+        ret = epoll_wait(epfd, events, maxevents, int(qMin(msecs, qint64(INT_MAX))));
+        if (ret != -1 || errno != EINTR)
+            return ret;
+    }
+}
+#endif
+
 QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    bool ok = false;
+    const int value = qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL", &ok);
+    if (ok && value > 0 && !initEpoll())
+        qErrnoWarning("QEventDispatcherUNIXPrivate(): Unable to use epoll, falling back to poll");
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     timerList.clearTimers();
 }
 
+#if QT_CONFIG(epoll)
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+        return false;
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+    return true;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpollInterest(int fd, short events, bool added)
+{
+    epoll_event ev = {};
+    ev.events = epollEventsFromPoll(events);
+    ev.data.fd = fd;
+
+    int ret = epoll_ctl(epollFd, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev);
+    if (ret == -1 && added && errno == EEXIST) {
+        // the descriptor was closed and its number reused while a duplicate
+        // kept the old open file description in the interest set
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    }
+    if (ret == -1)
+        qErrnoWarning("QSocketNotifier: Unable to watch socket %d with epoll", fd);
+}
+
+void QEventDispatcherUNIXPrivate::removeEpollInterest(int fd)
+{
+    // closing a descriptor removes it from the interest set automatically, so
+    // a socket that is already gone is not an error
+    if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr) == -1 && errno != EBADF && errno != ENOENT)
+        qErrnoWarning("QSocketNotifier: Unable to stop watching socket %d with epoll", fd);
+}
+
+int QEventDispatcherUNIXPrivate::waitForEpollEvents(const timespec *timeout)
+{
+    // level-triggered, so anything that does not fit here is simply reported
+    // again by the next call
+    constexpr int MaxEvents = 256;
+    epoll_event events[MaxEvents];
+
+    const int count = qt_safe_epoll_wait(epollFd, events, MaxEvents, timeout);
+    if (count == -1) {
+        qErrnoWarning("qt_safe_epoll_wait");
+        if (QT_CONFIG(poll_exit_on_error))
+            abort();
+        return 0;
+    }
+
+    int nevents = 0;
+    bool staleRegistration = false;
+    for (int i = 0; i < count; ++i) {
+        const int fd = events[i].data.fd;
+        short revents = pollEventsFromEpoll(events[i].events);
+        if (fd == threadPipe.fds[0]) {
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = revents;
+            nevents += threadPipe.check(pfd);
+            continue;
+        }
+
+        if (!socketNotifiers.contains(fd)) {
+            // the descriptor was closed, but a duplicate keeps the open file
+            // description, and with it the registration, alive. Unless the
+            // number has been reused, only a new epoll instance gets rid of it.
+            if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr) == -1)
+                staleRegistration = true;
+            continue;
+        }
+
+        // poll() reports a closed descriptor as POLLNVAL alone; epoll only
+        // knows about the file description, so find out for ourselves
+        if ((revents & (POLLERR | POLLHUP)) && fcntl(fd, F_GETFD) == -1 && errno == EBADF)
+            revents = POLLNVAL;
+        markPendingSocketNotifiers(fd, revents);
+    }
+
+    if (staleRegistration)
+        rebuildEpoll();
+    return nevents;
+}
+
+void QEventDispatcherUNIXPrivate::rebuildEpoll()
+{
+    qt_safe_close(epollFd);
+    if (!initEpoll()) {
+        qErrnoWarning("QEventDispatcherUNIXPrivate: Unable to recreate epoll instance, falling back to poll");
+        return;
+    }
+    for (auto it = socketNotifiers.cbegin(); it != socketNotifiers.cend(); ++it) {
+        if (!it.value().isEmpty())
+            updateEpollInterest(it.key(), it.value().events(), true);
+    }
+}
+#endif
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -202,38 +380,43 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
         if (pfd.fd < 0 || pfd.revents == 0)
             continue;
 
-        auto it = socketNotifiers.find(pfd.fd);
-        Q_ASSERT(it != socketNotifiers.end());
+        markPendingSocketNotifiers(pfd.fd, pfd.revents);
+    }
 
-        const QSocketNotifierSetUNIX &sn_set = it.value();
+    pollfds.clear();
+}
 
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers(int fd, short revents)
+{
+    auto it = socketNotifiers.constFind(fd);
+    Q_ASSERT(it != socketNotifiers.cend());
 
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+    const QSocketNotifierSetUNIX &sn_set = it.value();
 
-            if (!notifier)
-                continue;
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+        if (!notifier)
+            continue;
+
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     it.key(), socketType(n.type));
+            notifier->setEnabled(false);
         }
-    }
 
-    pollfds.clear();
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
 }
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
@@ -358,7 +541,16 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && sn_set.events() != oldEvents)
+        d->updateEpollInterest(sockfd, sn_set.events(), oldEvents == 0);
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -399,6 +591,15 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
 
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0) {
+        if (sn_set.isEmpty())
+            d->removeEpollInterest(sockfd);
+        else
+            d->updateEpollInterest(sockfd, sn_set.events(), false);
+    }
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -406,6 +607,9 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
 bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
 {
     Q_D(QEventDispatcherUNIX);
+    int nevents = 0;
+    Q_TRACE(QEventDispatcherUNIX_processEvents_entry, flags.toInt());
+    Q_TRACE_EXIT(QEventDispatcherUNIX_processEvents_exit, nevents);
     d->interrupt.storeRelaxed(0);
 
     // we are awake, broadcast it
@@ -444,6 +648,23 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
         }
     }
 
+    Q_TRACE(QEventDispatcherUNIX_wait_entry,
+            tm ? int(tm->tv_sec * 1000 + tm->tv_nsec / 1000000) : -1);
+
+#if QT_CONFIG(epoll)
+    // With epoll the kernel already knows the interest set; only the ready
+    // descriptors come back. Excluding socket notifiers falls back to polling
+    // the thread pipe alone, as the interest set cannot be masked cheaply.
+    if (d->epollFd >= 0 && include_notifiers) {
+        nevents += d->waitForEpollEvents(tm);
+        Q_TRACE(QEventDispatcherUNIX_wait_exit);
+        nevents += d->activateSocketNotifiers();
+        if (include_timers)
+            nevents += d->activateTimers();
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
     d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
@@ -454,9 +675,9 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
-    int nevents = 0;
-
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+    const int ready = qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm);
+    Q_TRACE(QEventDispatcherUNIX_wait_exit);
+    switch (ready) {
     case -1:
         qErrnoWarning("qt_safe_poll");
         if (QT_CONFIG(poll_exit_on_error))
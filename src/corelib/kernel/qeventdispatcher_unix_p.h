@@ -100,11 +100,25 @@ public:
     int activateTimers();
 
     void markPendingSocketNotifiers();
+    void markPendingSocketNotifiers(int fd, short revents);
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollInterest(int fd, short events, bool added);
+    void removeEpollInterest(int fd);
+    void rebuildEpoll();
+    int waitForEpollEvents(const timespec *timeout);
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
+#if QT_CONFIG(epoll)
+    // persistent interest set, kept in sync with socketNotifiers; -1 when
+    // the dispatcher uses poll()
+    int epollFd = -1;
+#endif
 
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
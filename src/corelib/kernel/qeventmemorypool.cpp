@@ -0,0 +1,233 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qeventmemorypool_p.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/private/qlocking_p.h>
+
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace QEventMemoryPool {
+
+namespace {
+
+constexpr std::size_t Granularity = 32;
+constexpr int ClassCount = int(MaxPooledSize / Granularity);
+// blocks a thread keeps per size class before giving memory back to the heap
+constexpr int MaxLocalBlocks = 256;
+
+struct Pool;
+
+// precedes every pooled block; its size keeps the payload aligned the way
+// operator new would
+struct alignas(16) Header
+{
+    Pool *owner;        // nullptr: give back to the heap
+    Header *next;
+};
+
+struct Pool
+{
+    // owning thread only
+    Header *local[ClassCount] = {};
+    int localCount[ClassCount] = {};
+
+    // pushed to by other threads, taken as a whole by the owning thread
+    std::atomic<Header *> returned[ClassCount] = {};
+
+    // written by the owning thread only
+    std::atomic<quint64> hits = 0;
+    std::atomic<quint64> misses = 0;
+    std::atomic<quint64> remoteFrees = 0;
+
+    Pool *nextOrphan = nullptr;
+};
+
+inline void bump(std::atomic<quint64> &counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Pools are never deleted: blocks may outlive the thread that allocated them.
+// The pool of a finished thread is handed over to the next new thread instead.
+struct Registry
+{
+    QBasicMutex mutex;
+    std::vector<Pool *> pools;
+    Pool *orphans = nullptr;
+};
+
+Registry &registry()
+{
+    // intentionally leaked, events may be freed during static destruction
+    static Registry *r = new Registry;
+    return *r;
+}
+
+thread_local Pool *currentPool = nullptr;
+thread_local bool currentPoolReleased = false;
+
+struct PoolReleaser
+{
+    ~PoolReleaser()
+    {
+        Pool *pool = std::exchange(currentPool, nullptr);
+        currentPoolReleased = true;
+        if (!pool)
+            return;
+        Registry &r = registry();
+        const auto locker = qt_scoped_lock(r.mutex);
+        pool->nextOrphan = r.orphans;
+        r.orphans = pool;
+    }
+};
+
+Q_NEVER_INLINE Pool *createThreadPool()
+{
+    if (currentPoolReleased) // thread is exiting
+        return nullptr;
+
+    static thread_local PoolReleaser releaser;
+    Q_UNUSED(releaser);
+
+    Registry &r = registry();
+    const auto locker = qt_scoped_lock(r.mutex);
+    Pool *pool = r.orphans;
+    if (pool) {
+        r.orphans = pool->nextOrphan;
+        pool->nextOrphan = nullptr;
+    } else {
+        pool = new Pool;
+        r.pools.push_back(pool);
+    }
+    currentPool = pool;
+    return pool;
+}
+
+inline Pool *threadPool()
+{
+    if (Pool *pool = currentPool)
+        return pool;
+    return createThreadPool();
+}
+
+inline int sizeClass(std::size_t size)
+{
+    return size ? int((size - 1) / Granularity) : 0;
+}
+
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Allocates \a size bytes, from the calling thread's pool if \a size is
+    small enough. The memory must be released with deallocate(), passing the
+    same \a size.
+*/
+void *allocate(std::size_t size)
+{
+#ifdef QT_ASAN_ENABLED
+    // keep use-after-free detection working
+    return ::operator new(size);
+#else
+    if (size > MaxPooledSize)
+        return ::operator new(size);
+
+    const int cls = sizeClass(size);
+    Pool *pool = threadPool();
+    if (pool) {
+        Header *block = pool->local[cls];
+        if (!block) {
+            block = pool->returned[cls].exchange(nullptr, std::memory_order_acquire);
+            int count = 0;
+            for (Header *h = block; h; h = h->next)
+                ++count;
+            pool->localCount[cls] = count;
+        }
+        if (block) {
+            pool->local[cls] = block->next;
+            --pool->localCount[cls];
+            bump(pool->hits);
+            return block + 1;
+        }
+        bump(pool->misses);
+    }
+
+    auto block = static_cast<Header *>(::operator new(sizeof(Header) + (cls + 1) * Granularity));
+    block->owner = pool;
+    return block + 1;
+#endif
+}
+
+/*!
+    \internal
+
+    Releases \a ptr, which was returned by allocate() for \a size bytes. If
+    another thread allocated it, the block goes back to that thread's pool.
+*/
+void deallocate(void *ptr, std::size_t size) noexcept
+{
+    if (!ptr)
+        return;
+#ifdef QT_ASAN_ENABLED
+    ::operator delete(ptr);
+#else
+    if (size > MaxPooledSize) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const int cls = sizeClass(size);
+    Header *block = static_cast<Header *>(ptr) - 1;
+    Pool *owner = block->owner;
+    Pool *pool = currentPool;
+    if (owner && owner == pool) {
+        if (pool->localCount[cls] < MaxLocalBlocks) {
+            block->next = pool->local[cls];
+            pool->local[cls] = block;
+            ++pool->localCount[cls];
+            return;
+        }
+    } else if (owner) {
+        std::atomic<Header *> &returned = owner->returned[cls];
+        Header *head = returned.load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!returned.compare_exchange_weak(head, block, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        if (pool)
+            bump(pool->remoteFrees);
+        return;
+    }
+    ::operator delete(block);
+#endif
+}
+
+/*!
+    \internal
+
+    Returns the allocation counters summed over all threads.
+*/
+Statistics statistics()
+{
+    Statistics result;
+    Registry &r = registry();
+    const auto locker = qt_scoped_lock(r.mutex);
+    for (const Pool *pool : r.pools) {
+        result.hits += pool->hits.load(std::memory_order_relaxed);
+        result.misses += pool->misses.load(std::memory_order_relaxed);
+        result.remoteFrees += pool->remoteFrees.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+} // namespace QEventMemoryPool
+
+QT_END_NAMESPACE
@@ -0,0 +1,64 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QEVENTMEMORYPOOL_P_H
+#define QEVENTMEMORYPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+#include <cstddef>
+
+QT_BEGIN_NAMESPACE
+
+// Per-thread recycling pools for the small, short-lived allocations made for
+// posted events (the events themselves and the argument copies of queued
+// calls). Blocks freed by another thread are handed back to the pool of the
+// thread that allocated them, so that producer threads keep reusing the
+// memory their consumers release.
+namespace QEventMemoryPool {
+
+// largest size served from the pools; bigger requests go to the heap
+constexpr std::size_t MaxPooledSize = 256;
+
+Q_CORE_EXPORT void *allocate(std::size_t size);
+Q_CORE_EXPORT void deallocate(void *ptr, std::size_t size) noexcept;
+
+struct Statistics
+{
+    quint64 hits = 0;           // allocations served from a pool
+    quint64 misses = 0;         // pooled sizes that had to go to the heap
+    quint64 remoteFrees = 0;    // blocks returned to another thread's pool
+};
+
+// totals over all threads, for diagnostics and tests
+Q_CORE_EXPORT Statistics statistics();
+
+} // namespace QEventMemoryPool
+
+// gives an event class (and its subclasses) pooled allocation
+#define Q_EVENT_MEMORY_POOL_ALLOCATED \
+public: \
+    static void *operator new(std::size_t size) \
+    { return QEventMemoryPool::allocate(size); } \
+    static void *operator new(std::size_t, void *where) noexcept \
+    { return where; } \
+    static void operator delete(void *ptr, std::size_t size) noexcept \
+    { QEventMemoryPool::deallocate(ptr, size); } \
+    static void operator delete(void *, void *) noexcept \
+    { } \
+private:
+
+QT_END_NAMESPACE
+
+#endif // QEVENTMEMORYPOOL_P_H
@@ -1643,12 +1643,11 @@ bool QMetaObject::invokeMethodImpl(QObject *object, QtPrivate::QSlotObjectBase *
             return false;
         }
         auto event = std::make_unique<QMetaCallEvent>(std::move(slot), nullptr, -1, parameterCount);
-        void **args = event->args();
         QMetaType *types = event->types();
 
         for (int i = 1; i < parameterCount; ++i) {
             types[i] = QMetaType(metaTypes[i]);
-            args[i] = types[i].create(argv[i]);
+            event->createArgument(i, argv[i]);
         }
 
         QCoreApplication::postEvent(object, event.release());
@@ -2761,7 +2760,6 @@ auto QMetaMethodInvoker::invokeImpl(QMetaMethod self, void *target,
 
         auto event = std::make_unique<QMetaCallEvent>(idx_offset, idx_relative, callFunction, nullptr, -1, paramCount);
         QMetaType *types = event->types();
-        void **args = event->args();
 
         // fill in the meta types first
         for (int i = 1; i < paramCount; ++i) {
@@ -2781,7 +2779,7 @@ auto QMetaMethodInvoker::invokeImpl(QMetaMethod self, void *target,
 
         // now create copies of our parameters using those meta types
         for (int i = 1; i < paramCount; ++i)
-            args[i] = types[i].create(parameters[i]);
+            event->createArgument(i, parameters[i]);
 
         QCoreApplication::postEvent(object, event.release());
     } else { // blocking queued connection
@@ -36,6 +36,7 @@
 #include <new>
 #include <mutex>
 #include <memory>
+#include <utility>
 
 #include <ctype.h>
 #include <limits.h>
@@ -519,13 +520,38 @@ inline void QMetaCallEvent::allocArgs()
         return;
 
     constexpr size_t each = sizeof(void*) + sizeof(QMetaType);
-    void *const memory = d.nargs_ * each > sizeof(prealloc_) ?
-        calloc(d.nargs_, each) : prealloc_;
+    const size_t size = d.nargs_ * each;
+    void *memory = prealloc_;
+    if (size > sizeof(prealloc_)) {
+        memory = QEventMemoryPool::allocate(size);
+        memset(memory, 0, size);
+    }
 
-    Q_CHECK_PTR(memory);
     d.args_ = static_cast<void **>(memory);
 }
 
+/*!
+    \internal
+
+    Creates argument \a n as a copy of \a value, using the type that has
+    already been set in types(). Small arguments are allocated from the
+    thread's event memory pool.
+ */
+void *QMetaCallEvent::createArgument(int n, const void *value)
+{
+    Q_ASSERT(n > 0 && n < d.nargs_);
+    const QMetaType type = types()[n];
+    const size_t size = size_t(type.sizeOf());
+    if (n < 32 && size && size <= QEventMemoryPool::MaxPooledSize
+            && size_t(type.alignOf()) <= alignof(std::max_align_t)) {
+        void *where = QEventMemoryPool::allocate(size);
+        type.construct(where, value);
+        d.pooledArgs_ |= 1u << n;
+        return d.args_[n] = where;
+    }
+    return d.args_[n] = type.create(value);
+}
+
 /*!
     \internal
 
@@ -537,7 +563,7 @@ QMetaCallEvent::QMetaCallEvent(ushort method_offset, ushort method_relative,
                                const QObject *sender, int signalId,
                                void **args, QSemaphore *semaphore)
     : QAbstractMetaCallEvent(sender, signalId, semaphore),
-      d({nullptr, args, callFunction, 0, method_offset, method_relative}),
+      d({nullptr, args, callFunction, 0, method_offset, method_relative, 0}),
       prealloc_()
 {
 }
@@ -552,7 +578,7 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::QSlotObjectBase *slotO,
                                const QObject *sender, int signalId,
                                void **args, QSemaphore *semaphore)
     : QAbstractMetaCallEvent(sender, signalId, semaphore),
-      d({QtPrivate::SlotObjUniquePtr{slotO}, args, nullptr, 0, 0, ushort(-1)}),
+      d({QtPrivate::SlotObjUniquePtr{slotO}, args, nullptr, 0, 0, ushort(-1), 0}),
       prealloc_()
 {
     if (d.slotObj_)
@@ -569,7 +595,7 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::SlotObjUniquePtr slotO,
                                const QObject *sender, int signalId,
                                void **args, QSemaphore *semaphore)
     : QAbstractMetaCallEvent(sender, signalId, semaphore),
-      d{std::move(slotO), args, nullptr, 0, 0, ushort(-1)},
+      d{std::move(slotO), args, nullptr, 0, 0, ushort(-1), 0},
       prealloc_()
 {
 }
@@ -585,7 +611,7 @@ QMetaCallEvent::QMetaCallEvent(ushort method_offset, ushort method_relative,
                                const QObject *sender, int signalId,
                                int nargs)
     : QAbstractMetaCallEvent(sender, signalId),
-      d({nullptr, nullptr, callFunction, nargs, method_offset, method_relative}),
+      d({nullptr, nullptr, callFunction, nargs, method_offset, method_relative, 0}),
       prealloc_()
 {
     allocArgs();
@@ -601,7 +627,7 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::QSlotObjectBase *slotO,
                                const QObject *sender, int signalId,
                                int nargs)
     : QAbstractMetaCallEvent(sender, signalId),
-      d({QtPrivate::SlotObjUniquePtr(slotO), nullptr, nullptr, nargs, 0, ushort(-1)}),
+      d({QtPrivate::SlotObjUniquePtr(slotO), nullptr, nullptr, nargs, 0, ushort(-1), 0}),
       prealloc_()
 {
     if (d.slotObj_)
@@ -619,7 +645,7 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::SlotObjUniquePtr slotO,
                                const QObject *sender, int signalId,
                                int nargs)
     : QAbstractMetaCallEvent(sender, signalId),
-      d{std::move(slotO), nullptr, nullptr, nargs, 0, ushort(-1)},
+      d{std::move(slotO), nullptr, nullptr, nargs, 0, ushort(-1), 0},
       prealloc_()
 {
     allocArgs();
@@ -633,11 +659,17 @@ QMetaCallEvent::~QMetaCallEvent()
     if (d.nargs_) {
         QMetaType *t = types();
         for (int i = 0; i < d.nargs_; ++i) {
-            if (t[i].isValid() && d.args_[i])
+            if (!t[i].isValid() || !d.args_[i])
+                continue;
+            if (i < 32 && (d.pooledArgs_ & (1u << i))) {
+                t[i].destruct(d.args_[i]);
+                QEventMemoryPool::deallocate(d.args_[i], t[i].sizeOf());
+            } else {
                 t[i].destroy(d.args_[i]);
+            }
         }
         if (reinterpret_cast<void *>(d.args_) != reinterpret_cast<void *>(prealloc_))
-            free(d.args_);
+            QEventMemoryPool::deallocate(d.args_, d.nargs_ * (sizeof(void *) + sizeof(QMetaType)));
     }
 }
 
@@ -666,15 +698,281 @@ QMetaCallEvent* QMetaCallEvent::create_impl(QtPrivate::SlotObjUniquePtr slotObj,
 
     void **args = metaCallEvent->args();
     QMetaType *types = metaCallEvent->types();
-    for (size_t i = 0; i < argc; ++i) {
+    args[0] = nullptr;
+    for (size_t i = 0; i < argc; ++i)
         types[i] = metaTypes[i];
-        args[i] = types[i].create(argp[i]);
-        Q_CHECK_PTR(!i || args[i]);
-    }
+    for (size_t i = 1; i < argc; ++i)
+        metaCallEvent->createArgument(int(i), argp[i]);
 
     return metaCallEvent.release();
 }
 
+namespace {
+
+/*
+    Calls made through connections with Qt::BatchedConnection set. The
+    emitting thread keeps one open batch per receiver: the first emission
+    posts a QMetaCallBatchEvent (and so wakes up the receiver's thread), later
+    ones only append to the batch. A batch is closed when the receiver's
+    thread starts delivering it, or when the emitting thread starts its next
+    event loop iteration; the next emission then opens a new one.
+
+    The calls and their arguments live in arena chunks owned by the batch.
+    Only the emitting thread allocates from them and links calls in under
+    the mutex; the receiving thread only ever sees committed calls.
+*/
+class QMetaCallBatch
+{
+    Q_DISABLE_COPY_MOVE(QMetaCallBatch)
+public:
+    struct Call
+    {
+        Call *next;
+        QtPrivate::QSlotObjectBase *slotObj;
+        QObjectPrivate::StaticMetaCallFunction callFunction;
+        const QObject *sender;
+        void **args;
+        QMetaType *types;
+        int signalId;
+        int nargs;
+        ushort method_offset;
+        ushort method_relative;
+
+        void destroy()
+        {
+            for (int i = 1; i < nargs; ++i)
+                types[i].destruct(args[i]);
+            if (slotObj)
+                slotObj->destroyIfLastRef();
+        }
+
+        void placeMetaCall(QObject *object)
+        {
+            if (slotObj) {
+                slotObj->call(object, args);
+            } else if (callFunction && method_offset <= object->metaObject()->methodOffset()) {
+                callFunction(object, QMetaObject::InvokeMetaMethod, method_relative, args);
+            } else {
+                QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod,
+                                      method_offset + method_relative, args);
+            }
+        }
+    };
+
+    QMetaCallBatch() = default;
+
+    void ref() { ref_.ref(); }
+    void deref()
+    {
+        if (!ref_.deref())
+            delete this;
+    }
+
+    bool isClosed() const { return closed.loadAcquire(); }
+
+    // emitting thread
+    Call *createCall(const QObjectPrivate::Connection *c, QtPrivate::QSlotObjectBase *slotObj,
+                     const QObject *sender, int signal, int nargs, const int *argumentTypes,
+                     void **argv);
+    bool commit(Call *call);
+
+    // receiving thread; returns the committed calls, in order
+    Call *close();
+
+private:
+    ~QMetaCallBatch() = default;
+    void *allocate(size_t size, size_t alignment);
+
+    static constexpr int MaxCalls = 1024;
+    static constexpr size_t ChunkSize = 4096;
+
+    QAtomicInt ref_ = 1;
+    QBasicMutex mutex;
+    QAtomicInt closed;
+    Call *first = nullptr;
+    Call *last = nullptr;
+    int callCount = 0;
+
+    // arena, only touched by the emitting thread
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char *current = nullptr;
+    size_t available = 0;
+};
+
+void *QMetaCallBatch::allocate(size_t size, size_t alignment)
+{
+    auto padding = [&] { return (alignment - quintptr(current) % alignment) % alignment; };
+    if (!current || padding() + size > available) {
+        const size_t chunkSize = qMax(ChunkSize, size + alignment);
+        chunks.emplace_back(new char[chunkSize]);
+        current = chunks.back().get();
+        available = chunkSize;
+    }
+    const size_t pad = padding();
+    void *result = current + pad;
+    current += pad + size;
+    available -= pad + size;
+    return result;
+}
+
+QMetaCallBatch::Call *QMetaCallBatch::createCall(const QObjectPrivate::Connection *c,
+                                                 QtPrivate::QSlotObjectBase *slotObj,
+                                                 const QObject *sender, int signal, int nargs,
+                                                 const int *argumentTypes, void **argv)
+{
+    void *memory = allocate(sizeof(Call) + nargs * (sizeof(void *) + sizeof(QMetaType)),
+                            alignof(Call));
+    Call *call = new (memory) Call;
+    call->next = nullptr;
+    call->slotObj = slotObj;
+    if (slotObj)
+        slotObj->ref();
+    call->callFunction = slotObj ? nullptr : c->callFunction;
+    call->sender = sender;
+    call->args = reinterpret_cast<void **>(call + 1);
+    call->types = reinterpret_cast<QMetaType *>(call->args + nargs);
+    for (int n = 0; n < nargs; ++n)
+        new (call->types + n) QMetaType;
+    call->signalId = signal;
+    call->nargs = nargs;
+    call->method_offset = slotObj ? 0 : c->method_offset;
+    call->method_relative = slotObj ? ushort(-1) : c->method_relative;
+
+    call->args[0] = nullptr; // return value
+    for (int n = 1; n < nargs; ++n) {
+        const QMetaType type(argumentTypes[n - 1]);
+        call->types[n] = type;
+        call->args[n] = allocate(type.sizeOf(), type.alignOf());
+        type.construct(call->args[n], argv[n]);
+    }
+    return call;
+}
+
+bool QMetaCallBatch::commit(Call *call)
+{
+    const auto locker = qt_scoped_lock(mutex);
+    if (closed.loadRelaxed() || callCount == MaxCalls)
+        return false;
+    if (last)
+        last->next = call;
+    else
+        first = call;
+    last = call;
+    ++callCount;
+    return true;
+}
+
+QMetaCallBatch::Call *QMetaCallBatch::close()
+{
+    const auto locker = qt_scoped_lock(mutex);
+    closed.storeRelease(1);
+    return std::exchange(first, nullptr);
+}
+
+class QMetaCallBatchEvent : public QAbstractMetaCallEvent
+{
+public:
+    explicit QMetaCallBatchEvent(QMetaCallBatch *batch)
+        : QAbstractMetaCallEvent(nullptr, -1), batch(batch)
+    {
+        batch->ref();
+    }
+
+    ~QMetaCallBatchEvent() override
+    {
+        if (!delivered)
+            calls = batch->close();
+        for (QMetaCallBatch::Call *call = calls; call; call = call->next)
+            call->destroy();
+        batch->deref();
+    }
+
+    void placeMetaCall(QObject *object) override
+    {
+        calls = batch->close();
+        delivered = true;
+        for (QMetaCallBatch::Call *call = calls; call; call = call->next) {
+            QObjectPrivate::Sender sender(object, const_cast<QObject *>(call->sender),
+                                          call->signalId);
+            call->placeMetaCall(object);
+            if (!sender.receiver) // deleted by the slot
+                break;
+        }
+    }
+
+private:
+    QMetaCallBatch *batch;
+    QMetaCallBatch::Call *calls = nullptr;
+    bool delivered = false;
+};
+
+// the batches the current thread may still append to, by receiver
+class QOpenMetaCallBatches
+{
+public:
+    ~QOpenMetaCallBatches() { clear(); }
+
+    QMetaCallBatch *find(const QObject *receiver) const
+    {
+        for (const auto &entry : batches) {
+            if (entry.first == receiver)
+                return entry.second;
+        }
+        return nullptr;
+    }
+
+    void insert(const QObject *receiver, QMetaCallBatch *batch)
+    {
+        // threads without an event loop never clear the table, so drop the
+        // batches that their receivers have closed in the meantime
+        if (batches.size() >= 64) {
+            batches.removeIf([](const auto &entry) {
+                if (!entry.second->isClosed())
+                    return false;
+                entry.second->deref();
+                return true;
+            });
+        }
+        for (auto &entry : batches) {
+            if (entry.first == receiver) {
+                entry.second->deref();
+                entry.second = batch;
+                return;
+            }
+        }
+        batches.emplace_back(receiver, batch);
+    }
+
+    void clear()
+    {
+        for (const auto &entry : std::as_const(batches))
+            entry.second->deref();
+        batches.clear();
+    }
+
+    bool isEmpty() const { return batches.isEmpty(); }
+
+private:
+    QVarLengthArray<std::pair<const QObject *, QMetaCallBatch *>, 8> batches;
+};
+
+thread_local QOpenMetaCallBatches openMetaCallBatches;
+
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Closes the batches of queued calls that the current thread opened through
+    connections with Qt::BatchedConnection set; called once per event loop
+    iteration.
+*/
+void QObjectPrivate::closeMetaCallBatches()
+{
+    if (!openMetaCallBatches.isEmpty())
+        openMetaCallBatches.clear();
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -1724,6 +2022,12 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // wait out lock-free posters that may still push events for this object
+    // into the current inbox, then move what they pushed into the list so
+    // that setThreadData_helper() hands it over to targetData
+    currentData->postEventList.inbox.block();
+    currentData->flushPostEventInbox();
+
     // move the object
     auto threadPrivate =  targetThread
         ? static_cast<QThreadPrivate *>(QThreadPrivate::get(targetThread))
@@ -1735,6 +2039,7 @@ void QObject::moveToThread(QThread *targetThread)
         bindingStatus = threadPrivate->addObjectWithPendingBindingStatusChange(this);
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
+    currentData->postEventList.inbox.unblock();
 
     locker.unlock();
 
@@ -3535,6 +3840,9 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isBatched = type & Qt::BatchedConnection;
+    type &= ~Qt::BatchedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -3552,6 +3860,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isBatched = isBatched;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3881,6 +4190,46 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     SlotObjectGuard slotObjectGuard { c->isSlotObject ? c->slotObj : nullptr };
     locker.unlock();
 
+    if (c->isBatched && !c->isSingleShot) {
+        QMetaCallBatch *batch = openMetaCallBatches.find(receiver);
+        auto createCall = [&](QMetaCallBatch *batch) {
+            return batch->createCall(c, c->isSlotObject ? slotObjectGuard.operator->() : nullptr,
+                                     sender, signal, nargs, argumentTypes, argv);
+        };
+        if (batch) {
+            QMetaCallBatch::Call *call = createCall(batch);
+            locker.relock();
+            if (!c->receiver.loadRelaxed()) {
+                locker.unlock();
+                call->destroy();
+                return;
+            }
+            if (batch->commit(call))
+                return;
+            locker.unlock();
+            // closed or full, its arena memory is released along with it
+            call->destroy();
+        }
+
+        batch = new QMetaCallBatch;
+        const auto batchDeref = qScopeGuard([batch] { batch->deref(); });
+        QMetaCallBatch::Call *call = createCall(batch);
+        batch->commit(call);
+        auto ev = std::make_unique<QMetaCallBatchEvent>(batch);
+
+        locker.relock();
+        if (!c->receiver.loadRelaxed()) {
+            // the connection has been disconnected while we were unlocked
+            locker.unlock();
+            return;
+        }
+        QCoreApplication::postEvent(receiver, ev.release());
+        locker.unlock();
+        batch->ref();
+        openMetaCallBatches.insert(receiver, batch);
+        return;
+    }
+
     QMetaCallEvent *ev = c->isSlotObject ?
         new QMetaCallEvent(c->slotObj, sender, signal, nargs) :
         new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs);
@@ -3896,7 +4245,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
             types[n] = QMetaType(argumentTypes[n - 1]);
 
         for (int n = 1; n < nargs; ++n)
-            args[n] = types[n].create(argv[n]);
+            ev->createArgument(n, argv[n]);
     }
 
     if (c->isSingleShot && !QObjectPrivate::removeConnection(c)) {
@@ -5187,6 +5536,9 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isBatched = type & Qt::BatchedConnection;
+    type &= ~Qt::BatchedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -5205,6 +5557,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isBatched = isBatched;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
@@ -26,6 +26,7 @@
 #include "QtCore/qproperty.h"
 #include <QtCore/qshareddata.h>
 #include "QtCore/private/qproperty_p.h"
+#include "QtCore/private/qeventmemorypool_p.h"
 
 #include <string>
 
@@ -149,6 +150,8 @@ public:
     inline void addConnection(int signal, Connection *c);
     static inline bool removeConnection(Connection *c);
 
+    static void closeMetaCallBatches();
+
     static QObjectPrivate *get(QObject *o) { return o->d_func(); }
     static const QObjectPrivate *get(const QObject *o) { return o->d_func(); }
 
@@ -341,6 +344,7 @@ bool QObjectPrivate::disconnect(const typename QtPrivate::FunctionPointer< Func1
 class QSemaphore;
 class Q_CORE_EXPORT QAbstractMetaCallEvent : public QEvent
 {
+    Q_EVENT_MEMORY_POOL_ALLOCATED
 public:
     QAbstractMetaCallEvent(const QObject *sender, int signalId, QSemaphore *semaphore = nullptr)
         : QEvent(MetaCall), signalId_(signalId), sender_(sender)
@@ -417,6 +421,9 @@ public:
     inline const QMetaType *types() const { return reinterpret_cast<QMetaType *>(d.args_ + d.nargs_); }
     inline QMetaType *types() { return reinterpret_cast<QMetaType *>(d.args_ + d.nargs_); }
 
+    // copies \a value into argument \a n, whose type must have been set
+    void *createArgument(int n, const void *value);
+
     virtual void placeMetaCall(QObject *object) override;
 
 private:
@@ -441,6 +448,7 @@ private:
         int nargs_;
         ushort method_offset_;
         ushort method_relative_;
+        quint32 pooledArgs_; // arguments allocated by createArgument()
     } d;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
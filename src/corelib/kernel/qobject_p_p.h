@@ -93,7 +93,8 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
     ushort isSlotObject : 1;
     ushort ownArgumentTypes : 1;
     ushort isSingleShot : 1;
-    Connection() : ownArgumentTypes(true) { }
+    ushort isBatched : 1;
+    Connection() : ownArgumentTypes(true), isBatched(false) { }
     ~Connection();
     int method() const
     {
@@ -10,6 +10,8 @@
 #include "private/qobject_p.h"
 #include "private/qabstracteventdispatcher_p.h"
 
+#include <QtCore/qvarlengtharray.h>
+
 #include <sys/times.h>
 
 using namespace std::chrono;
@@ -37,7 +39,8 @@ steady_clock::time_point QTimerInfoList::updateCurrentTime()
     Updates the currentTime member to the current time, and returns \c true if
     the first timer's timeout is in the future (after currentTime).
 
-    The list is sorted by timeout, thus it's enough to check the first timer only.
+    The list is a heap ordered by timeout, thus it's enough to check the first
+    timer only.
 */
 bool QTimerInfoList::hasPendingTimers()
 {
@@ -47,15 +50,109 @@ bool QTimerInfoList::hasPendingTimers()
 }
 
 static bool byTimeout(const QTimerInfo *a, const QTimerInfo *b)
-{ return a->timeout < b->timeout; };
+{
+    if (a->timeout != b->timeout)
+        return a->timeout < b->timeout;
+    // timers with the same timeout fire in the order they were (re)inserted
+    return a->sequence < b->sequence;
+}
+
+static constexpr qsizetype HeapArity = 4;
+
+static constexpr qsizetype heapParent(qsizetype index)
+{ return (index - 1) / HeapArity; }
+
+static constexpr qsizetype heapFirstChild(qsizetype index)
+{ return index * HeapArity + 1; }
+
+void QTimerInfoList::heapSiftUp(qsizetype index)
+{
+    QTimerInfo *ti = timers.at(index);
+    while (index > 0) {
+        const qsizetype parent = heapParent(index);
+        QTimerInfo *p = timers.at(parent);
+        if (!byTimeout(ti, p))
+            break;
+        timers[index] = p;
+        p->heapIndex = index;
+        index = parent;
+    }
+    timers[index] = ti;
+    ti->heapIndex = index;
+}
+
+void QTimerInfoList::heapSiftDown(qsizetype index)
+{
+    const qsizetype count = timers.size();
+    QTimerInfo *ti = timers.at(index);
+    forever {
+        const qsizetype first = heapFirstChild(index);
+        if (first >= count)
+            break;
+        const qsizetype last = qMin(first + HeapArity, count);
+        qsizetype smallest = first;
+        for (qsizetype child = first + 1; child < last; ++child) {
+            if (byTimeout(timers.at(child), timers.at(smallest)))
+                smallest = child;
+        }
+        QTimerInfo *c = timers.at(smallest);
+        if (!byTimeout(c, ti))
+            break;
+        timers[index] = c;
+        c->heapIndex = index;
+        index = smallest;
+    }
+    timers[index] = ti;
+    ti->heapIndex = index;
+}
+
+void QTimerInfoList::heapRemove(qsizetype index)
+{
+    QTimerInfo *last = timers.takeLast();
+    if (index == timers.size())
+        return;
+
+    timers[index] = last;
+    last->heapIndex = index;
+    if (index > 0 && byTimeout(last, timers.at(heapParent(index))))
+        heapSiftUp(index);
+    else
+        heapSiftDown(index);
+}
 
 /*
-  insert timer info into list
+  insert timer info into the heap
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    timers.insert(std::upper_bound(timers.cbegin(), timers.cend(), ti, byTimeout),
-                  ti);
+    ti->sequence = nextSequence++;
+    timers.append(ti);
+    heapSiftUp(timers.size() - 1);
+}
+
+/*
+  Returns how many timers have expired at \a now, visiting only those.
+*/
+qsizetype QTimerInfoList::expiredTimerCount(steady_clock::time_point now) const
+{
+    if (timers.isEmpty() || now < timers.constFirst()->timeout)
+        return 0;
+
+    qsizetype count = 0;
+    QVarLengthArray<qsizetype, 64> pending;
+    pending.append(0);
+    while (!pending.isEmpty()) {
+        const qsizetype index = pending.last();
+        pending.removeLast();
+        ++count;
+        const qsizetype first = heapFirstChild(index);
+        const qsizetype last = qMin(first + HeapArity, timers.size());
+        for (qsizetype child = first; child < last; ++child) {
+            if (!(now < timers.at(child)->timeout))
+                pending.append(child);
+        }
+    }
+    return count;
 }
 
 static constexpr milliseconds roundToMillisecond(nanoseconds val)
@@ -238,13 +335,33 @@ std::optional<std::chrono::milliseconds> QTimerInfoList::timerWait()
 {
     steady_clock::time_point now = updateCurrentTime();
 
-    auto isWaiting = [](QTimerInfo *tinfo) { return !tinfo->activateRef; };
-    // Find first waiting timer not already active
-    auto it = std::find_if(timers.cbegin(), timers.cend(), isWaiting);
-    if (it == timers.cend())
+    // Find first waiting timer not already active. Timers being activated are
+    // the ones on the activateTimers() call stack, so there are very few of
+    // them: only their children can be the earliest waiting timer.
+    const QTimerInfo *first = nullptr;
+    QVarLengthArray<qsizetype, 16> candidates;
+    if (!timers.isEmpty())
+        candidates.append(0);
+    while (!candidates.isEmpty()) {
+        auto it = std::min_element(candidates.begin(), candidates.end(),
+                                   [this](qsizetype a, qsizetype b) {
+                                       return byTimeout(timers.at(a), timers.at(b));
+                                   });
+        const qsizetype index = *it;
+        candidates.erase(it);
+        if (!timers.at(index)->activateRef) {
+            first = timers.at(index);
+            break;
+        }
+        const qsizetype firstChild = heapFirstChild(index);
+        const qsizetype lastChild = qMin(firstChild + HeapArity, timers.size());
+        for (qsizetype child = firstChild; child < lastChild; ++child)
+            candidates.append(child);
+    }
+    if (!first)
         return std::nullopt;
 
-    nanoseconds timeToWait = (*it)->timeout - now;
+    nanoseconds timeToWait = first->timeout - now;
     if (timeToWait > 0ns)
         return roundToMillisecond(timeToWait);
     return 0ms;
@@ -264,15 +381,14 @@ milliseconds QTimerInfoList::remainingDuration(int timerId)
 {
     const steady_clock::time_point now = updateCurrentTime();
 
-    auto it = findTimerById(timerId);
-    if (it == timers.cend()) {
+    const QTimerInfo *t = findTimerById(timerId);
+    if (!t) {
 #ifndef QT_NO_DEBUG
         qWarning("QTimerInfoList::timerRemainingTime: timer id %i not found", timerId);
 #endif
         return -1ms;
     }
 
-    const QTimerInfo *t = *it;
     if (now < t->timeout) // time to wait
         return roundToMillisecond(t->timeout - now);
     return 0ms;
@@ -324,23 +440,23 @@ void QTimerInfoList::registerTimer(int timerId, milliseconds interval,
             t->timeout += 1s;
     }
 
+    timersById.insert(timerId, t);
     timerInsert(t);
 }
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    auto it = findTimerById(timerId);
-    if (it == timers.cend())
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
         return false; // id not found
 
     // set timer inactive
-    QTimerInfo *t = *it;
     if (t == firstTimerInfo)
         firstTimerInfo = nullptr;
     if (t->activateRef)
         *(t->activateRef) = nullptr;
+    heapRemove(t->heapIndex);
     delete t;
-    timers.erase(it);
     return true;
 }
 
@@ -356,6 +472,7 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
                     firstTimerInfo = nullptr;
                 if (t->activateRef)
                     *(t->activateRef) = nullptr;
+                timersById.remove(t->id);
                 delete t;
                 return true;
             }
@@ -364,16 +481,33 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
     };
 
     qsizetype count = timers.removeIf(associatedWith(object));
-    return count > 0;
+    if (count == 0)
+        return false;
+
+    // restore the heap property over what is left, bottom-up
+    if (!timers.isEmpty()) {
+        for (qsizetype i = 0; i < timers.size(); ++i)
+            timers.at(i)->heapIndex = i;
+        for (qsizetype i = heapParent(timers.size() - 1); i >= 0; --i)
+            heapSiftDown(i);
+    }
+    return true;
 }
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
-    QList<QAbstractEventDispatcher::TimerInfo> list;
+    QVarLengthArray<const QTimerInfo *, 16> matching;
     for (const auto &t : timers) {
         if (t->obj == object)
-            list.emplaceBack(t->id, t->interval.count(), t->timerType);
+            matching.append(t);
     }
+    // report them in the order they are going to fire
+    std::sort(matching.begin(), matching.end(), byTimeout);
+
+    QList<QAbstractEventDispatcher::TimerInfo> list;
+    list.reserve(matching.size());
+    for (const QTimerInfo *t : std::as_const(matching))
+        list.emplaceBack(t->id, t->interval.count(), t->timerType);
     return list;
 }
 
@@ -390,10 +524,7 @@ int QTimerInfoList::activateTimers()
     const steady_clock::time_point now = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << now;
     // Find out how many timer have expired
-    auto stillActive = [&now](const QTimerInfo *t) { return now < t->timeout; };
-    // Find first one still active (list is sorted by timeout)
-    auto it = std::find_if(timers.cbegin(), timers.cend(), stillActive);
-    auto maxCount = it - timers.cbegin();
+    auto maxCount = expiredTimerCount(now);
 
     int n_act = 0;
     //fire the timers.
@@ -417,13 +548,10 @@ int QTimerInfoList::activateTimers()
 
         // determine next timeout time
         calculateNextTimeout(currentTimerInfo, now);
-        if (timers.size() > 1) {
-            // Find where "currentTimerInfo" should be in the list so as
-            // to keep the list ordered by timeout
-            auto afterCurrentIt = timers.begin() + 1;
-            auto iter = std::upper_bound(afterCurrentIt, timers.end(), currentTimerInfo, byTimeout);
-            currentTimerInfo = *std::rotate(timers.begin(), afterCurrentIt, iter);
-        }
+        // move it behind all timers with the same timeout to keep the
+        // heap ordered by timeout
+        currentTimerInfo->sequence = nextSequence++;
+        heapSiftDown(0);
 
         if (currentTimerInfo->interval > 0ms)
             n_act++;
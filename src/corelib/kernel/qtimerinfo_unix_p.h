@@ -18,6 +18,7 @@
 #include <QtCore/private/qglobal_p.h>
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timespec
 #include <chrono>
@@ -37,6 +38,8 @@ struct QTimerInfo {
     Qt::TimerType timerType; // - timer type
     QObject *obj = nullptr; // - object to receive event
     QTimerInfo **activateRef = nullptr; // - ref from activateTimers
+    qsizetype heapIndex = -1; // - position in QTimerInfoList::timers
+    quint64 sequence = 0; // - insertion order, breaks ties between equal timeouts
 };
 
 class Q_CORE_EXPORT QTimerInfoList
@@ -66,24 +69,31 @@ public:
     {
         qDeleteAll(timers);
         timers.clear();
+        timersById.clear();
     }
 
     bool isEmpty() const { return timers.empty(); }
 
     qsizetype size() const { return timers.size(); }
 
-    auto findTimerById(int timerId)
-    {
-        auto matchesId = [timerId](const auto &t) { return t->id == timerId; };
-        return std::find_if(timers.cbegin(), timers.cend(), matchesId);
-    }
+    QTimerInfo *findTimerById(int timerId) const { return timersById.value(timerId); }
 
 private:
     std::chrono::steady_clock::time_point updateCurrentTime();
 
+    qsizetype expiredTimerCount(std::chrono::steady_clock::time_point now) const;
+    void heapSiftUp(qsizetype index);
+    void heapSiftDown(qsizetype index);
+    void heapRemove(qsizetype index);
+
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo = nullptr;
+
+    // 4-ary min-heap ordered by (timeout, sequence), so registering,
+    // re-arming and unregistering a timer are all O(log n)
     QList<QTimerInfo *> timers;
+    QHash<int, QTimerInfo *> timersById;
+    quint64 nextSequence = 0;
 };
 
 QT_END_NAMESPACE
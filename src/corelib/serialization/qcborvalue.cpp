@@ -915,6 +915,8 @@ static inline int typeOrder(Element e1, Element e2)
 
 QCborContainerPrivate::~QCborContainerPrivate()
 {
+    delete keyIndex.loadRelaxed();
+
     // delete our elements
     for (Element &e : elements) {
         if (e.flags & Element::IsContainer)
@@ -939,6 +941,8 @@ QCborContainerPrivate *QCborContainerPrivate::clone(QCborContainerPrivate *d, qs
     } else {
         // in case QList::reserve throws
         QExplicitlySharedDataPointer u(new QCborContainerPrivate(*d));
+        u->keyIndex.storeRelaxed(nullptr);     // owned by d
+        u->keyLookups.storeRelaxed(0);
         if (reserved >= 0) {
             u->elements.reserve(reserved);
             u->compact(reserved);
@@ -1017,6 +1021,17 @@ void QCborContainerPrivate::replaceAt_complex(Element &e, const QCborValue &valu
                 e.value = addByteData(b->toByteArray(), b->len);
             else
                 e.value = addByteData(b->byte(), b->len);
+        } else if (e.flags & Element::StringIsExternal && this != value.container) {
+            // we don't share the other container's source text
+            if (e.flags & Element::StringHasEscapes) {
+                const QString s = value.container->externalString(e);
+                e.value = addByteData(reinterpret_cast<const char *>(s.utf16()), s.size() * 2);
+                e.flags = Element::HasByteData | Element::StringIsUtf16;
+            } else {
+                const QByteArrayView utf8 = value.container->externalData(e);
+                e.value = addByteData(utf8.data(), utf8.size());
+                e.flags = Element::HasByteData | (e.flags & Element::StringIsAscii);
+            }
         }
 
         if (disp == MoveContainer)
@@ -1043,11 +1058,17 @@ Q_NEVER_INLINE void QCborContainerPrivate::appendAsciiString(QStringView s)
 
 QCborValue QCborContainerPrivate::extractAt_complex(Element e)
 {
+    auto container = new QCborContainerPrivate;
+    if (e.flags & Element::StringIsExternal) {
+        container->source = source;
+        container->elements.append(e);
+        return makeValue(e.type, 0, container);
+    }
+
     // create a new container for the returned value, containing the byte data
     // from this element, if it's worth it
     Q_ASSERT(e.flags & Element::HasByteData);
     auto b = byteData(e);
-    auto container = new QCborContainerPrivate;
 
     if (b->len + qsizetype(sizeof(*b)) < data.size() / 4) {
         // make a shallow copy of the byte data
@@ -1120,6 +1141,18 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
         return compareContainer(e1.flags & Element::IsContainer ? e1.container : nullptr,
                                 e2.flags & Element::IsContainer ? e2.container : nullptr);
 
+    // text referring to a JSON source: compare a copy of it
+    if (e1.flags & Element::StringIsExternal) {
+        QExplicitlySharedDataPointer<QCborContainerPrivate> copy(new QCborContainerPrivate);
+        copy->append(c1->externalString(e1));
+        return compareElementRecursive(copy.data(), copy->elements.at(0), c2, e2);
+    }
+    if (e2.flags & Element::StringIsExternal) {
+        QExplicitlySharedDataPointer<QCborContainerPrivate> copy(new QCborContainerPrivate);
+        copy->append(c2->externalString(e2));
+        return compareElementRecursive(c1, e1, copy.data(), copy->elements.at(0));
+    }
+
     // string data?
     const ByteData *b1 = c1 ? c1->byteData(e1) : nullptr;
     const ByteData *b2 = c2 ? c2->byteData(e2) : nullptr;
@@ -1378,6 +1411,12 @@ static void encodeToCbor(QCborStreamWriter &writer, const QCborContainerPrivate
             return writer.appendByteString("", 0);
 
         case QCborValue::String:
+            if (e.flags & Element::StringIsExternal) {
+                if (e.flags & Element::StringHasEscapes)
+                    return writer.append(d->externalString(e));
+                const QByteArrayView utf8 = d->externalData(e);
+                return writer.appendTextString(utf8.data(), utf8.size());
+            }
             if (b) {
                 if (e.flags & Element::StringIsUtf16)
                     return writer.append(b->asStringView());
@@ -36,7 +36,9 @@ struct Element
         IsContainer                 = 0x0001,
         HasByteData                 = 0x0002,
         StringIsUtf16               = 0x0004,
-        StringIsAscii               = 0x0008
+        StringIsAscii               = 0x0008,
+        StringIsExternal            = 0x0010,   // UTF-8 in QCborContainerPrivate::source
+        StringHasEscapes            = 0x0020    // ... with JSON escape sequences
     };
     Q_DECLARE_FLAGS(ValueFlags, ValueFlag)
 
@@ -86,6 +88,17 @@ struct ByteData
 };
 static_assert(std::is_trivial<ByteData>::value);
 static_assert(std::is_standard_layout<ByteData>::value);
+
+// Open-addressing hash table of the keys of a JSON object; see qjsonobject.cpp
+struct KeyIndex
+{
+    struct Slot
+    {
+        quint32 hash;
+        quint32 pair;           // one-based index of the key, 0 if the slot is free
+    };
+    QList<Slot> table;          // the size is a power of two
+};
 } // namespace QtCbor
 
 Q_DECLARE_TYPEINFO(QtCbor::Element, Q_PRIMITIVE_TYPE);
@@ -102,7 +115,30 @@ public:
     QByteArray data;
     QList<QtCbor::Element> elements;
 
+    // The JSON text that StringIsExternal elements refer to, instead of
+    // having their contents in data; see QJsonDocument::fromJsonView(). Their
+    // value holds the offset in the low bits and the length in the high bits.
+    QByteArray source;
+    static constexpr int ExternalLengthShift = 40;
+    static constexpr qint64 MaxExternalOffset = (Q_INT64_C(1) << ExternalLengthShift) - 1;
+    static constexpr qint64 MaxExternalLength = (Q_INT64_C(1) << (63 - ExternalLengthShift)) - 1;
+
+    // Hash index of the keys, which QJsonObject builds for large objects that
+    // are searched often. Lookups may build it concurrently on a shared
+    // container, so it's published atomically. Any change of the keys drops
+    // it, which only happens after detaching; clones start without one.
+    QAtomicPointer<QtCbor::KeyIndex> keyIndex = nullptr;
+    QAtomicInt keyLookups = 0;          // since the keys last changed
+
     void deref() { if (!ref.deref()) delete this; }
+    void dropKeyIndex()
+    {
+        if (Q_LIKELY(!keyIndex.loadRelaxed() && !keyLookups.loadRelaxed()))
+            return;
+        delete keyIndex.loadRelaxed();
+        keyIndex.storeRelaxed(nullptr);
+        keyLookups.storeRelaxed(0);
+    }
     void compact(qsizetype reserved);
     static QCborContainerPrivate *clone(QCborContainerPrivate *d, qsizetype reserved = -1);
     static QCborContainerPrivate *detach(QCborContainerPrivate *d, qsizetype reserved);
@@ -152,6 +188,16 @@ public:
         return byteData(elements.at(idx));
     }
 
+    QByteArrayView externalData(QtCbor::Element e) const
+    {
+        Q_ASSERT(e.flags & QtCbor::Element::StringIsExternal);
+        const qint64 offset = e.value & MaxExternalOffset;
+        const qsizetype len = qsizetype(e.value >> ExternalLengthShift);
+        Q_ASSERT(offset + len <= source.size());
+        return QByteArrayView(source.constData() + offset, len);
+    }
+    QString externalString(QtCbor::Element e) const;   // in qjsonparser.cpp
+
     QCborContainerPrivate *containerAt(qsizetype idx, QCborValue::Type type) const
     {
         const QtCbor::Element &e = elements.at(idx);
@@ -172,6 +218,8 @@ public:
     }
     void replaceAt(qsizetype idx, const QCborValue &value, ContainerDisposition disp = CopyContainer)
     {
+        if ((idx & 1) == 0)
+            dropKeyIndex();
         QtCbor::Element &e = elements[idx];
         if (e.flags & QtCbor::Element::IsContainer) {
             e.container->deref();
@@ -184,6 +232,7 @@ public:
     }
     void insertAt(qsizetype idx, const QCborValue &value, ContainerDisposition disp = CopyContainer)
     {
+        dropKeyIndex();
         replaceAt_internal(*elements.insert(elements.begin() + int(idx), {}), value, disp);
     }
 
@@ -254,6 +303,8 @@ public:
     QString stringAt(qsizetype idx) const
     {
         const auto &e = elements.at(idx);
+        if (e.flags & QtCbor::Element::StringIsExternal)
+            return externalString(e);
         const auto data = byteData(e);
         if (!data)
             return QString();
@@ -290,7 +341,7 @@ public:
                 return makeValue(QCborValue::Invalid, 0, nullptr);
             }
             return makeValue(e.type, -1, e.container);
-        } else if (e.flags & QtCbor::Element::HasByteData) {
+        } else if (e.flags & (QtCbor::Element::HasByteData | QtCbor::Element::StringIsExternal)) {
             return makeValue(e.type, idx, const_cast<QCborContainerPrivate *>(this));
         }
         return makeValue(e.type, e.value);
@@ -308,7 +359,7 @@ public:
                 return makeValue(QCborValue::Invalid, 0, nullptr);
             }
             return makeValue(e.type, -1, e.container, MoveContainer);
-        } else if (e.flags & QtCbor::Element::HasByteData) {
+        } else if (e.flags & (QtCbor::Element::HasByteData | QtCbor::Element::StringIsExternal)) {
             return extractAt_complex(e);
         }
         return makeValue(e.type, e.value);
@@ -345,6 +396,12 @@ public:
         if (e.type != QCborValue::String)
             return int(e.type) - int(QCborValue::String);
 
+        if (e.flags & QtCbor::Element::StringIsExternal) {
+            if (e.flags & QtCbor::Element::StringHasEscapes)
+                return QtPrivate::compareStrings(QStringView(externalString(e)), s);
+            return QUtf8::compareUtf8(externalData(e), s);
+        }
+
         const QtCbor::ByteData *b = byteData(e);
         if (!b)
             return s.isEmpty() ? 0 : -1;
@@ -377,6 +434,7 @@ public:
 
     void removeAt(qsizetype idx)
     {
+        dropKeyIndex();
         replaceAt(idx, {});
         elements.remove(idx);
     }
@@ -427,6 +485,7 @@ public:
         Q_ASSERT((container->elements.size() & 1) == 0);
 
         if (index >= size) {
+            container->dropKeyIndex();
             container->append(key);
             container->append(QCborValue());
         }
@@ -212,6 +212,8 @@ public:
     static QJsonArray toJsonArray(const QVariantList &list);
 };
 
+void sortObject(QCborContainerPrivate *container);
+
 } // namespace QJsonPrivate
 
 QT_END_NAMESPACE
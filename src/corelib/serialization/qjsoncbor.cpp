@@ -217,12 +217,19 @@ static QJsonArray convertToJsonArray(QCborContainerPrivate *d,
 static QJsonObject convertToJsonObject(QCborContainerPrivate *d,
                                        ConversionMode mode = ConversionMode::FromRaw)
 {
-    QJsonObject o;
-    if (d) {
-        for (qsizetype idx = 0; idx < d->elements.size(); idx += 2)
-            o.insert(makeString(d, idx), qt_convertToJson(d, idx + 1, mode));
+    if (!d || d->elements.isEmpty())
+        return QJsonObject();
+
+    QExplicitlySharedDataPointer o(new QCborContainerPrivate);
+    o->elements.reserve(d->elements.size());
+    for (qsizetype idx = 0; idx < d->elements.size(); idx += 2) {
+        o->append(makeString(d, idx));
+        o->append(QCborValue::fromJsonValue(qt_convertToJson(d, idx + 1, mode)));
     }
-    return o;
+    QJsonPrivate::sortObject(o.data());
+    const QCborValue map = QCborContainerPrivate::makeValue(QCborValue::Map, -1, o.take(),
+                                                             QCborContainerPrivate::MoveContainer);
+    return QJsonPrivate::Value::fromTrustedCbor(map).toObject();
 }
 
 QJsonValue qt_convertToJson(QCborContainerPrivate *d, qsizetype idx, ConversionMode mode)
@@ -291,6 +291,40 @@ QJsonDocument QJsonDocument::fromJson(const QByteArray &json, QJsonParseError *e
     return result;
 }
 
+/*!
+    \since 6.7
+
+    Parses \a json as a UTF-8 encoded JSON document like fromJson(), but
+    without copying the strings out of \a json: the returned document refers
+    to them in a shared copy of \a json. Strings that contain escape sequences
+    are only decoded when accessed, except for the keys of objects. This can
+    reduce the memory used by large documents considerably, especially
+    string-heavy ones that are read only in part.
+
+    The document behaves the same as one returned by fromJson(), including
+    when modified. Since every array, object or string obtained from the
+    document keeps \a json alive, prefer fromJson() when small parts of a
+    large document outlive the rest of it.
+
+    If \a json was created with QByteArray::fromRawData(), the data it points
+    to must remain valid as long as the document or any value from it exists.
+
+    Returns a null document and sets \a error if parsing fails.
+
+    \sa fromJson()
+*/
+QJsonDocument QJsonDocument::fromJsonView(const QByteArray &json, QJsonParseError *error)
+{
+    QJsonPrivate::Parser parser(json);
+    QJsonDocument result;
+    const QCborValue val = parser.parse(error);
+    if (val.isArray() || val.isMap()) {
+        result.d = std::make_unique<QJsonDocumentPrivate>();
+        result.d->value = val;
+    }
+    return result;
+}
+
 /*!
     Returns \c true if the document doesn't contain any data.
  */
@@ -79,6 +79,7 @@ public:
     };
 
     static QJsonDocument fromJson(const QByteArray &json, QJsonParseError *error = nullptr);
+    static QJsonDocument fromJsonView(const QByteArray &json, QJsonParseError *error = nullptr);
 
 #if !defined(QT_JSON_READONLY) || defined(Q_QDOC)
     QByteArray toJson(JsonFormat format = Indented) const;
@@ -11,12 +11,15 @@
 #include <qcbormap.h>
 #include <qmap.h>
 #include <qhash.h>
+#include <qvarlengtharray.h>
 
 #include <private/qcborvalue_p.h>
+#include <private/qstringconverter_p.h>
 #include "qjsonwriter_p.h"
 #include "qjson_p.h"
 
 #include <algorithm>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -113,8 +116,15 @@ QJsonObject::~QJsonObject() = default;
 
 QJsonObject::QJsonObject(std::initializer_list<QPair<QString, QJsonValue> > args)
 {
-    for (const auto &arg : args)
-        insert(arg.first, arg.second);
+    if (args.size() == 0)
+        return;
+    o.reset(new QCborContainerPrivate);
+    o->elements.reserve(2 * qsizetype(args.size()));
+    for (const auto &arg : args) {
+        o->append(arg.first);
+        o->append(QCborValue::fromJsonValue(arg.second));
+    }
+    QJsonPrivate::sortObject(o.data());
 }
 
 /*!
@@ -199,12 +209,18 @@ QVariantMap QJsonObject::toVariantMap() const
  */
 QJsonObject QJsonObject::fromVariantHash(const QVariantHash &hash)
 {
-    // ### this is implemented the trivial way, not the most efficient way
-
-    QJsonObject object;
-    for (QVariantHash::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it)
-        object.insert(it.key(), QJsonValue::fromVariant(it.value()));
-    return object;
+    if (hash.isEmpty())
+        return QJsonObject();
+
+    // append in hash order and sort once, instead of inserting one by one
+    auto d = new QCborContainerPrivate;
+    d->elements.reserve(2 * hash.size());
+    for (QVariantHash::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        d->append(it.key());
+        d->append(QCborValue::fromJsonValue(QJsonValue::fromVariant(it.value())));
+    }
+    QJsonPrivate::sortObject(d);
+    return QJsonObject(d);
 }
 
 /*!
@@ -254,9 +270,99 @@ bool QJsonObject::isEmpty() const
     return !o || o->elements.isEmpty();
 }
 
+// Objects with at least this many keys get a hash index of their keys, once
+// they have been searched for about one key in eight without changes in
+// between. Building it then pays off, while loops that insert new keys
+// never build it.
+static constexpr qsizetype MinIndexedKeys = 32;
+
+// Stored keys hash the same regardless of their encoding.
+static size_t keyHash(QStringView key)
+{
+    return qHash(key, QHashSeed::globalSeed());
+}
+
+static size_t keyHash(QLatin1StringView key)
+{
+    QVarLengthArray<QChar, 64> buffer(key.size());
+    QLatin1::convertToUnicode(buffer.data(), key);
+    return keyHash(QStringView(buffer.data(), buffer.size()));
+}
+
+static size_t keyHash(QByteArrayView utf8)
+{
+    QVarLengthArray<QChar, 64> buffer(utf8.size());
+    const QChar *end = QUtf8::convertToUnicode(buffer.data(), utf8);
+    return keyHash(QStringView(buffer.data(), end));
+}
+
+static size_t keyHash(const QCborContainerPrivate *o, const QtCbor::Element &e)
+{
+    if (e.flags & QtCbor::Element::StringIsExternal) {
+        if (e.flags & QtCbor::Element::StringHasEscapes)
+            return keyHash(QStringView(o->externalString(e)));
+        return keyHash(o->externalData(e));
+    }
+    const QtCbor::ByteData *b = o->byteData(e);
+    if (!b)
+        return keyHash(QStringView());
+    if (e.flags & QtCbor::Element::StringIsUtf16)
+        return keyHash(b->asStringView());
+    if (e.flags & QtCbor::Element::StringIsAscii)
+        return keyHash(b->asLatin1());
+    return keyHash(QByteArrayView(b->byte(), b->len));
+}
+
+static QtCbor::KeyIndex *buildKeyIndex(const QCborContainerPrivate *o)
+{
+    const qsizetype keys = o->elements.size() / 2;
+    auto index = new QtCbor::KeyIndex;
+    index->table.resize(qNextPowerOfTwo(quint64(keys) * 2));
+    const size_t mask = size_t(index->table.size() - 1);
+    for (qsizetype i = 0; i < keys; ++i) {
+        const size_t hash = keyHash(o, o->elements.at(2 * i));
+        size_t slot = hash & mask;
+        while (index->table.at(slot).pair)
+            slot = (slot + 1) & mask;
+        index->table[slot] = { quint32(hash), quint32(i + 1) };
+    }
+    return index;
+}
+
+// Returns the position of \a key in \a o, -1 if \a o doesn't have the key,
+// or -2 if it has no key index to tell.
 template<typename String>
-static qsizetype indexOf(const QExplicitlySharedDataPointer<QCborContainerPrivate> &o,
-                         String key, bool *keyExists)
+static qsizetype indexedKey(QCborContainerPrivate *o, String key)
+{
+    const qsizetype keys = o->elements.size() / 2;
+    if (keys < MinIndexedKeys || keys >= qsizetype(std::numeric_limits<quint32>::max()))
+        return -2;
+
+    QtCbor::KeyIndex *index = o->keyIndex.loadAcquire();
+    if (!index) {
+        if (o->keyLookups.fetchAndAddRelaxed(1) < keys / 8)
+            return -2;
+        QtCbor::KeyIndex *built = buildKeyIndex(o);
+        if (o->keyIndex.testAndSetOrdered(nullptr, built, index))
+            index = built;
+        else
+            delete built;       // another thread was faster
+    }
+
+    const size_t hash = keyHash(key);
+    const size_t mask = size_t(index->table.size() - 1);
+    for (size_t slot = hash & mask; index->table.at(slot).pair; slot = (slot + 1) & mask) {
+        const QtCbor::KeyIndex::Slot &s = index->table.at(slot);
+        const qsizetype pos = 2 * (qsizetype(s.pair) - 1);
+        if (s.hash == quint32(hash) && o->stringEqualsElement(pos, key))
+            return pos;
+    }
+    return -1;
+}
+
+template<typename String>
+static qsizetype lowerBound(const QExplicitlySharedDataPointer<QCborContainerPrivate> &o,
+                            String key, bool *keyExists)
 {
     const auto begin = QJsonPrivate::ConstKeyIterator(o->elements.constBegin());
     const auto end = QJsonPrivate::ConstKeyIterator(o->elements.constEnd());
@@ -271,6 +377,30 @@ static qsizetype indexOf(const QExplicitlySharedDataPointer<QCborContainerPrivat
     return it.it - begin.it;
 }
 
+// Returns the position of \a key in \a o, or of where to insert it.
+template<typename String>
+static qsizetype indexOf(const QExplicitlySharedDataPointer<QCborContainerPrivate> &o,
+                         String key, bool *keyExists)
+{
+    if (const qsizetype pos = indexedKey(o.data(), key); pos >= 0) {
+        *keyExists = true;
+        return pos;
+    }
+    return lowerBound(o, key, keyExists);
+}
+
+// Returns the position of \a key in \a o, or -1 if \a o doesn't have the key.
+template<typename String>
+static qsizetype findKey(const QExplicitlySharedDataPointer<QCborContainerPrivate> &o,
+                         String key)
+{
+    if (const qsizetype pos = indexedKey(o.data(), key); pos != -2)
+        return pos;
+    bool keyExists;
+    const qsizetype pos = lowerBound(o, key, &keyExists);
+    return keyExists ? pos : -1;
+}
+
 /*!
     Returns a QJsonValue representing the value for the key \a key.
 
@@ -310,9 +440,8 @@ QJsonValue QJsonObject::valueImpl(T key) const
     if (!o)
         return QJsonValue(QJsonValue::Undefined);
 
-    bool keyExists;
-    auto i = indexOf(o, key, &keyExists);
-    if (!keyExists)
+    const qsizetype i = findKey(o, key);
+    if (i < 0)
         return QJsonValue(QJsonValue::Undefined);
     return QJsonPrivate::Value::fromTrustedCbor(o->valueAt(i + 1));
 }
@@ -509,9 +638,8 @@ void QJsonObject::removeImpl(T key)
     if (!o)
         return;
 
-    bool keyExists;
-    auto index = indexOf(o, key, &keyExists);
-    if (!keyExists)
+    const qsizetype index = findKey(o, key);
+    if (index < 0)
         return;
 
     removeAt(index);
@@ -558,9 +686,8 @@ QJsonValue QJsonObject::takeImpl(T key)
     if (!o)
         return QJsonValue(QJsonValue::Undefined);
 
-    bool keyExists;
-    auto index = indexOf(o, key, &keyExists);
-    if (!keyExists)
+    const qsizetype index = findKey(o, key);
+    if (index < 0)
         return QJsonValue(QJsonValue::Undefined);
 
     detach();
@@ -606,9 +733,7 @@ bool QJsonObject::containsImpl(T key) const
     if (!o)
         return false;
 
-    bool keyExists;
-    indexOf(o, key, &keyExists);
-    return keyExists;
+    return findKey(o, key) >= 0;
 }
 
 /*!
@@ -695,9 +820,8 @@ QJsonObject::iterator QJsonObject::find(QLatin1StringView key)
 template <typename T>
 QJsonObject::iterator QJsonObject::findImpl(T key)
 {
-    bool keyExists = false;
-    auto index = o ? indexOf(o, key, &keyExists) : 0;
-    if (!keyExists)
+    const qsizetype index = o ? findKey(o, key) : -1;
+    if (index < 0)
         return end();
     detach();
     return {this, index / 2};
@@ -756,9 +880,8 @@ QJsonObject::const_iterator QJsonObject::constFind(QLatin1StringView key) const
 template <typename T>
 QJsonObject::const_iterator QJsonObject::constFindImpl(T key) const
 {
-    bool keyExists = false;
-    auto index = o ? indexOf(o, key, &keyExists) : 0;
-    if (!keyExists)
+    const qsizetype index = o ? findKey(o, key) : -1;
+    if (index < 0)
         return end();
     return {this, index / 2};
 }
@@ -11,6 +11,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 #include <private/qtools_p.h>
 
 //#define PARSER_DEBUG
@@ -190,7 +191,7 @@ private:
     QExplicitlySharedDataPointer<QCborContainerPrivate> *current;
 };
 
-Parser::Parser(const char *json, int length)
+Parser::Parser(const char *json, qsizetype length)
     : head(json), json(json)
     , nestingLevel(0)
     , lastError(QJsonParseError::NoError)
@@ -198,6 +199,26 @@ Parser::Parser(const char *json, int length)
     end = json + length;
 }
 
+/*!
+    \internal
+
+    Creates a parser whose result refers to the strings in \a source instead
+    of copying them. Strings with escape sequences are decoded on access,
+    except for object keys.
+*/
+Parser::Parser(const QByteArray &source)
+    : Parser(source.constData(), source.size())
+{
+    this->source = source;
+}
+
+QCborContainerPrivate *Parser::newContainer() const
+{
+    auto d = new QCborContainerPrivate;
+    d->source = source;
+    return d;
+}
+
 
 
 /*
@@ -303,13 +324,13 @@ QCborValue Parser::parse(QJsonParseError *error)
 
     DEBUG << Qt::hex << (uint)token;
     if (token == BeginArray) {
-        container = new QCborContainerPrivate;
+        container = newContainer();
         if (!parseArray())
             goto error;
         data = QCborContainerPrivate::makeValue(QCborValue::Array, -1, container.take(),
                                                 QCborContainerPrivate::MoveContainer);
     } else if (token == BeginObject) {
-        container = new QCborContainerPrivate;
+        container = newContainer();
         if (!parseObject())
             goto error;
         data = QCborContainerPrivate::makeValue(QCborValue::Map, -1, container.take(),
@@ -385,11 +406,28 @@ static void sortContainer(QCborContainerPrivate *container)
     using Forward = QJsonPrivate::KeyIterator;
     using Value = Forward::value_type;
 
-    auto compare = [container](const Value &a, const Value &b)
+    // keys never refer to text with escape sequences
+    auto keyView = [container](const QtCbor::Element &key) -> QAnyStringView {
+        if (key.flags & QtCbor::Element::StringIsExternal) {
+            const QByteArrayView text = container->externalData(key);
+            return QUtf8StringView(text.data(), text.size());
+        }
+        const QtCbor::ByteData *b = container->byteData(key);
+        if (!b)
+            return QAnyStringView();
+        if (key.flags & QtCbor::Element::StringIsUtf16)
+            return b->asStringView();
+        return b->asUtf8StringView();
+    };
+
+    auto compare = [container, &keyView](const Value &a, const Value &b)
     {
         const auto &aKey = a.key();
         const auto &bKey = b.key();
 
+        if ((aKey.flags | bKey.flags) & QtCbor::Element::StringIsExternal)
+            return QAnyStringView::compare(keyView(aKey), keyView(bKey));
+
         Q_ASSERT(aKey.flags & QtCbor::Element::HasByteData);
         Q_ASSERT(bKey.flags & QtCbor::Element::HasByteData);
 
@@ -444,6 +482,27 @@ static void sortContainer(QCborContainerPrivate *container)
     container->elements.erase(result.elementsIterator(), container->elements.end());
 }
 
+/*!
+    \internal
+
+    Sorts the members of an object whose key and value pairs were appended to
+    \a container in any order, with the same result as inserting them one by
+    one into a QJsonObject: of duplicate keys, the last one wins, and members
+    whose value is undefined are removed.
+*/
+void QJsonPrivate::sortObject(QCborContainerPrivate *container)
+{
+    Q_ASSERT(container->elements.size() % 2 == 0);
+    sortContainer(container);
+
+    for (qsizetype i = container->elements.size() - 2; i >= 0; i -= 2) {
+        if (container->elements.at(i + 1).type == QCborValue::Undefined) {
+            container->removeAt(i + 1);
+            container->removeAt(i);
+        }
+    }
+}
+
 
 /*
     object = begin-object [ member *( value-separator member ) ]
@@ -462,7 +521,7 @@ bool Parser::parseObject()
     char token = nextToken();
     while (token == Quote) {
         if (!container)
-            container = new QCborContainerPrivate;
+            container = newContainer();
         if (!parseMember())
             return false;
         token = nextToken();
@@ -497,7 +556,7 @@ bool Parser::parseMember()
 {
     BEGIN << "parseMember";
 
-    if (!parseString())
+    if (!parseString(KeyString))
         return false;
     char token = nextToken();
     if (token != NameSeparator) {
@@ -540,7 +599,7 @@ bool Parser::parseArray()
                 return false;
             }
             if (!container)
-                container = new QCborContainerPrivate;
+                container = newContainer();
             if (!parseValue())
                 return false;
             char token = nextToken();
@@ -621,7 +680,7 @@ bool Parser::parseValue()
         lastError = QJsonParseError::IllegalValue;
         return false;
     case Quote: {
-        if (!parseString())
+        if (!parseString(ValueString))
             return false;
         DEBUG << "value: string";
         END;
@@ -834,6 +893,62 @@ static inline bool scanEscapeSequence(const char *&json, const char *end, char32
     return true;
 }
 
+// Returns the first character in [json, end) that can't be copied verbatim into
+// an ASCII string: a quotation mark, a backslash or a non-ASCII byte. Returns
+// end if there is none.
+static inline const char *findStringSpecial(const char *json, const char *end)
+{
+#if defined(__SSE2__)
+#  ifdef __AVX2__
+    // do 32 characters at a time
+    const __m256i quote32 = _mm256_set1_epi8(Quote);
+    const __m256i backslash32 = _mm256_set1_epi8('\\');
+    for ( ; end - json >= 32; json += 32) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(json));
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote32),
+                                                _mm256_cmpeq_epi8(data, backslash32));
+        // movemask also picks up the high bit of the non-ASCII characters
+        const uint n = uint(_mm256_movemask_epi8(_mm256_or_si256(special, data)));
+        if (n)
+            return json + qCountTrailingZeroBits(n);
+    }
+#  endif
+
+    // do sixteen characters at a time
+    const __m128i quote = _mm_set1_epi8(Quote);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for ( ; end - json >= 16; json += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                             _mm_cmpeq_epi8(data, backslash));
+        const uint n = uint(_mm_movemask_epi8(_mm_or_si128(special, data)));
+        if (n)
+            return json + qCountTrailingZeroBits(n);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    // do eight characters at a time
+    const uint8x8_t quote = vdup_n_u8(Quote);
+    const uint8x8_t backslash = vdup_n_u8('\\');
+    const uint8x8_t msb_mask = vdup_n_u8(0x80);
+    const uint8x8_t add_mask = { 1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7 };
+    for ( ; end - json >= 8; json += 8) {
+        const uint8x8_t c = vld1_u8(reinterpret_cast<const uint8_t *>(json));
+        const uint8x8_t special = vorr_u8(vorr_u8(vceq_u8(c, quote), vceq_u8(c, backslash)),
+                                          vcge_u8(c, msb_mask));
+        const uint n = vaddv_u8(vand_u8(special, add_mask));
+        if (n)
+            return json + qCountTrailingZeroBits(n);
+    }
+#endif
+
+    for ( ; json < end; ++json) {
+        const uchar c = uchar(*json);
+        if (c == Quote || c == '\\' || c >= 0x80)
+            break;
+    }
+    return json;
+}
+
 static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *result)
 {
     const auto *usrc = reinterpret_cast<const uchar *>(json);
@@ -847,7 +962,57 @@ static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *re
     return true;
 }
 
-bool Parser::parseString()
+// Scans the contents of a string with escape sequences, up to its closing
+// quotation mark, and appends them to \a out unless that is \nullptr.
+static bool scanEscapedString(const char *&json, const char *end, QString *out,
+                              QJsonParseError::ParseError *error)
+{
+    while (json < end) {
+        const char *run = json;
+        json = findStringSpecial(json, end);
+        if (out)
+            out->append(QLatin1StringView(run, json - run));
+        if (json == end)
+            break;
+
+        char32_t ch = 0;
+        if (*json == '"')
+            break;
+        else if (*json == '\\') {
+            if (!scanEscapeSequence(json, end, &ch)) {
+                *error = QJsonParseError::IllegalEscapeSequence;
+                return false;
+            }
+        } else {
+            if (!scanUtf8Char(json, end, &ch)) {
+                *error = QJsonParseError::IllegalUTF8String;
+                return false;
+            }
+        }
+        if (out)
+            out->append(QChar::fromUcs4(ch));
+    }
+    return true;
+}
+
+// Appends the string between \a begin and \a close as a reference to the
+// source text, if there is one and the string can be referenced.
+bool Parser::appendExternalString(const char *begin, const char *close,
+                                  QtCbor::Element::ValueFlags flags)
+{
+    const qint64 offset = begin - head;
+    const qint64 len = close - begin;
+    if (source.isNull() || offset > QCborContainerPrivate::MaxExternalOffset
+            || len > QCborContainerPrivate::MaxExternalLength) {
+        return false;
+    }
+    container->elements.append(
+            QtCbor::Element(offset | (len << QCborContainerPrivate::ExternalLengthShift),
+                            QCborValue::String, QtCbor::Element::StringIsExternal | flags));
+    return true;
+}
+
+bool Parser::parseString(StringKind kind)
 {
     const char *start = json;
 
@@ -857,6 +1022,11 @@ bool Parser::parseString()
     bool isUtf8 = true;
     bool isAscii = true;
     while (json < end) {
+        // skip over the plain ASCII characters in bulk
+        json = findStringSpecial(json, end);
+        if (json == end)
+            break;
+
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -872,9 +1042,8 @@ bool Parser::parseString()
             lastError = QJsonParseError::IllegalUTF8String;
             return false;
         }
-        if (ch > 0x7f)
-            isAscii = false;
-        DEBUG << "  " << ch << char(ch);
+        isAscii = false;
+        DEBUG << "  " << ch;
     }
     ++json;
     DEBUG << "end of string";
@@ -885,10 +1054,14 @@ bool Parser::parseString()
 
     // no escape sequences, we are done
     if (isUtf8) {
-        if (isAscii)
-            container->appendAsciiString(start, json - start - 1);
-        else
-            container->appendUtf8String(start, json - start - 1);
+        const QtCbor::Element::ValueFlags flags = isAscii ? QtCbor::Element::StringIsAscii
+                                                          : QtCbor::Element::ValueFlags();
+        if (!appendExternalString(start, json - 1, flags)) {
+            if (isAscii)
+                container->appendAsciiString(start, json - start - 1);
+            else
+                container->appendUtf8String(start, json - start - 1);
+        }
         END;
         return true;
     }
@@ -897,24 +1070,25 @@ bool Parser::parseString()
 
     json = start;
 
-    QString ucs4;
-    while (json < end) {
-        char32_t ch = 0;
-        if (*json == '"')
-            break;
-        else if (*json == '\\') {
-            if (!scanEscapeSequence(json, end, &ch)) {
-                lastError = QJsonParseError::IllegalEscapeSequence;
-                return false;
-            }
-        } else {
-            if (!scanUtf8Char(json, end, &ch)) {
-                lastError = QJsonParseError::IllegalUTF8String;
-                return false;
-            }
+    // keys are looked up often, so only values are decoded on access
+    if (kind == ValueString && !source.isNull()) {
+        if (!scanEscapedString(json, end, nullptr, &lastError))
+            return false;
+        ++json;
+        if (json >= end) {
+            lastError = QJsonParseError::UnterminatedString;
+            return false;
+        }
+        if (appendExternalString(start, json - 1, QtCbor::Element::StringHasEscapes)) {
+            END;
+            return true;
         }
-        ucs4.append(QChar::fromUcs4(ch));
+        json = start;
     }
+
+    QString ucs4;
+    if (!scanEscapedString(json, end, &ucs4, &lastError))
+        return false;
     ++json;
 
     if (json >= end) {
@@ -928,4 +1102,26 @@ bool Parser::parseString()
     return true;
 }
 
+/*!
+    \internal
+
+    Returns the string of the StringIsExternal element \a e, which the parser
+    has validated.
+*/
+QString QCborContainerPrivate::externalString(QtCbor::Element e) const
+{
+    const QByteArrayView text = externalData(e);
+    if (e.flags & QtCbor::Element::StringIsAscii)
+        return QString::fromLatin1(text);
+    if (!(e.flags & QtCbor::Element::StringHasEscapes))
+        return QString::fromUtf8(text);
+
+    QString result;
+    result.reserve(text.size());
+    const char *json = text.data();
+    QJsonParseError::ParseError error;
+    scanEscapedString(json, text.data() + text.size(), &result, &error);
+    return result;
+}
+
 QT_END_NAMESPACE
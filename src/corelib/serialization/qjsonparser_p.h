@@ -26,11 +26,18 @@ namespace QJsonPrivate {
 class Parser
 {
 public:
-    Parser(const char *json, int length);
+    Parser(const char *json, qsizetype length);
+    explicit Parser(const QByteArray &source);
 
     QCborValue parse(QJsonParseError *error);
 
 private:
+    enum StringKind { KeyString, ValueString };
+
+    QCborContainerPrivate *newContainer() const;
+    bool appendExternalString(const char *begin, const char *close,
+                              QtCbor::Element::ValueFlags flags);
+
     inline void eatBOM();
     inline bool eatSpace();
     inline char nextToken();
@@ -38,7 +45,7 @@ private:
     bool parseObject();
     bool parseArray();
     bool parseMember();
-    bool parseString();
+    bool parseString(StringKind kind);
     bool parseValue();
     bool parseNumber();
     const char *head;
@@ -48,6 +55,7 @@ private:
     int nestingLevel;
     QJsonParseError::ParseError lastError;
     QExplicitlySharedDataPointer<QCborContainerPrivate> container;
+    QByteArray source;
 };
 
 }
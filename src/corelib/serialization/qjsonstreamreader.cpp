@@ -0,0 +1,788 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamreader.h"
+
+#include <qcoreapplication.h>
+#include <qiodevice.h>
+#include <qjsondocument.h>
+#include <qmetaobject.h>
+#include <qvarlengtharray.h>
+
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+#include <private/qtools_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+using namespace QtMiscUtils;
+
+namespace {
+// how much is read from the device at a time
+constexpr qsizetype ChunkSize = 16 * 1024;
+// same as QJsonDocument::fromJson()
+constexpr int NestingLimit = 1024;
+}
+
+class QJsonStreamReaderPrivate
+{
+public:
+    using TokenType = QJsonStreamReader::TokenType;
+
+    // what the next token may be
+    enum State : quint8 {
+        DocumentStart,      // a top-level array or object
+        ValueOrEndArray,    // after '['
+        NameOrEndObject,    // after '{'
+        MemberName,         // after ',' in an object
+        NameSeparator,      // after a member name
+        Value,              // after ',' in an array, or after ':'
+        SeparatorOrEnd      // after a value inside an array or object
+    };
+
+    enum Step : quint8 {
+        Done,
+        Incomplete,         // the buffer ends in the middle of the token
+        Failed
+    };
+
+    TokenType readNext();
+    Step scan();
+    bool fetchMore(qsizetype needed);
+    void compact();
+    bool skipSpace();
+
+    Step beginContainer(bool isObject);
+    Step endContainer();
+    Step readName();
+    Step readValue();
+    Step readString();
+    Step readNumber();
+    Step readLiteral(QLatin1StringView literal, TokenType type);
+    Step fail(QJsonParseError::ParseError code);
+
+    const char *current() const { return buffer.constData() + pos; }
+    const char *bufferEnd() const { return buffer.constData() + buffer.size(); }
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;              // of the next unread byte in buffer
+    qint64 bufferOffset = 0;        // stream offset of buffer[0]
+    QVarLengthArray<bool, 32> containers;   // open containers, true for objects
+
+    State state = DocumentStart;
+    TokenType token = QJsonStreamReader::NoToken;
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QJsonParseError::ParseError parseError = QJsonParseError::NoError;
+    bool exhausted = false;
+
+    QString text;
+    qint64 integer = 0;
+    double number = 0;
+    bool boolean = false;
+};
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readNext()
+{
+    if (error == QJsonStreamReader::NotWellFormedError)
+        return token;
+
+    // a premature end is recoverable: try again with whatever arrived since
+    error = QJsonStreamReader::NoError;
+    exhausted = false;
+    text.clear();
+    compact();
+
+    qsizetype scanned = 0;
+    for (;;) {
+        const qsizetype start = pos;
+        switch (scan()) {
+        case Done:
+            return token;
+        case Failed:
+            error = QJsonStreamReader::NotWellFormedError;
+            return token = QJsonStreamReader::Invalid;
+        case Incomplete:
+            break;
+        }
+
+        // Read at least as much as we had to look at, so that a token much
+        // larger than a chunk isn't rescanned once per chunk.
+        scanned += buffer.size() - start;
+        if (!fetchMore(scanned))
+            break;
+    }
+
+    exhausted = true;
+    if (state == DocumentStart)
+        return token = QJsonStreamReader::NoToken;
+    error = QJsonStreamReader::PrematureEndOfDocumentError;
+    return token = QJsonStreamReader::Invalid;
+}
+
+// Tries to read the next token from the buffer. Only tokens are consumed, a
+// partial token at the end of the buffer is left for the next attempt.
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::scan()
+{
+    for (;;) {
+        if (!skipSpace())
+            return Incomplete;
+
+        const char c = buffer.at(pos);
+        switch (state) {
+        case DocumentStart:
+            if (bufferOffset + pos == 0 && uchar(c) == 0xef) {
+                // UTF-8 byte order mark
+                if (buffer.size() < 3)
+                    return Incomplete;
+                if (uchar(buffer.at(1)) == 0xbb && uchar(buffer.at(2)) == 0xbf) {
+                    pos = 3;
+                    continue;
+                }
+            }
+            if (c == '[' || c == '{')
+                return beginContainer(c == '{');
+            return fail(QJsonParseError::IllegalValue);
+
+        case ValueOrEndArray:
+            if (c == ']')
+                return endContainer();
+            return readValue();
+
+        case NameOrEndObject:
+            if (c == '}')
+                return endContainer();
+            if (c != '"')
+                return fail(QJsonParseError::UnterminatedObject);
+            return readName();
+
+        case MemberName:
+            if (c == '}')
+                return fail(QJsonParseError::MissingObject);
+            if (c != '"')
+                return fail(QJsonParseError::UnterminatedObject);
+            return readName();
+
+        case NameSeparator:
+            if (c != ':')
+                return fail(QJsonParseError::MissingNameSeparator);
+            ++pos;
+            state = Value;
+            continue;
+
+        case Value:
+            return readValue();
+
+        case SeparatorOrEnd: {
+            const bool inObject = containers.last();
+            if (c == ',') {
+                ++pos;
+                state = inObject ? MemberName : Value;
+                continue;
+            }
+            if (c == (inObject ? '}' : ']'))
+                return endContainer();
+            return fail(inObject ? QJsonParseError::UnterminatedObject
+                                 : QJsonParseError::MissingValueSeparator);
+        }
+        }
+        Q_UNREACHABLE_RETURN(Failed);
+    }
+}
+
+bool QJsonStreamReaderPrivate::fetchMore(qsizetype needed)
+{
+    if (!device)
+        return false;
+    const qsizetype size = buffer.size();
+    const qsizetype wanted = qMax(ChunkSize, needed);
+    buffer.resize(size + wanted);
+    const qint64 read = device->read(buffer.data() + size, wanted);
+    buffer.resize(size + qMax(read, qint64(0)));
+    return read > 0;
+}
+
+// Drops consumed data from the buffer. Moving the remaining data is only done
+// once it's no more than what was consumed, so that every byte is moved a
+// bounded number of times.
+void QJsonStreamReaderPrivate::compact()
+{
+    if (pos == 0)
+        return;
+    if (pos < buffer.size() && (pos < ChunkSize || pos < buffer.size() - pos))
+        return;
+    buffer.remove(0, pos);
+    bufferOffset += pos;
+    pos = 0;
+}
+
+// Skips whitespace; returns false if the buffer has no more data after it.
+bool QJsonStreamReaderPrivate::skipSpace()
+{
+    const char *json = current();
+    const char *end = bufferEnd();
+    while (json < end && (*json == ' ' || *json == '\t' || *json == '\n' || *json == '\r'))
+        ++json;
+    pos = json - buffer.constData();
+    return json < end;
+}
+
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::beginContainer(bool isObject)
+{
+    if (containers.size() >= NestingLimit)
+        return fail(QJsonParseError::DeepNesting);
+    ++pos;
+    containers.append(isObject);
+    state = isObject ? NameOrEndObject : ValueOrEndArray;
+    token = isObject ? QJsonStreamReader::StartObject : QJsonStreamReader::StartArray;
+    return Done;
+}
+
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::endContainer()
+{
+    ++pos;
+    const bool isObject = containers.last();
+    containers.removeLast();
+    state = containers.isEmpty() ? DocumentStart : SeparatorOrEnd;
+    token = isObject ? QJsonStreamReader::EndObject : QJsonStreamReader::EndArray;
+    return Done;
+}
+
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::readName()
+{
+    const Step step = readString();
+    if (step == Done) {
+        state = NameSeparator;
+        token = QJsonStreamReader::Name;
+    }
+    return step;
+}
+
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::readValue()
+{
+    Step step;
+    switch (buffer.at(pos)) {
+    case '[':
+        return beginContainer(false);
+    case '{':
+        return beginContainer(true);
+    case ',':
+        return fail(QJsonParseError::IllegalValue);
+    case ']':
+    case '}':
+        return fail(QJsonParseError::MissingObject);
+    case '"':
+        step = readString();
+        token = QJsonStreamReader::String;
+        break;
+    case 'n':
+        step = readLiteral("null"_L1, QJsonStreamReader::Null);
+        break;
+    case 't':
+        step = readLiteral("true"_L1, QJsonStreamReader::Bool);
+        boolean = true;
+        break;
+    case 'f':
+        step = readLiteral("false"_L1, QJsonStreamReader::Bool);
+        boolean = false;
+        break;
+    default:
+        step = readNumber();
+        break;
+    }
+    if (step == Done)
+        state = SeparatorOrEnd;
+    return step;
+}
+
+QJsonStreamReaderPrivate::Step
+QJsonStreamReaderPrivate::readLiteral(QLatin1StringView literal, TokenType type)
+{
+    const QByteArrayView available(current(), qMin(literal.size(), buffer.size() - pos));
+    if (!QLatin1StringView(available).startsWith(literal.first(available.size())))
+        return fail(QJsonParseError::IllegalValue);
+    if (available.size() < literal.size())
+        return Incomplete;
+    pos += literal.size();
+    token = type;
+    return Done;
+}
+
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::readNumber()
+{
+    const char *start = current();
+    const char *end = bufferEnd();
+    const char *json = start;
+    bool isInt = true;
+
+    // the grammar is checked as leniently as QJsonDocument::fromJson() does
+    if (json < end && *json == '-')
+        ++json;
+    if (json < end && *json == '0') {
+        ++json;
+    } else {
+        while (json < end && isAsciiDigit(*json))
+            ++json;
+    }
+    if (json < end && *json == '.') {
+        ++json;
+        while (json < end && isAsciiDigit(*json)) {
+            isInt = isInt && *json == '0';
+            ++json;
+        }
+    }
+    if (json < end && (*json == 'e' || *json == 'E')) {
+        isInt = false;
+        ++json;
+        if (json < end && (*json == '-' || *json == '+'))
+            ++json;
+        while (json < end && isAsciiDigit(*json))
+            ++json;
+    }
+
+    // a number can't end a document, so more data must be coming
+    if (json == end)
+        return Incomplete;
+
+    const QByteArray digits = QByteArray::fromRawData(start, json - start);
+    bool ok = false;
+    if (isInt) {
+        integer = digits.toLongLong(&ok);
+        if (ok) {
+            number = double(integer);
+            token = QJsonStreamReader::Integer;
+        }
+    }
+    if (!ok) {
+        number = digits.toDouble(&ok);
+        if (!ok)
+            return fail(QJsonParseError::IllegalNumber);
+        if (convertDoubleTo(number, &integer)) {
+            token = QJsonStreamReader::Integer;
+        } else {
+            integer = qint64(number);
+            token = QJsonStreamReader::Double;
+        }
+    }
+    pos = json - buffer.constData();
+    return Done;
+}
+
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::readString()
+{
+    const char *begin = current() + 1;
+    const char *end = bufferEnd();
+
+    // find the closing quotation mark before decoding anything
+    const char *json = begin;
+    bool hasEscapes = false;
+    for (;;) {
+        while (json < end && *json != '"' && *json != '\\')
+            ++json;
+        if (json == end)
+            return Incomplete;
+        if (*json == '"')
+            break;
+        hasEscapes = true;
+        if (end - json < 2)
+            return Incomplete;
+        json += 2;
+    }
+    const char *close = json;
+
+    auto appendUtf8 = [this](const char *from, const char *to) {
+        const QByteArrayView run(from, to);
+        if (!QUtf8::isValidUtf8(run).isValidUtf8) {
+            pos = from - buffer.constData();
+            return false;
+        }
+        text.append(QUtf8StringView(run));
+        return true;
+    };
+
+    text.clear();
+    if (!hasEscapes) {
+        if (!appendUtf8(begin, close))
+            return fail(QJsonParseError::IllegalUTF8String);
+    } else {
+        text.reserve(close - begin);
+        json = begin;
+        while (json < close) {
+            const char *run = json;
+            while (json < close && *json != '\\')
+                ++json;
+            if (!appendUtf8(run, json))
+                return fail(QJsonParseError::IllegalUTF8String);
+            if (json == close)
+                break;
+
+            ++json;
+            const char escaped = *json++;
+            switch (escaped) {
+            case 'b':
+                text.append(u'\b');
+                break;
+            case 'f':
+                text.append(u'\f');
+                break;
+            case 'n':
+                text.append(u'\n');
+                break;
+            case 'r':
+                text.append(u'\r');
+                break;
+            case 't':
+                text.append(u'\t');
+                break;
+            case 'u': {
+                char16_t ch = 0;
+                for (int i = 0; i < 4; ++i, ++json) {
+                    const int digit = json < close ? fromHex(*json) : -1;
+                    if (digit < 0) {
+                        pos = json - buffer.constData();
+                        return fail(QJsonParseError::IllegalEscapeSequence);
+                    }
+                    ch = (ch << 4) | digit;
+                }
+                text.append(QChar(ch));
+                break;
+            }
+            default:
+                // like QJsonDocument::fromJson(), take unknown escapes literally
+                text.append(QLatin1Char(escaped));
+                break;
+            }
+        }
+    }
+
+    pos = close + 1 - buffer.constData();
+    return Done;
+}
+
+QJsonStreamReaderPrivate::Step QJsonStreamReaderPrivate::fail(QJsonParseError::ParseError code)
+{
+    parseError = code;
+    return Failed;
+}
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.7
+
+    \brief The QJsonStreamReader class is a fast, incremental reader for JSON
+    text.
+
+    QJsonStreamReader reads JSON one token at a time, without building a
+    QJsonDocument. Only the token being read is kept in memory, so it can
+    process documents of any size in constant memory, and it can start
+    processing a document before all of it has arrived.
+
+    The reader is fed either from a QIODevice, set with setDevice(), or with
+    data chunks passed to addData(). Each call to readNext() reads the next
+    token and returns its type:
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 0
+
+    When the data ends in the middle of a document, readNext() returns
+    \l Invalid and error() returns \l PrematureEndOfDocumentError. This is
+    not fatal: once more data is available, either because the device has
+    received it (for example, after QIODevice::readyRead() on a socket) or
+    because it was passed to addData(), the next call to readNext()
+    continues where the reader left off.
+
+    Like QJsonDocument::fromJson(), the reader requires each document to be
+    an array or an object. Several documents may follow one another,
+    separated by optional whitespace, which makes QJsonStreamReader suitable
+    for newline-delimited JSON. When there is no more data between two
+    documents, readNext() returns \l NoToken and sets no error.
+
+    The reader reports syntax errors the way QJsonDocument::fromJson() does;
+    after one, error() returns \l NotWellFormedError and readNext() keeps
+    returning \l Invalid until clear() is called. Members of an object are
+    reported in the order they appear in the text, including duplicate
+    names.
+
+    \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of the token that the reader just read.
+
+    \value NoToken          Nothing was read yet, or the data ended between two documents.
+    \value Invalid          An error occurred, see error() and errorString().
+    \value StartArray       The start of an array.
+    \value EndArray         The end of an array.
+    \value StartObject      The start of an object.
+    \value EndObject        The end of an object.
+    \value Name             The name of an object member, see text(). The
+                            next token is the member's value.
+    \value String           A string, see text().
+    \value Integer          A number that is an integer and fits into a
+                            qint64, see toInteger().
+    \value Double           Any other number, see toDouble().
+    \value Bool             \c true or \c false, see toBool().
+    \value Null             \c null.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the error that the reader ran into.
+
+    \value NoError          No error has occurred.
+    \value PrematureEndOfDocumentError
+                            The data ended before the document did. Reading
+                            resumes when more data is available.
+    \value NotWellFormedError
+                            The data is not valid JSON. See errorString()
+                            for details.
+*/
+
+/*!
+    Constructs a stream reader without data. Use setDevice() or addData() to
+    provide some.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a stream reader that reads from \a device.
+
+    \sa setDevice()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a stream reader that reads from \a data.
+
+    \sa addData()
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    d->buffer = data;
+}
+
+/*!
+    Destroys the stream reader.
+*/
+QJsonStreamReader::~QJsonStreamReader() = default;
+
+/*!
+    Sets the device the reader reads from to \a device, and resets the
+    reader. The reader does not take ownership of the device.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    clear();
+    d->device = device;
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr if there is none.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Appends \a data to the data the reader reads from. Does nothing when the
+    reader reads from a device.
+
+    \sa readNext(), clear()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->compact();
+    d->buffer += data;
+    d->exhausted = false;
+}
+
+/*!
+    Discards all data and resets the reader to its initial state. The device,
+    if any, is kept.
+
+    \sa addData(), setDevice()
+*/
+void QJsonStreamReader::clear()
+{
+    QIODevice *device = d->device;
+    *d = QJsonStreamReaderPrivate();
+    d->device = device;
+}
+
+/*!
+    Returns \c true if the reader has consumed all data that was available,
+    or if an error occurred. With more data available, reading can continue
+    unless the error was \l NotWellFormedError; addData() resets this flag.
+
+    \sa readNext(), error()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    return d->exhausted || d->error == NotWellFormedError;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    \sa tokenType(), atEnd(), error()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    return d->readNext();
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa readNext(), tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->token;
+}
+
+/*!
+    Returns the name of the type of the current token.
+
+    \sa tokenType()
+*/
+QString QJsonStreamReader::tokenString() const
+{
+    return QString::fromLatin1(QMetaEnum::fromType<TokenType>().valueToKey(d->token));
+}
+
+/*!
+    Returns the number of arrays and objects the current token is nested in.
+    A \l StartArray or \l StartObject token counts as nested in the container
+    it opens, a matching end token does not.
+*/
+int QJsonStreamReader::depth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns the offset in bytes, from the start of the data, just after the
+    current token. After an error, returns the offset where the error was
+    detected.
+*/
+qint64 QJsonStreamReader::offset() const
+{
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    Returns the text of a \l Name or \l String token, with escape sequences
+    resolved. Returns an empty string for other tokens.
+*/
+QString QJsonStreamReader::text() const
+{
+    return d->text;
+}
+
+/*!
+    Returns the value of an \l Integer token. For a \l Double token, returns
+    the value truncated to an integer; otherwise returns 0.
+
+    \sa toDouble()
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    return isInteger() || isDouble() ? d->integer : 0;
+}
+
+/*!
+    Returns the value of a \l Double or an \l Integer token, or 0 for other
+    tokens.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    return isInteger() || isDouble() ? d->number : 0;
+}
+
+/*!
+    Returns the value of a \l Bool token, or \c false for other tokens.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return isBool() && d->boolean;
+}
+
+/*!
+    Returns the error of the last readNext() call.
+
+    \sa errorString(), hasError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    return d->error;
+}
+
+/*!
+    Returns a human readable description of error().
+*/
+QString QJsonStreamReader::errorString() const
+{
+    switch (d->error) {
+    case NoError:
+        break;
+    case PrematureEndOfDocumentError:
+        return QCoreApplication::translate("QJsonStreamReader", "premature end of document");
+    case NotWellFormedError: {
+        QJsonParseError parseError;
+        parseError.error = d->parseError;
+        return parseError.errorString();
+    }
+    }
+    return QCoreApplication::translate("QJsonStreamReader", "no error occurred");
+}
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if error() is not \l NoError.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isStartArray() const
+    \fn bool QJsonStreamReader::isEndArray() const
+    \fn bool QJsonStreamReader::isStartObject() const
+    \fn bool QJsonStreamReader::isEndObject() const
+    \fn bool QJsonStreamReader::isName() const
+    \fn bool QJsonStreamReader::isString() const
+    \fn bool QJsonStreamReader::isInteger() const
+    \fn bool QJsonStreamReader::isDouble() const
+    \fn bool QJsonStreamReader::isBool() const
+    \fn bool QJsonStreamReader::isNull() const
+
+    Returns \c true if tokenType() is the respective token type.
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,383 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamwriter.h"
+
+#include <qcborvalue.h>
+#include <qiodevice.h>
+#include <qjsonvalue.h>
+#include <qlocale.h>
+#include <qvarlengtharray.h>
+
+#include <private/qjsonwriter_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QJsonPrivate;
+
+namespace {
+// how much output is collected before it is written to the device
+constexpr qsizetype ChunkSize = 16 * 1024;
+}
+
+class QJsonStreamWriterPrivate
+{
+public:
+    struct Container
+    {
+        bool isObject;
+        bool isEmpty;
+    };
+
+    QByteArray &output() { return data ? *data : buffer; }
+    void beginItem();
+    void beginValue();
+    void endValue();
+    void endContainer(bool isObject);
+    void appendString(QAnyStringView s);
+    void flush();
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;                      // output not yet written to device
+    QVarLengthArray<Container, 32> containers;
+    QJsonDocument::JsonFormat format = QJsonDocument::Compact;
+    bool afterName = false;
+    bool error = false;
+};
+
+// Writes what separates a value or a member from the previous one.
+void QJsonStreamWriterPrivate::beginItem()
+{
+    if (containers.isEmpty())
+        return;
+    QByteArray &out = output();
+    Container &container = containers.last();
+    if (!container.isEmpty)
+        out += ',';
+    container.isEmpty = false;
+    if (format == QJsonDocument::Indented) {
+        out += '\n';
+        out.append(4 * containers.size(), ' ');
+    }
+}
+
+void QJsonStreamWriterPrivate::beginValue()
+{
+    Q_ASSERT_X(afterName || containers.isEmpty() || !containers.last().isObject,
+               "QJsonStreamWriter", "Object members need a name");
+    if (afterName)
+        afterName = false;
+    else
+        beginItem();
+}
+
+// Ends each document with a newline, so that a stream of them is
+// newline-delimited JSON.
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (containers.isEmpty()) {
+        output() += '\n';
+        flush();
+    } else if (buffer.size() >= ChunkSize) {
+        flush();
+    }
+}
+
+void QJsonStreamWriterPrivate::endContainer(bool isObject)
+{
+    Q_ASSERT_X(!containers.isEmpty() && containers.last().isObject == isObject && !afterName,
+               "QJsonStreamWriter", "Unbalanced end of array or object");
+    const Container container = containers.last();
+    containers.removeLast();
+    QByteArray &out = output();
+    if (format == QJsonDocument::Indented && !container.isEmpty) {
+        out += '\n';
+        out.append(4 * containers.size(), ' ');
+    }
+    out += isObject ? '}' : ']';
+    endValue();
+}
+
+void QJsonStreamWriterPrivate::appendString(QAnyStringView s)
+{
+    QByteArray &out = output();
+    out += '"';
+    out += s.visit([](auto s) {
+        if constexpr (std::is_same_v<decltype(s), QStringView>)
+            return Writer::escapedString(s);
+        else
+            return Writer::escapedString(s.toString());
+    });
+    out += '"';
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (data || buffer.isEmpty())
+        return;
+    if (device && device->write(buffer) != buffer.size())
+        error = true;
+    buffer.truncate(0);
+}
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.7
+
+    \brief The QJsonStreamWriter class writes JSON text incrementally.
+
+    QJsonStreamWriter writes a JSON document one token at a time, without
+    building a QJsonDocument first. Output is collected in a small buffer
+    that is written to the QIODevice whenever it fills up and at the end of
+    each document, so that documents of any size can be written in constant
+    memory. Alternatively, the writer appends to a QByteArray.
+
+    Arrays and objects are written with writeStartArray() and
+    writeStartObject() and closed with writeEndArray() and writeEndObject().
+    Inside an object, each member is a writeName() followed by its value:
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 1
+
+    Every top-level value is followed by a newline, so that writing several
+    documents one after the other produces newline-delimited JSON, as read
+    by QJsonStreamReader.
+
+    The writer does not check that the calls form a valid document, beyond
+    assertions in debug builds.
+
+    \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter
+*/
+
+/*!
+    Constructs a stream writer without output. Use setDevice() to set one.
+*/
+QJsonStreamWriter::QJsonStreamWriter()
+    : d(new QJsonStreamWriterPrivate)
+{
+}
+
+/*!
+    Constructs a stream writer that writes to \a device.
+
+    \sa setDevice()
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : QJsonStreamWriter()
+{
+    d->device = device;
+}
+
+/*!
+    Constructs a stream writer that appends to \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : QJsonStreamWriter()
+{
+    d->data = data;
+}
+
+/*!
+    Destroys the stream writer, after writing any buffered output to the
+    device.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Writes any buffered output and makes the writer continue on \a device.
+    The writer does not take ownership of the device.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->data = nullptr;
+    d->device = device;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if there is none.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the format of the output to \a format. The default is
+    QJsonDocument::Compact.
+
+    \sa format()
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->format = format;
+}
+
+/*!
+    Returns the format of the output.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->format;
+}
+
+/*!
+    Starts an array. Its elements are the values written until the matching
+    writeEndArray().
+*/
+void QJsonStreamWriter::writeStartArray()
+{
+    d->beginValue();
+    d->output() += '[';
+    d->containers.append({ false, true });
+}
+
+/*!
+    Ends the innermost array.
+
+    \sa writeStartArray()
+*/
+void QJsonStreamWriter::writeEndArray()
+{
+    d->endContainer(false);
+}
+
+/*!
+    Starts an object. Its members are written as writeName() followed by a
+    value, until the matching writeEndObject().
+*/
+void QJsonStreamWriter::writeStartObject()
+{
+    d->beginValue();
+    d->output() += '{';
+    d->containers.append({ true, true });
+}
+
+/*!
+    Ends the innermost object.
+
+    \sa writeStartObject()
+*/
+void QJsonStreamWriter::writeEndObject()
+{
+    d->endContainer(true);
+}
+
+/*!
+    Writes \a name as the name of the next member of the innermost object.
+    The value written next is the member's value.
+*/
+void QJsonStreamWriter::writeName(QAnyStringView name)
+{
+    Q_ASSERT_X(!d->containers.isEmpty() && d->containers.last().isObject && !d->afterName,
+               "QJsonStreamWriter", "Names are only valid in objects, before values");
+    d->beginItem();
+    d->appendString(name);
+    d->output() += d->format == QJsonDocument::Indented ? ": " : ":";
+    d->afterName = true;
+}
+
+/*!
+    Writes the string \a value.
+*/
+void QJsonStreamWriter::writeString(QAnyStringView value)
+{
+    d->beginValue();
+    d->appendString(value);
+    d->endValue();
+}
+
+/*!
+    Writes the number \a value.
+*/
+void QJsonStreamWriter::writeInteger(qint64 value)
+{
+    d->beginValue();
+    d->output() += QByteArray::number(value);
+    d->endValue();
+}
+
+/*!
+    Writes the number \a value. Like QJsonDocument, writes \c null for
+    infinities and NaN, which JSON can't represent.
+*/
+void QJsonStreamWriter::writeDouble(double value)
+{
+    d->beginValue();
+    if (qIsFinite(value))
+        d->output() += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    else
+        d->output() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \c true or \c false, depending on \a value.
+*/
+void QJsonStreamWriter::writeBool(bool value)
+{
+    d->beginValue();
+    d->output() += value ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    Writes \c null.
+*/
+void QJsonStreamWriter::writeNull()
+{
+    d->beginValue();
+    d->output() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \a value, including all elements or members of an array or object.
+    An undefined value is written as \c null.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    d->beginValue();
+    Writer::valueToJson(QCborValue::fromJsonValue(value), d->output(), depth(),
+                        d->format == QJsonDocument::Compact);
+    d->endValue();
+}
+
+/*!
+    Returns the number of arrays and objects that are open.
+*/
+int QJsonStreamWriter::depth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Writes the buffered output to the device. This happens automatically at
+    the end of each document and whenever enough output was collected.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+/*!
+    Returns \c true if writing to the device failed.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d->error;
+}
+
+QT_END_NAMESPACE
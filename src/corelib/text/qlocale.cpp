@@ -4176,12 +4176,44 @@ char NumericTokenizer::nextToken()
     number-parsers only work in decimal, so don't have to cope with any digits
     other than 0 through 9.
 */
+/*
+    For the C locale, numberToCLocale() is merely a filter on the characters.
+    When there is nothing but ASCII digits, signs, and (for floating-point) a
+    decimal point and exponent, and no options ask for further checks, the text
+    goes through as is, leaving it to the parser to reject malformed numbers.
+    Returns false, without touching *result, if the general code is needed.
+*/
+extern void qt_to_latin1_unchecked(uchar *dst, const char16_t *uc, qsizetype len);
+
+static bool plainNumberToCLocale(QStringView s, QLocale::NumberOptions number_options,
+                                 QLocaleData::NumberMode mode, CharBuff *result)
+{
+    if (number_options & (QLocale::RejectLeadingZeroInExponent
+                          | QLocale::RejectTrailingZeroesAfterDot)) {
+        return false;
+    }
+    const bool integer = mode == QLocaleData::IntegerMode;
+    for (QChar ch : s) {
+        const char16_t c = ch.unicode();
+        if (!(isAsciiDigit(c) || c == u'-' || c == u'+'
+              || (!integer && (c == u'.' || c == u'e' || c == u'E')))) {
+            return false;
+        }
+    }
+    result->resize(s.size() + 1);
+    qt_to_latin1_unchecked(reinterpret_cast<uchar *>(result->data()), s.utf16(), s.size());
+    result->last() = '\0';
+    return true;
+}
+
 bool QLocaleData::numberToCLocale(QStringView s, QLocale::NumberOptions number_options,
                                   NumberMode mode, CharBuff *result) const
 {
     s = s.trimmed();
     if (s.size() < 1)
         return false;
+    if (this == c() && plainNumberToCLocale(s, number_options, mode, result))
+        return true;
     NumericTokenizer tokens(s, numericData(mode), mode);
 
     // Digit-grouping details (all modes):
@@ -9,6 +9,7 @@
 
 #include <private/qtools_p.h>
 #include <private/qnumeric_p.h>
+#include <QtCore/qendian.h>
 
 #include <ctype.h>
 #include <errno.h>
@@ -36,6 +37,13 @@
 #   define ULLONG_MAX Q_UINT64_C(0xffffffffffffffff)
 #endif
 
+// std::from_chars() for floating-point types implements the Eisel-Lemire
+// algorithm in libstdc++ 12 and later, and in MSVC's STL; libstdc++ 11 goes
+// through strtod(), which is no faster than libdouble-conversion.
+#if defined(__cpp_lib_to_chars) && (!defined(_GLIBCXX_RELEASE) || _GLIBCXX_RELEASE >= 12)
+#  define QT_FLOATING_POINT_FROM_CHARS
+#endif
+
 QT_BEGIN_NAMESPACE
 
 using namespace QtMiscUtils;
@@ -250,6 +258,43 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
         --length;
 }
 
+#ifdef QT_FLOATING_POINT_FROM_CHARS
+/*
+    Parses the common case of a plain decimal number making up all of the input,
+    whose value is finite and doesn't underflow, which std::from_chars() does
+    much faster than libdouble-conversion. Returns a zero \c used for anything
+    else, which the general code then deals with; in particular, it knows how to
+    report overflow and underflow, which std::from_chars() doesn't tell apart.
+*/
+static QSimpleParsedNumber<double> asciiToDoubleFast(const char *num, qsizetype numLen,
+                                                     StrayCharacterMode strayCharMode)
+{
+    const char *begin = num, *end = num + numLen;
+    if (strayCharMode == WhitespacesAllowed) {
+        while (begin < end && ascii_isspace(*begin))
+            ++begin;
+        while (end > begin && ascii_isspace(end[-1]))
+            --end;
+    }
+
+    // std::from_chars() rejects a leading '+', but would accept a second sign
+    // after it, and also inf and nan, which are dealt with before we get here
+    const char *digits = begin;
+    if (digits < end && (*digits == '+' || *digits == '-'))
+        ++digits;
+    if (digits == end || !(isAsciiDigit(*digits) || *digits == '.'))
+        return {};
+    if (*begin == '+')
+        begin = digits;
+
+    double d;
+    const auto r = std::from_chars(begin, end, d, std::chars_format::general);
+    if (r.ec != std::errc{} || r.ptr != end)
+        return {};
+    return { d, numLen };
+}
+#endif // QT_FLOATING_POINT_FROM_CHARS
+
 QSimpleParsedNumber<double> qt_asciiToDouble(const char *num, qsizetype numLen,
                                              StrayCharacterMode strayCharMode)
 {
@@ -292,6 +337,14 @@ QSimpleParsedNumber<double> qt_asciiToDouble(const char *num, qsizetype numLen,
         }
     }
 
+#ifdef QT_FLOATING_POINT_FROM_CHARS
+    // libdouble-conversion doesn't handle input over 2 GB, see below
+    if (int(numLen) == numLen) {
+        if (const auto r = asciiToDoubleFast(num, numLen, strayCharMode); r.ok())
+            return r;
+    }
+#endif
+
     double d = 0.0;
     int processed;
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
@@ -418,6 +471,42 @@ static bool isDigitForBase(char d, int base)
     return false;
 }
 
+/*
+    Reads up to 19 decimal digits, which can't overflow quint64, eight at a time
+    where there are that many, into *value. Returns the end of the digits, or
+    nullptr if there are more than 19 of them, leaving those to
+    std::from_chars(), which checks for overflow.
+*/
+static const char *scanDecimalDigits(const char *p, const char *stop, quint64 *value)
+{
+    constexpr qptrdiff MaxDigits = std::numeric_limits<quint64>::digits10;
+    const char *const limit = p + qMin(stop - p, MaxDigits);
+    quint64 result = 0;
+    while (limit - p >= 8) {
+        const quint64 chunk = qFromLittleEndian<quint64>(p);
+        // Each byte is a digit if its high nibble is 3, and adding 6 to it
+        // doesn't carry into that nibble:
+        constexpr quint64 HighNibbles = 0xf0f0'f0f0'f0f0'f0f0;
+        if (((chunk & HighNibbles) | (((chunk + 0x0606'0606'0606'0606) & HighNibbles) >> 4))
+                != 0x3333'3333'3333'3333) {
+            break;
+        }
+        // Combine pairs of digits, then pairs of those, then pairs of those:
+        quint64 v = chunk - 0x3030'3030'3030'3030;
+        v = (v * 10) + (v >> 8);
+        v = (((v & 0x0000'00ff'0000'00ff) * (100 + (1000000ULL << 32)))
+             + (((v >> 16) & 0x0000'00ff'0000'00ff) * (1 + (10000ULL << 32)))) >> 32;
+        result = result * 100000000 + quint32(v);
+        p += 8;
+    }
+    for (; p < limit && isAsciiDigit(*p); ++p)
+        result = result * 10 + (*p - '0');
+    if (p < stop && isAsciiDigit(*p))
+        return nullptr;
+    *value = result;
+    return p;
+}
+
 QSimpleParsedNumber<qulonglong> qstrntoull(const char *begin, qsizetype size, int base)
 {
     const char *p = begin, *const stop = begin + size;
@@ -430,6 +519,14 @@ QSimpleParsedNumber<qulonglong> qstrntoull(const char *begin, qsizetype size, in
     if (!prefix.base || prefix.next >= stop)
         return { };
 
+    if (prefix.base == 10) {
+        if (const char *end = scanDecimalDigits(prefix.next, stop, &result)) {
+            if (end == prefix.next)
+                return { };
+            return { result, end - begin };
+        }
+    }
+
     const auto res = std::from_chars(prefix.next, stop, result, prefix.base);
     if (res.ec != std::errc{})
         return { };
@@ -454,6 +551,18 @@ QSimpleParsedNumber<qlonglong> qstrntoll(const char *begin, qsizetype size, int
     if (!prefix.base || prefix.next >= stop || !isDigitForBase(*prefix.next, prefix.base))
         return { };
 
+    if (prefix.base == 10) {
+        quint64 magnitude;
+        if (const char *end = scanDecimalDigits(prefix.next, stop, &magnitude)) {
+            constexpr quint64 Max = quint64(std::numeric_limits<long long>::max());
+            if (magnitude > Max + negate)
+                return { };
+            if (negate) // negating the magnitude - 1 can't overflow, even for LLONG_MIN
+                return { magnitude ? -qlonglong(magnitude - 1) - 1 : 0, end - begin };
+            return { qlonglong(magnitude), end - begin };
+        }
+    }
+
     long long result = 0;
     auto res = std::from_chars(prefix.next, stop, result, prefix.base);
     if (negate && res.ec == std::errc::result_out_of_range) {
@@ -0,0 +1,732 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultistringmatcher.h"
+
+#include <qlatin1stringmatcher.h>
+#include <qvarlengtharray.h>
+
+#include <private/qsimd_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+inline uchar foldCase(uchar c)
+{
+    return uchar(QtPrivate::QCaseInsensitiveLatin1Hash()(char(c)));
+}
+
+inline char16_t foldCase(char16_t c)
+{
+    // simple case folding of a code unit; folding a BMP character never
+    // leaves the BMP
+    return char16_t(QChar::toCaseFolded(char32_t(c)));
+}
+
+#ifdef __SSE2__
+// Returns the first of the sixteen bytes at p that is one of the up to three
+// bytes in chars.
+inline const uchar *simdFindAnyOf(const uchar *p, const uchar *end, const uchar *chars, int count)
+{
+    const __m128i c0 = _mm_set1_epi8(char(chars[0]));
+    const __m128i c1 = _mm_set1_epi8(char(chars[count > 1 ? 1 : 0]));
+    const __m128i c2 = _mm_set1_epi8(char(chars[count > 2 ? 2 : 0]));
+    for ( ; end - p >= 16; p += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i found = _mm_or_si128(_mm_cmpeq_epi8(data, c0),
+                                           _mm_or_si128(_mm_cmpeq_epi8(data, c1),
+                                                        _mm_cmpeq_epi8(data, c2)));
+        if (uint mask = _mm_movemask_epi8(found))
+            return p + qCountTrailingZeroBits(mask);
+    }
+    return p;
+}
+
+inline const char16_t *simdFindAnyOf(const char16_t *p, const char16_t *end,
+                                     const char16_t *chars, int count)
+{
+    const __m128i c0 = _mm_set1_epi16(short(chars[0]));
+    const __m128i c1 = _mm_set1_epi16(short(chars[count > 1 ? 1 : 0]));
+    const __m128i c2 = _mm_set1_epi16(short(chars[count > 2 ? 2 : 0]));
+    for ( ; end - p >= 8; p += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i found = _mm_or_si128(_mm_cmpeq_epi16(data, c0),
+                                           _mm_or_si128(_mm_cmpeq_epi16(data, c1),
+                                                        _mm_cmpeq_epi16(data, c2)));
+        if (uint mask = _mm_movemask_epi8(found))
+            return p + qCountTrailingZeroBits(mask) / 2;
+    }
+    return p;
+}
+
+// Finds the first byte that may be in a set of bytes, sixteen at a time. Each
+// byte is looked up by its low and its high nibble in two tables of bit masks,
+// and may be in the set if the two masks share a bit. With up to eight
+// different high nibbles in the set, each gets its own bit and the lookup is
+// exact; with more, they share bits and some bytes are false positives.
+QT_FUNCTION_TARGET(SSSE3)
+const uchar *simdFindInSet(const uchar *p, const uchar *end, const uchar *lowMasks,
+                           const uchar *highMasks)
+{
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lowMasks));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(highMasks));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    for ( ; end - p >= 16; p += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i l = _mm_shuffle_epi8(low, _mm_and_si128(data, nibble));
+        const __m128i h = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(data, 4), nibble));
+        const __m128i none = _mm_cmpeq_epi8(_mm_and_si128(l, h), _mm_setzero_si128());
+        if (uint mask = ~_mm_movemask_epi8(none) & 0xffff)
+            return p + qCountTrailingZeroBits(mask);
+    }
+    return p;
+}
+#endif
+
+// An Aho-Corasick automaton for a set of patterns, as a table of transitions
+// for every state and character class. The characters that appear in the
+// patterns each have their own class, all others share class 0. Searching
+// follows one transition per character of the text; while in the start state,
+// the text is skipped up to the next character a pattern starts with.
+template <typename Char>
+class MultiMatcherAutomaton
+{
+public:
+    template <typename String>
+    void build(const QList<String> &patterns, Qt::CaseSensitivity cs);
+
+    qsizetype indexIn(const Char *begin, qsizetype size, qsizetype from,
+                      qsizetype *patternIndex) const;
+    template <typename Match>
+    QList<Match> findAll(const Char *begin, qsizetype size, qsizetype from) const;
+
+private:
+    int classOf(Char c) const;
+    int classOfFolded(Char c) const;
+    bool startsPattern(Char c) const;
+    const Char *skipToStart(const Char *p, const Char *end) const;
+    template <typename OnMatch>
+    void scan(const Char *begin, const Char *p, const Char *&end, OnMatch onMatch) const;
+
+    QList<Char> alphabet;           // sorted characters of the patterns
+    QList<qint32> transitions;      // classCount entries per state
+    QList<qint32> failure;          // longest proper suffix that is a state
+    QList<qint32> output;           // this or a suffix state where a pattern ends, or 0
+    QList<qint32> patternAt;        // the first pattern that ends in a state, or -1
+    QList<qint32> nextEqual;        // the next pattern equal to a pattern, or -1
+    QList<qsizetype> lengths;
+    qsizetype maxLength = 0;
+    int classCount = 1;
+    bool folding = false;
+    bool wideStarts = false;        // some characters beyond Latin-1 start a pattern
+    int startCount = 0;             // characters that start a pattern, up to 4
+    Char starts[3] = {};
+    int classes[256] = {};
+    uchar startsLatin1[256] = {};
+    alignas(16) uchar lowMasks[16] = {};
+    alignas(16) uchar highMasks[16] = {};
+};
+
+template <typename Char>
+inline int MultiMatcherAutomaton<Char>::classOfFolded(Char c) const
+{
+    const auto it = std::lower_bound(alphabet.cbegin(), alphabet.cend(), c);
+    return it != alphabet.cend() && *it == c ? int(it - alphabet.cbegin()) + 1 : 0;
+}
+
+template <typename Char>
+inline int MultiMatcherAutomaton<Char>::classOf(Char c) const
+{
+    if (sizeof(Char) == 1 || c < 256)
+        return classes[c];
+    return classOfFolded(folding ? foldCase(c) : c);
+}
+
+template <typename Char>
+inline bool MultiMatcherAutomaton<Char>::startsPattern(Char c) const
+{
+    if (sizeof(Char) == 1 || c < 256)
+        return startsLatin1[c];
+    return wideStarts && transitions.at(classOf(c)) != 0;
+}
+
+template <typename Char>
+template <typename String>
+void MultiMatcherAutomaton<Char>::build(const QList<String> &patterns, Qt::CaseSensitivity cs)
+{
+    folding = cs == Qt::CaseInsensitive;
+    QList<QVarLengthArray<Char, 32>> folded;
+    folded.reserve(patterns.size());
+    for (const String &pattern : patterns) {
+        const Char *chars = reinterpret_cast<const Char *>(pattern.constData());
+        folded.emplaceBack(chars, chars + pattern.size());
+        if (folding) {
+            for (Char &c : folded.last())
+                c = foldCase(c);
+        }
+        for (Char c : folded.last())
+            alphabet.append(c);
+        lengths.append(pattern.size());
+        maxLength = qMax(maxLength, pattern.size());
+    }
+    std::sort(alphabet.begin(), alphabet.end());
+    alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+    classCount = int(alphabet.size()) + 1;
+    for (int c = 0; c < 256; ++c)
+        classes[c] = classOfFolded(folding ? foldCase(Char(c)) : Char(c));
+
+    // the trie; its root is state 0
+    transitions.resize(classCount);
+    patternAt.append(-1);
+    nextEqual.fill(-1, patterns.size());
+    for (qsizetype i = 0; i < folded.size(); ++i) {
+        if (folded.at(i).isEmpty())
+            continue;
+        qint32 state = 0;
+        for (Char c : folded.at(i)) {
+            const qsizetype slot = state * classCount + classOfFolded(c);
+            state = transitions.at(slot);
+            if (!state) {
+                state = qint32(patternAt.size());
+                transitions[slot] = state;
+                transitions.resize(transitions.size() + classCount);
+                patternAt.append(-1);
+            }
+        }
+        if (patternAt.at(state) < 0) {
+            patternAt[state] = qint32(i);
+        } else {
+            qint32 same = patternAt.at(state);
+            while (nextEqual.at(same) >= 0)
+                same = nextEqual.at(same);
+            nextEqual[same] = qint32(i);
+        }
+    }
+
+    // turn it into an automaton, breadth-first, so that the failure state of
+    // each state is complete when it's needed
+    const qsizetype stateCount = patternAt.size();
+    failure.resize(stateCount);
+    output.resize(stateCount);
+    QList<qint32> queue;
+    queue.reserve(stateCount);
+    qint32 *table = transitions.data();
+    for (int c = 0; c < classCount; ++c) {
+        if (qint32 state = table[c]) {
+            output[state] = patternAt.at(state) < 0 ? 0 : state;
+            queue.append(state);
+        }
+    }
+    for (qsizetype i = 0; i < queue.size(); ++i) {
+        const qint32 state = queue.at(i);
+        const qint32 *fallback = table + failure.at(state) * classCount;
+        qint32 *next = table + state * classCount;
+        for (int c = 0; c < classCount; ++c) {
+            if (const qint32 child = next[c]) {
+                failure[child] = fallback[c];
+                output[child] = patternAt.at(child) < 0 ? output.at(fallback[c]) : child;
+                queue.append(child);
+            } else {
+                next[c] = fallback[c];
+            }
+        }
+    }
+
+    // the characters that leave the start state
+    const auto addStart = [this](Char c) {
+        if (startCount < 3)
+            starts[startCount] = c;
+        ++startCount;
+    };
+    for (int c = 0; c < 256; ++c) {
+        startsLatin1[c] = table[classes[c]] != 0;
+        if (startsLatin1[c])
+            addStart(Char(c));
+    }
+    if constexpr (sizeof(Char) > 1) {
+        // case folding can map characters beyond Latin-1 into it
+        if (folding || (!alphabet.isEmpty() && alphabet.last() >= 256)) {
+            for (uint c = 256; c <= 0xffff; ++c) {
+                if (table[classOf(Char(c))] != 0) {
+                    wideStarts = true;
+                    addStart(Char(c));
+                }
+            }
+        }
+    } else {
+        int buckets[16];
+        std::fill(std::begin(buckets), std::end(buckets), -1);
+        int bucketCount = 0;
+        for (int c = 0; c < 256; ++c) {
+            if (!startsLatin1[c])
+                continue;
+            int &bucket = buckets[c >> 4];
+            if (bucket < 0)
+                bucket = bucketCount++ % 8;
+            lowMasks[c & 0xf] |= uchar(1 << bucket);
+            highMasks[c >> 4] |= uchar(1 << bucket);
+        }
+    }
+    startCount = qMin(startCount, 4);
+}
+
+template <typename Char>
+const Char *MultiMatcherAutomaton<Char>::skipToStart(const Char *p, const Char *end) const
+{
+#ifdef __SSE2__
+    if (startCount <= 3) {
+        p = simdFindAnyOf(p, end, starts, startCount);
+    } else if constexpr (sizeof(Char) == 1) {
+        if (qCpuHasFeature(SSSE3))
+            p = simdFindInSet(p, end, lowMasks, highMasks);
+    }
+#endif
+    while (p < end && !startsPattern(*p))
+        ++p;
+    return p;
+}
+
+// Calls onMatch with the end and the pattern of each occurrence, in the order
+// of their ends, until it returns false. onMatch may move end closer.
+template <typename Char>
+template <typename OnMatch>
+void MultiMatcherAutomaton<Char>::scan(const Char *begin, const Char *p, const Char *&end,
+                                      OnMatch onMatch) const
+{
+    const qint32 *table = transitions.constData();
+    qint32 state = 0;
+    while (p < end) {
+        if (state == 0) {
+            p = skipToStart(p, end);
+            if (p == end)
+                break;
+        }
+        state = table[state * classCount + classOf(*p++)];
+        for (qint32 s = output.at(state); s; s = output.at(failure.at(s))) {
+            for (qint32 i = patternAt.at(s); i >= 0; i = nextEqual.at(i)) {
+                if (!onMatch(p - begin, i))
+                    return;
+            }
+        }
+    }
+}
+
+template <typename Char>
+qsizetype MultiMatcherAutomaton<Char>::indexIn(const Char *begin, qsizetype size, qsizetype from,
+                                               qsizetype *patternIndex) const
+{
+    qsizetype position = -1;
+    qsizetype pattern = -1;
+    if (from < 0)
+        from = 0;
+    if (from <= size && maxLength) {
+        // the first occurrence to end isn't necessarily the first one to
+        // start, so go on while a longer one could still start before it
+        const Char *end = begin + size;
+        scan(begin, begin + from, end, [&](qsizetype matchEnd, qsizetype i) {
+            const qsizetype start = matchEnd - lengths.at(i);
+            if (position < 0 || start < position || (start == position && i < pattern)) {
+                position = start;
+                pattern = i;
+                end = begin + qMin(size, position + maxLength);
+            }
+            return true;
+        });
+    }
+    if (patternIndex)
+        *patternIndex = pattern;
+    return position;
+}
+
+template <typename Char>
+template <typename Match>
+QList<Match> MultiMatcherAutomaton<Char>::findAll(const Char *begin, qsizetype size,
+                                                  qsizetype from) const
+{
+    QList<Match> matches;
+    if (from < 0)
+        from = 0;
+    if (from <= size && maxLength) {
+        const Char *end = begin + size;
+        scan(begin, begin + from, end, [&](qsizetype matchEnd, qsizetype i) {
+            const qsizetype length = lengths.at(i);
+            matches.append(Match{ matchEnd - length, length, i });
+            return true;
+        });
+    }
+    std::sort(matches.begin(), matches.end(), [](const Match &lhs, const Match &rhs) {
+        return lhs.position != rhs.position ? lhs.position < rhs.position
+                                            : lhs.patternIndex < rhs.patternIndex;
+    });
+    return matches;
+}
+
+} // unnamed namespace
+
+class QMultiByteArrayMatcherPrivate : public QSharedData
+{
+public:
+    QMultiByteArrayMatcherPrivate(const QList<QByteArray> &patterns, Qt::CaseSensitivity cs)
+        : patterns(patterns), cs(cs)
+    {
+        automaton.build(patterns, cs);
+    }
+
+    QList<QByteArray> patterns;
+    Qt::CaseSensitivity cs;
+    MultiMatcherAutomaton<uchar> automaton;
+};
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    QMultiStringMatcherPrivate(const QList<QString> &patterns, Qt::CaseSensitivity cs)
+        : patterns(patterns), cs(cs)
+    {
+        automaton.build(patterns, cs);
+    }
+
+    QList<QString> patterns;
+    Qt::CaseSensitivity cs;
+    MultiMatcherAutomaton<char16_t> automaton;
+};
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiByteArrayMatcherPrivate)
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \brief The QMultiByteArrayMatcher class finds any of a set of byte
+    arrays in a byte array.
+    \since 6.7
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+
+    QMultiByteArrayMatcher searches for many patterns at once, for example
+    for a list of keywords in lines of a log file. It prepares the patterns
+    once, in the constructor or in setPatterns(), and then finds any of
+    them in a single pass over the data, instead of one pass per pattern with
+    QByteArrayMatcher. The time a search takes hardly depends on the number
+    of patterns.
+
+    indexIn() finds the first occurrence of any pattern, and findAll() finds
+    every occurrence of every pattern, including ones that overlap.
+
+    \snippet code/src_corelib_text_qmultistringmatcher.cpp 0
+
+    Searching can ignore the case of Latin-1 letters, like
+    QLatin1StringMatcher does. Empty patterns never match.
+
+    \sa QMultiStringMatcher, QByteArrayMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+    \brief An occurrence of a pattern, as found by QMultiByteArrayMatcher::findAll().
+
+    \variable QMultiByteArrayMatcher::Match::position
+    The position where the occurrence starts in the data.
+
+    \variable QMultiByteArrayMatcher::Match::length
+    The length of the occurrence.
+
+    \variable QMultiByteArrayMatcher::Match::patternIndex
+    The index in QMultiByteArrayMatcher::patterns() of the pattern that
+    occurs.
+*/
+
+/*!
+    Constructs a matcher without patterns, which never finds anything.
+
+    \sa setPatterns()
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+    : QMultiByteArrayMatcher(QList<QByteArray>())
+{
+}
+
+/*!
+    Constructs a matcher that searches for \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &patterns,
+                                               Qt::CaseSensitivity cs)
+    : d(new QMultiByteArrayMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) noexcept
+    = default;
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other) noexcept
+    = default;
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Makes the matcher search for \a patterns.
+
+    \sa patterns()
+*/
+void QMultiByteArrayMatcher::setPatterns(const QList<QByteArray> &patterns)
+{
+    d.reset(new QMultiByteArrayMatcherPrivate(patterns, d->cs));
+}
+
+/*!
+    Returns the patterns the matcher searches for.
+
+    \sa setPatterns()
+*/
+QList<QByteArray> QMultiByteArrayMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity of the search to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiByteArrayMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs != d->cs)
+        d.reset(new QMultiByteArrayMatcherPrivate(d->patterns, cs));
+}
+
+/*!
+    Returns the case sensitivity of the search.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiByteArrayMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches \a data from position \a from for any of the patterns(), and
+    returns the position of the first occurrence, or -1 if none was found.
+    If \a patternIndex is not \nullptr, it is set to the index of the pattern
+    found, or to -1.
+
+    If several patterns occur at the same position, the one that comes first
+    in patterns() is found.
+
+    \sa findAll()
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(QByteArrayView data, qsizetype from,
+                                          qsizetype *patternIndex) const
+{
+    return d->automaton.indexIn(reinterpret_cast<const uchar *>(data.data()), data.size(), from,
+                                patternIndex);
+}
+
+/*!
+    Returns every occurrence of each of the patterns() in \a data from
+    position \a from, including ones that overlap, ordered by position and
+    then by the index of the pattern.
+
+    \sa indexIn()
+*/
+QList<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::findAll(QByteArrayView data,
+                                                                     qsizetype from) const
+{
+    return d->automaton.findAll<Match>(reinterpret_cast<const uchar *>(data.data()), data.size(),
+                                       from);
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \brief The QMultiStringMatcher class finds any of a set of strings in a
+    string.
+    \since 6.7
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+
+    QMultiStringMatcher is the counterpart of QMultiByteArrayMatcher for
+    UTF-16 strings. Searching can ignore case, using the simple case folding
+    of each UTF-16 code unit.
+
+    \sa QMultiByteArrayMatcher, QStringMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \brief An occurrence of a pattern, as found by QMultiStringMatcher::findAll().
+
+    \variable QMultiStringMatcher::Match::position
+    The position where the occurrence starts in the string.
+
+    \variable QMultiStringMatcher::Match::length
+    The length of the occurrence.
+
+    \variable QMultiStringMatcher::Match::patternIndex
+    The index in QMultiStringMatcher::patterns() of the pattern that occurs.
+*/
+
+/*!
+    Constructs a matcher without patterns, which never finds anything.
+
+    \sa setPatterns()
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : QMultiStringMatcher(QList<QString>())
+{
+}
+
+/*!
+    Constructs a matcher that searches for \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QList<QString> &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) noexcept
+    = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Makes the matcher search for \a patterns.
+
+    \sa patterns()
+*/
+void QMultiStringMatcher::setPatterns(const QList<QString> &patterns)
+{
+    d.reset(new QMultiStringMatcherPrivate(patterns, d->cs));
+}
+
+/*!
+    Returns the patterns the matcher searches for.
+
+    \sa setPatterns()
+*/
+QList<QString> QMultiStringMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity of the search to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs != d->cs)
+        d.reset(new QMultiStringMatcherPrivate(d->patterns, cs));
+}
+
+/*!
+    Returns the case sensitivity of the search.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches \a str from position \a from for any of the patterns(), and
+    returns the position of the first occurrence, or -1 if none was found.
+    If \a patternIndex is not \nullptr, it is set to the index of the pattern
+    found, or to -1.
+
+    If several patterns occur at the same position, the one that comes first
+    in patterns() is found.
+
+    \sa findAll()
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView str, qsizetype from,
+                                       qsizetype *patternIndex) const
+{
+    return d->automaton.indexIn(str.utf16(), str.size(), from, patternIndex);
+}
+
+/*!
+    Returns every occurrence of each of the patterns() in \a str from
+    position \a from, including ones that overlap, ordered by position and
+    then by the index of the pattern.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::findAll(QStringView str,
+                                                               qsizetype from) const
+{
+    return d->automaton.findAll<Match>(str.utf16(), str.size(), from);
+}
+
+QT_END_NAMESPACE
@@ -5,6 +5,7 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -700,6 +701,35 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    The result of compiling a pattern with a given set of pattern options.
+    Once compiled (and JIT-compiled), the code is never modified again, so it
+    can be shared by all the QRegularExpression and QRegularExpressionSet
+    objects using the same pattern and options, and be used for matching from
+    any thread.
+*/
+struct QRegularExpressionCompiledCode : QSharedData
+{
+    QRegularExpressionCompiledCode() = default;
+    ~QRegularExpressionCompiledCode();
+    Q_DISABLE_COPY_MOVE(QRegularExpressionCompiledCode)
+
+    void compile(const QString &pattern, QRegularExpression::PatternOptions patternOptions);
+    void optimize();
+    void getPatternInfo();
+
+    pcre2_code_16 *code = nullptr;
+    int errorCode = 0;
+    qsizetype errorOffset = -1;
+    int capturingCount = 0;
+    uint minimumLength = 0;
+    bool usingCrLfNewlines = false;
+    bool hasJOptionChanged = false;
+};
+
+static QExplicitlySharedDataPointer<QRegularExpressionCompiledCode>
+compiledCodeForPattern(const QString &pattern, QRegularExpression::PatternOptions patternOptions);
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -709,7 +739,6 @@ struct QRegularExpressionPrivate : QSharedData
     void cleanCompiledPattern();
     void compilePattern();
     void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -732,9 +761,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The compiled code is shared with all the other objects using the same
+    // pattern and options (through the compiled code cache); compiledPattern
+    // is a shortcut to compiledCode->code. When the private is copied (i.e. a
+    // detach happened) both are reset.
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledCode> compiledCode;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -844,8 +875,8 @@ QRegularExpressionPrivate::~QRegularExpressionPrivate()
     \internal
 
     Copies the private, which means copying only the pattern and the pattern
-    options. The compiledPattern pointer is NOT copied (we
-    do not own it any more), and in general all the members set when
+    options. The compiled code is NOT copied (it will be looked up again in
+    the compiled code cache), and in general all the members set when
     compiling a pattern are set to default values. isDirty is set back to true
     so that the pattern has to be recompiled again.
 */
@@ -868,7 +899,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiledCode.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -889,18 +920,65 @@ void QRegularExpressionPrivate::compilePattern()
     isDirty = false;
     cleanCompiledPattern();
 
+    compiledCode = compiledCodeForPattern(pattern, patternOptions);
+    compiledPattern = compiledCode->code;
+
+    if (!compiledPattern) {
+        errorCode = compiledCode->errorCode;
+        errorOffset = compiledCode->errorOffset;
+        return;
+    }
+
+    getPatternInfo();
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionPrivate::getPatternInfo()
+{
+    Q_ASSERT(compiledPattern);
+
+    capturingCount = compiledCode->capturingCount;
+    usingCrLfNewlines = compiledCode->usingCrLfNewlines;
+
+    if (Q_UNLIKELY(compiledCode->hasJOptionChanged)) {
+        qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
+                 qUtf16Printable(pattern));
+    }
+}
+
+/*!
+    \internal
+*/
+QRegularExpressionCompiledCode::~QRegularExpressionCompiledCode()
+{
+    pcre2_code_free_16(code);
+}
+
+/*!
+    \internal
+
+    Compiles \a pattern with the given \a patternOptions. On failure, code is
+    left to nullptr and errorCode and errorOffset describe the error.
+*/
+void QRegularExpressionCompiledCode::compile(const QString &pattern,
+                                             QRegularExpression::PatternOptions patternOptions)
+{
+    Q_ASSERT(!code);
+
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
     PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
-                                       pattern.size(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       nullptr);
-
-    if (!compiledPattern) {
+    code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
+                            pattern.size(),
+                            options,
+                            &errorCode,
+                            &patternErrorOffset,
+                            nullptr);
+
+    if (!code) {
         errorOffset = qsizetype(patternErrorOffset);
         return;
     } else {
@@ -908,22 +986,23 @@ void QRegularExpressionPrivate::compilePattern()
         errorCode = 0;
     }
 
-    optimizePattern();
+    optimize();
     getPatternInfo();
 }
 
 /*!
     \internal
 */
-void QRegularExpressionPrivate::getPatternInfo()
+void QRegularExpressionCompiledCode::getPatternInfo()
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
+    pcre2_pattern_info_16(code, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
+    pcre2_pattern_info_16(code, PCRE2_INFO_MINLENGTH, &minimumLength);
 
     // detect the settings for the newline
     unsigned int patternNewlineSetting;
-    if (pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
+    if (pcre2_pattern_info_16(code, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
         // no option was specified in the regexp, grab PCRE build defaults
         pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
     }
@@ -932,14 +1011,76 @@ void QRegularExpressionPrivate::getPatternInfo()
             (patternNewlineSetting == PCRE2_NEWLINE_ANY) ||
             (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
 
-    unsigned int hasJOptionChanged;
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
-    if (Q_UNLIKELY(hasJOptionChanged)) {
-        qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
-                 qUtf16Printable(pattern));
+    unsigned int jOptionChanged;
+    pcre2_pattern_info_16(code, PCRE2_INFO_JCHANGED, &jOptionChanged);
+    hasJOptionChanged = jOptionChanged;
+}
+
+/*
+    The process-wide cache of compiled code, so that QRegularExpression objects
+    built over and over again from the same pattern (e.g. in filters and
+    validators) don't recompile it every time. It's a LRU cache bounded to a
+    number of entries; evicting an entry doesn't affect the objects still
+    using its code, as they hold a reference to it.
+*/
+namespace {
+struct CompiledCodeCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+
+    friend bool operator==(const CompiledCodeCacheKey &lhs, const CompiledCodeCacheKey &rhs) noexcept
+    {
+        return lhs.patternOptions == rhs.patternOptions && lhs.pattern == rhs.pattern;
+    }
+    friend size_t qHash(const CompiledCodeCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.pattern, key.patternOptions.toInt());
     }
+};
+
+struct CompiledCodeCache
+{
+    static constexpr qsizetype MaximumEntries = 256;
+
+    QMutex mutex;
+    QCache<CompiledCodeCacheKey, QExplicitlySharedDataPointer<QRegularExpressionCompiledCode>> cache{MaximumEntries};
+};
 }
 
+Q_GLOBAL_STATIC(CompiledCodeCache, compiledCodeCache)
+
+/*!
+    \internal
+
+    Returns the compiled code for \a pattern and \a patternOptions, compiling
+    it only if it's not found in the compiled code cache. The returned object
+    is never null, but it may carry a compilation error.
+*/
+static QExplicitlySharedDataPointer<QRegularExpressionCompiledCode>
+compiledCodeForPattern(const QString &pattern, QRegularExpression::PatternOptions patternOptions)
+{
+    CompiledCodeCacheKey key{pattern, patternOptions};
+    CompiledCodeCache *cache = compiledCodeCache();
+
+    if (cache) {
+        const QMutexLocker lock(&cache->mutex);
+        if (const auto *cached = cache->cache.object(key))
+            return *cached;
+    }
+
+    // Don't hold the lock while compiling, that can take a while. If another
+    // thread compiles the same pattern concurrently, the last one wins.
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledCode> compiled(new QRegularExpressionCompiledCode);
+    compiled->compile(pattern, patternOptions);
+
+    if (cache) {
+        const QMutexLocker lock(&cache->mutex);
+        cache->cache.insert(std::move(key), new QExplicitlySharedDataPointer(compiled));
+    }
+
+    return compiled;
+}
 
 /*
     Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
@@ -992,19 +1133,19 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called when a pattern is compiled by us (in compile()), before
+    the code gets published in the compiled code cache.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionCompiledCode::optimize()
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
 }
 
 /*!
@@ -2762,6 +2903,324 @@ QtPrivate::QRegularExpressionMatchIteratorRangeBasedForIterator begin(const QReg
   \internal
 */
 
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QRegularExpressionSet class matches a string against a set of
+    regular expressions at once.
+
+    \since 6.7
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    \keyword regular expression set
+
+    QRegularExpressionSet holds a list of patterns, all compiled with the same
+    pattern options, and answers which of them match a given subject string.
+    This is the typical need of routing tables, filters and dispatchers, which
+    would otherwise have to loop over a list of QRegularExpression objects and
+    pay for building a QRegularExpressionMatch for every one of them.
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 37
+
+    The patterns are compiled when they are set. A matching operation validates
+    the subject string only once for all the patterns, reuses the same match
+    data for all of them, and skips the patterns that cannot possibly match
+    because the subject string is too short. Only whether a pattern matches is
+    computed; use QRegularExpression to extract the captured substrings of the
+    patterns that matched.
+
+    The compiled patterns are shared with QRegularExpression objects (and other
+    QRegularExpressionSet objects) that use the same pattern and options.
+
+    \sa QRegularExpression, QMultiStringMatcher
+*/
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    void compilePatterns();
+
+    template <typename Callback>
+    void doMatch(QStringView subject, qsizetype offset,
+                 QRegularExpression::MatchOptions matchOptions,
+                 Callback callback) const;
+
+    QStringList patterns;
+    QRegularExpression::PatternOptions patternOptions;
+    QList<QExplicitlySharedDataPointer<QRegularExpressionCompiledCode>> compiledCodes;
+    bool isValid = true;
+};
+
+/*!
+    \internal
+*/
+void QRegularExpressionSetPrivate::compilePatterns()
+{
+    compiledCodes.clear();
+    compiledCodes.reserve(patterns.size());
+    isValid = true;
+
+    for (const QString &pattern : std::as_const(patterns)) {
+        compiledCodes.append(compiledCodeForPattern(pattern, patternOptions));
+        isValid = isValid && compiledCodes.constLast()->code;
+    }
+}
+
+/*!
+    \internal
+
+    Matches every compiled pattern against \a subject, starting at \a offset,
+    and calls \a callback with the index of each pattern that matched, in
+    order. The matching stops as soon as \a callback returns false.
+*/
+template <typename Callback>
+void QRegularExpressionSetPrivate::doMatch(QStringView subject, qsizetype offset,
+                                           QRegularExpression::MatchOptions matchOptions,
+                                           Callback callback) const
+{
+    const qsizetype subjectLength = subject.size();
+
+    if (offset < 0)
+        offset += subjectLength;
+
+    if (offset < 0 || offset > subjectLength)
+        return;
+
+    int pcreOptions = convertToPcreOptions(matchOptions);
+
+    // Check the subject string once for all the patterns, rather than having
+    // PCRE check it again for every one of them. PCRE would report an error
+    // (i.e. no match) for an invalid string or for an offset in the middle
+    // of a surrogate pair, so do the same.
+    if (!(pcreOptions & PCRE2_NO_UTF_CHECK)) {
+        if (!subject.isValidUtf16())
+            return;
+        if (offset > 0 && offset < subjectLength && subject.at(offset).isLowSurrogate())
+            return;
+        pcreOptions |= PCRE2_NO_UTF_CHECK;
+    }
+
+    // See the comment in QRegularExpressionPrivate::doMatch
+    const char16_t dummySubject = 0;
+    const char16_t *subjectUtf16 = subject.utf16();
+    if (!subjectUtf16)
+        subjectUtf16 = &dummySubject;
+
+    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
+    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
+
+    // We only need to know whether a pattern matched, not where: a match data
+    // with room for just one pair of offsets can be used for all the
+    // patterns. PCRE2 returns 0 if there were more captures than room for
+    // them, which still means that the pattern matched.
+    pcre2_match_data_16 *matchData = pcre2_match_data_create_16(1, nullptr);
+
+    for (qsizetype i = 0; i < compiledCodes.size(); ++i) {
+        const QRegularExpressionCompiledCode *compiled = compiledCodes.at(i).constData();
+        if (!compiled->code || compiled->minimumLength > quint64(subjectLength - offset))
+            continue;
+
+        const int result = safe_pcre2_match_16(compiled->code,
+                                               reinterpret_cast<PCRE2_SPTR16>(subjectUtf16), subjectLength,
+                                               offset, pcreOptions,
+                                               matchData, matchContext);
+        if (result >= 0 && !callback(i))
+            break;
+    }
+
+    pcre2_match_data_free_16(matchData);
+    pcre2_match_context_free_16(matchContext);
+}
+
+/*!
+    Constructs an empty QRegularExpressionSet, which matches nothing.
+
+    \sa setPatterns()
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+}
+
+/*!
+    Constructs a QRegularExpressionSet object using the given \a patterns,
+    all of them compiled with the pattern options \a options.
+
+    \sa setPatterns(), setPatternOptions()
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QStringList &patterns,
+                                             QRegularExpression::PatternOptions options)
+    : d(new QRegularExpressionSetPrivate)
+{
+    d->patterns = patterns;
+    d->patternOptions = options;
+    d->compilePatterns();
+}
+
+/*!
+    Constructs a QRegularExpressionSet object as a copy of \a other.
+
+    \sa operator=()
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other) noexcept = default;
+
+/*!
+    \fn QRegularExpressionSet::QRegularExpressionSet(QRegularExpressionSet &&other)
+
+    Constructs a QRegularExpressionSet object by moving from \a other.
+
+    Note that a moved-from QRegularExpressionSet can only be destroyed or
+    assigned to. The effect of calling other functions than the destructor
+    or one of the assignment operators is undefined.
+
+    \sa operator=()
+*/
+
+/*!
+    Destroys the QRegularExpressionSet object.
+*/
+QRegularExpressionSet::~QRegularExpressionSet()
+{
+}
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QRegularExpressionSetPrivate)
+
+/*!
+    Assigns \a other to this object, and returns a reference to the copy.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other) noexcept = default;
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this object, and returns a reference to the
+    result.
+
+    Note that a moved-from QRegularExpressionSet can only be destroyed or
+    assigned to. The effect of calling other functions than the destructor
+    or one of the assignment operators is undefined.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps this set with \a other. This operation is very fast and never fails.
+*/
+
+/*!
+    Returns the patterns of this set.
+
+    \sa setPatterns()
+*/
+QStringList QRegularExpressionSet::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the patterns of this set to \a patterns, and compiles them. The
+    results of matchingPatterns() and firstMatchingPattern() are indexes
+    into this list.
+
+    \sa patterns(), isValid()
+*/
+void QRegularExpressionSet::setPatterns(const QStringList &patterns)
+{
+    if (d->patterns == patterns)
+        return;
+    d.detach();
+    d->patterns = patterns;
+    d->compilePatterns();
+}
+
+/*!
+    Returns the pattern options used to compile the patterns of this set.
+
+    \sa setPatternOptions()
+*/
+QRegularExpression::PatternOptions QRegularExpressionSet::patternOptions() const
+{
+    return d->patternOptions;
+}
+
+/*!
+    Sets the pattern options used to compile the patterns of this set to
+    \a options, and compiles them again.
+
+    \sa patternOptions()
+*/
+void QRegularExpressionSet::setPatternOptions(QRegularExpression::PatternOptions options)
+{
+    if (d->patternOptions == options)
+        return;
+    d.detach();
+    d->patternOptions = options;
+    d->compilePatterns();
+}
+
+/*!
+    Returns \c true if all the patterns of this set are valid regular
+    expressions, or false otherwise. Invalid patterns never match.
+
+    To find out what is wrong with a pattern, build a QRegularExpression
+    object from it and the patternOptions() of this set, and check its
+    errorString(). The pattern is not compiled again to do so.
+
+    \sa QRegularExpression::isValid()
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    return d->isValid;
+}
+
+/*!
+    Attempts to match all the patterns of this set against the given
+    \a subject string, starting at the position \a offset inside the subject,
+    honoring the given \a matchOptions. Returns the indexes of the patterns
+    that matched, in increasing order.
+
+    As for QRegularExpression::match(), if \a offset is negative it counts
+    from the end of the subject string. If \a subject is not a valid UTF-16
+    string, no pattern matches, unless
+    QRegularExpression::DontCheckSubjectStringMatchOption is passed.
+
+    \sa firstMatchingPattern(), QRegularExpression::match()
+*/
+QList<qsizetype> QRegularExpressionSet::matchingPatterns(QStringView subject, qsizetype offset,
+                                                         QRegularExpression::MatchOptions matchOptions) const
+{
+    QList<qsizetype> result;
+    d->doMatch(subject, offset, matchOptions, [&result](qsizetype i) {
+        result.append(i);
+        return true;
+    });
+    return result;
+}
+
+/*!
+    Attempts to match the patterns of this set against the given \a subject
+    string, in order, starting at the position \a offset inside the subject
+    and honoring the given \a matchOptions. Returns the index of the first
+    pattern that matched, or -1 if none did. The patterns following it are not
+    tried.
+
+    \sa matchingPatterns()
+*/
+qsizetype QRegularExpressionSet::firstMatchingPattern(QStringView subject, qsizetype offset,
+                                                      QRegularExpression::MatchOptions matchOptions) const
+{
+    qsizetype result = -1;
+    d->doMatch(subject, offset, matchOptions, [&result](qsizetype i) {
+        result = i;
+        return false;
+    });
+    return result;
+}
+
 #ifndef QT_NO_DATASTREAM
 /*!
     \relates QRegularExpression
@@ -385,6 +385,44 @@ private:
 
 Q_DECLARE_SHARED(QRegularExpressionMatchIterator)
 
+struct QRegularExpressionSetPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QRegularExpressionSetPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QStringList &patterns,
+                                   QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+    QRegularExpressionSet(const QRegularExpressionSet &other) noexcept;
+    QRegularExpressionSet(QRegularExpressionSet &&other) noexcept = default;
+    ~QRegularExpressionSet();
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QRegularExpressionSet)
+
+    void swap(QRegularExpressionSet &other) noexcept { d.swap(other.d); }
+
+    QStringList patterns() const;
+    void setPatterns(const QStringList &patterns);
+    QRegularExpression::PatternOptions patternOptions() const;
+    void setPatternOptions(QRegularExpression::PatternOptions options);
+
+    [[nodiscard]]
+    bool isValid() const;
+
+    [[nodiscard]]
+    QList<qsizetype> matchingPatterns(QStringView subject, qsizetype offset = 0,
+                                      QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+    [[nodiscard]]
+    qsizetype firstMatchingPattern(QStringView subject, qsizetype offset = 0,
+                                   QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+
+private:
+    QExplicitlySharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSet)
+
 QT_END_NAMESPACE
 
 #endif // QREGULAREXPRESSION_H
@@ -342,6 +342,176 @@ static void simdCompareAscii(const qchar8_t *&src8, const qchar8_t *end8, const
     src8 += offset;
     src16 += offset;
 }
+
+// Decodes a run of two-byte UTF-8 sequences (U+0080 to U+07FF, e.g. Greek,
+// Cyrillic, Hebrew or Arabic text) starting at src, eight characters at a
+// time, and stops before the first sequence that is not one. Returns false,
+// without decoding anything, if the first block isn't entirely such a run.
+static inline bool simdDecodeTwoByteUtf8(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+    for ( ; end - src >= 16; src += 16, dst += 8) {
+        // each 16-bit lane holds the lead byte in its low half and the
+        // continuation byte in its high half
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        __m128i valid = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xc0e0))),
+                                        _mm_set1_epi16(short(0x80c0)));
+        // lead bytes 0xc0 and 0xc1 would be overlong
+        const __m128i overlong = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(0x1e)),
+                                                 _mm_setzero_si128());
+        valid = _mm_andnot_si128(overlong, valid);
+
+        const __m128i high = _mm_slli_epi16(_mm_and_si128(data, _mm_set1_epi16(0x1f)), 6);
+        const __m128i low = _mm_and_si128(_mm_srli_epi16(data, 8), _mm_set1_epi16(0x3f));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(high, low));
+
+        if (uint n = ~_mm_movemask_epi8(valid) & 0xffff) {
+            // a run that doesn't fill the first block is faster in scalar
+            // code; otherwise, keep the valid characters before the first
+            // invalid one
+            if (src == start)
+                return false;
+            n = qCountTrailingZeroBits(n) / 2;
+            src += 2 * n;
+            dst += n;
+            break;
+        }
+    }
+    return src != start;
+}
+
+// Same for three-byte sequences (U+0800 to U+FFFF, e.g. CJK text), four
+// characters at a time. Needs SSSE3 to gather the bytes of each sequence.
+QT_FUNCTION_TARGET(SSSE3)
+static bool simdDecodeThreeByteUtf8(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    const __m128i gather = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i narrow = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    const uchar *const start = src;
+    for ( ; end - src >= 16; src += 12, dst += 4) {
+        // each 32-bit lane holds one sequence, lead byte lowest
+        const __m128i data = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)),
+                                              gather);
+        __m128i valid = _mm_cmpeq_epi32(_mm_and_si128(data, _mm_set1_epi32(0x00c0c0f0)),
+                                        _mm_set1_epi32(0x008080e0));
+
+        const __m128i ucs = _mm_or_si128(
+                    _mm_slli_epi32(_mm_and_si128(data, _mm_set1_epi32(0x0f)), 12),
+                    _mm_or_si128(_mm_srli_epi32(_mm_and_si128(data, _mm_set1_epi32(0x3f00)), 2),
+                                 _mm_srli_epi32(_mm_and_si128(data, _mm_set1_epi32(0x3f0000)), 16)));
+        // no overlong sequences and no surrogates
+        valid = _mm_andnot_si128(_mm_cmplt_epi32(ucs, _mm_set1_epi32(0x800)), valid);
+        valid = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(ucs, _mm_set1_epi32(0xf800)),
+                                                 _mm_set1_epi32(0xd800)), valid);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(ucs, narrow));
+
+        if (uint n = ~_mm_movemask_ps(_mm_castsi128_ps(valid)) & 0xf) {
+            if (src == start)
+                return false;
+            n = qCountTrailingZeroBits(n);
+            src += 3 * n;
+            dst += n;
+            break;
+        }
+    }
+    return src != start;
+}
+
+// Decodes a run of non-ASCII characters of the same UTF-8 length as the one
+// at src, if there is one worth decoding in SIMD. Short runs, like accented
+// letters in Latin text or words of a few letters, are faster in scalar code,
+// so check a few characters of the first block before trying.
+static inline bool simdDecodeNonAscii(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    if (end - src < 16)
+        return false;
+    const uchar b = *src;
+    if (b >= 0xc2 && b < 0xe0 && (src[6] & 0xe0) == 0xc0 && (src[14] & 0xe0) == 0xc0)
+        return simdDecodeTwoByteUtf8(dst, src, end);
+    if ((b & 0xf0) == 0xe0 && (src[9] & 0xf0) == 0xe0 && qCpuHasFeature(SSSE3))
+        return simdDecodeThreeByteUtf8(dst, src, end);
+    return false;
+}
+
+// Encodes a run of characters that need two UTF-8 bytes each, starting at
+// src, eight at a time.
+static inline bool simdEncodeTwoByteUtf8(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    const char16_t *const start = src;
+    for ( ; end - src >= 8; src += 8, dst += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        // U+0080 to U+07FF
+        const __m128i valid = _mm_andnot_si128(
+                    _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))), _mm_setzero_si128()),
+                    _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))), _mm_setzero_si128()));
+
+        // lead byte in the low half of each lane, continuation in the high half
+        const __m128i lead = _mm_or_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0xc0));
+        const __m128i continuation = _mm_slli_epi16(_mm_and_si128(data, _mm_set1_epi16(0x3f)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                         _mm_or_si128(_mm_or_si128(lead, continuation), _mm_set1_epi16(short(0x8000))));
+
+        if (uint n = ~_mm_movemask_epi8(valid) & 0xffff) {
+            if (src == start)
+                return false;
+            n = qCountTrailingZeroBits(n) / 2;
+            src += n;
+            dst += 2 * n;
+            break;
+        }
+    }
+    return src != start;
+}
+
+// Same for characters that need three bytes, four at a time.
+QT_FUNCTION_TARGET(SSSE3)
+static bool simdEncodeThreeByteUtf8(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    const __m128i narrow = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const char16_t *const start = src;
+    // the output buffer has room for three bytes per character, so storing
+    // 16 bytes for 12 is fine as long as there are eight characters left
+    for ( ; end - src >= 8; src += 4, dst += 12) {
+        const __m128i data = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)),
+                                                _mm_setzero_si128());
+        // U+0800 to U+FFFF, but no surrogates
+        __m128i valid = _mm_cmpgt_epi32(data, _mm_set1_epi32(0x7ff));
+        valid = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(data, _mm_set1_epi32(0xf800)),
+                                                 _mm_set1_epi32(0xd800)), valid);
+
+        const __m128i lead = _mm_srli_epi32(data, 12);
+        const __m128i middle = _mm_slli_epi32(_mm_and_si128(data, _mm_set1_epi32(0xfc0)), 2);
+        const __m128i last = _mm_slli_epi32(_mm_and_si128(data, _mm_set1_epi32(0x3f)), 16);
+        const __m128i bytes = _mm_or_si128(_mm_or_si128(lead, middle),
+                                           _mm_or_si128(last, _mm_set1_epi32(0x008080e0)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(bytes, narrow));
+
+        if (uint n = ~_mm_movemask_ps(_mm_castsi128_ps(valid)) & 0xf) {
+            if (src == start)
+                return false;
+            n = qCountTrailingZeroBits(n);
+            src += n;
+            dst += 3 * n;
+            break;
+        }
+    }
+    return src != start;
+}
+
+// Encodes a run of non-ASCII characters of the same UTF-8 length as the one
+// at src, if there is one worth encoding in SIMD (see simdDecodeNonAscii).
+static inline bool simdEncodeNonAscii(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    if (end - src < 8)
+        return false;
+    const auto isTwoByte = [](char16_t u) { return u >= 0x80 && u < 0x800; };
+    const auto isThreeByte = [](char16_t u) { return u >= 0x800 && !QChar::isSurrogate(u); };
+    if (isTwoByte(src[0]) && isTwoByte(src[3]) && isTwoByte(src[7]))
+        return simdEncodeTwoByteUtf8(dst, src, end);
+    if (isThreeByte(src[0]) && isThreeByte(src[3]) && qCpuHasFeature(SSSE3))
+        return simdEncodeThreeByteUtf8(dst, src, end);
+    return false;
+}
 #elif defined(__ARM_NEON__)
 static inline bool simdEncodeAscii(uchar *&dst, const char16_t *&nextAscii, const char16_t *&src, const char16_t *end)
 {
@@ -442,6 +612,106 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 static void simdCompareAscii(const qchar8_t *&, const qchar8_t *, const char16_t *&, const char16_t *)
 {
 }
+
+// Decodes a run of two-byte UTF-8 sequences (U+0080 to U+07FF, e.g. Greek,
+// Cyrillic, Hebrew or Arabic text) starting at src, sixteen characters at a
+// time, and stops before the first sequence that is not one. Returns false,
+// without decoding anything, if the first block isn't entirely such a run.
+static inline bool simdDecodeTwoByteUtf8(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+    for ( ; end - src >= 32; src += 32, dst += 16) {
+        // separate the lead and the continuation bytes
+        const uint8x16x2_t in = vld2q_u8(src);
+        uint8x16_t valid = vandq_u8(vceqq_u8(vandq_u8(in.val[0], vdupq_n_u8(0xe0)), vdupq_n_u8(0xc0)),
+                                    vceqq_u8(vandq_u8(in.val[1], vdupq_n_u8(0xc0)), vdupq_n_u8(0x80)));
+        // lead bytes 0xc0 and 0xc1 would be overlong
+        valid = vandq_u8(valid, vtstq_u8(in.val[0], vdupq_n_u8(0x1e)));
+
+        const uint8x16_t lead = vandq_u8(in.val[0], vdupq_n_u8(0x1f));
+        const uint8x16_t continuation = vandq_u8(in.val[1], vdupq_n_u8(0x3f));
+        uint16_t *out = reinterpret_cast<uint16_t *>(dst);
+        vst1q_u16(out, vorrq_u16(vshll_n_u8(vget_low_u8(lead), 6), vmovl_u8(vget_low_u8(continuation))));
+        vst1q_u16(out + 8, vorrq_u16(vshll_n_u8(vget_high_u8(lead), 6),
+                                     vmovl_u8(vget_high_u8(continuation))));
+
+        // four bits per character
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(valid), 4)), 0);
+        if (~mask) {
+            // a run that doesn't fill the first block is faster in scalar
+            // code; otherwise, keep the valid characters before the first
+            // invalid one
+            if (src == start)
+                return false;
+            const uint n = qCountTrailingZeroBits(~mask) / 4;
+            src += 2 * n;
+            dst += n;
+            break;
+        }
+    }
+    return src != start;
+}
+
+// Same for three-byte sequences (U+0800 to U+FFFF, e.g. CJK text).
+static inline bool simdDecodeThreeByteUtf8(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+    for ( ; end - src >= 48; src += 48, dst += 16) {
+        const uint8x16x3_t in = vld3q_u8(src);
+        uint8x16_t valid = vandq_u8(vceqq_u8(vandq_u8(in.val[0], vdupq_n_u8(0xf0)), vdupq_n_u8(0xe0)),
+                                    vceqq_u8(vandq_u8(in.val[1], vdupq_n_u8(0xc0)), vdupq_n_u8(0x80)));
+        valid = vandq_u8(valid, vceqq_u8(vandq_u8(in.val[2], vdupq_n_u8(0xc0)), vdupq_n_u8(0x80)));
+        // no overlong sequences (E0 followed by less than A0) and no surrogates
+        // (ED followed by A0 or more)
+        const uint8x16_t overlong = vandq_u8(vceqq_u8(in.val[0], vdupq_n_u8(0xe0)),
+                                             vcltq_u8(in.val[1], vdupq_n_u8(0xa0)));
+        const uint8x16_t surrogate = vandq_u8(vceqq_u8(in.val[0], vdupq_n_u8(0xed)),
+                                              vcgeq_u8(in.val[1], vdupq_n_u8(0xa0)));
+        valid = vbicq_u8(valid, vorrq_u8(overlong, surrogate));
+
+        const uint8x16_t lead = vandq_u8(in.val[0], vdupq_n_u8(0x0f));
+        const uint8x16_t middle = vandq_u8(in.val[1], vdupq_n_u8(0x3f));
+        const uint8x16_t last = vandq_u8(in.val[2], vdupq_n_u8(0x3f));
+        auto combine = [](uint8x8_t lead, uint8x8_t middle, uint8x8_t last) {
+            return vorrq_u16(vshlq_n_u16(vmovl_u8(lead), 12),
+                             vorrq_u16(vshll_n_u8(middle, 6), vmovl_u8(last)));
+        };
+        uint16_t *out = reinterpret_cast<uint16_t *>(dst);
+        vst1q_u16(out, combine(vget_low_u8(lead), vget_low_u8(middle), vget_low_u8(last)));
+        vst1q_u16(out + 8, combine(vget_high_u8(lead), vget_high_u8(middle), vget_high_u8(last)));
+
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(valid), 4)), 0);
+        if (~mask) {
+            if (src == start)
+                return false;
+            const uint n = qCountTrailingZeroBits(~mask) / 4;
+            src += 3 * n;
+            dst += n;
+            break;
+        }
+    }
+    return src != start;
+}
+
+// Decodes a run of non-ASCII characters of the same UTF-8 length as the one
+// at src, if there is one worth decoding in SIMD. Short runs are faster in
+// scalar code, so check the last character of the first block before trying.
+static inline bool simdDecodeNonAscii(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    if (end - src < 32)
+        return false;
+    const uchar b = *src;
+    if (b >= 0xc2 && b < 0xe0 && src[30] >= 0xc2 && src[30] < 0xe0)
+        return simdDecodeTwoByteUtf8(dst, src, end);
+    if (end - src >= 48 && (b & 0xf0) == 0xe0 && (src[45] & 0xf0) == 0xe0)
+        return simdDecodeThreeByteUtf8(dst, src, end);
+    return false;
+}
+
+static inline bool simdEncodeNonAscii(uchar *&, const char16_t *&, const char16_t *)
+{
+    return false;
+}
 #else
 static inline bool simdEncodeAscii(uchar *, const char16_t *, const char16_t *, const char16_t *)
 {
@@ -462,6 +732,16 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 static void simdCompareAscii(const qchar8_t *&, const qchar8_t *, const char16_t *&, const char16_t *)
 {
 }
+
+static inline bool simdDecodeNonAscii(char16_t *&, const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static inline bool simdEncodeNonAscii(uchar *&, const char16_t *&, const char16_t *)
+{
+    return false;
+}
 #endif
 
 enum { HeaderDone = 1 };
@@ -480,6 +760,8 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        if (simdEncodeNonAscii(dst, src, end))
+            continue;
 
         do {
             char16_t u = *src++;
@@ -546,6 +828,8 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        if (simdEncodeNonAscii(cursor, src, end))
+            continue;
 
         do {
             char16_t uc = *src++;
@@ -649,6 +933,8 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in) noexcept
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
+            if (simdDecodeNonAscii(dst, src, end))
+                continue;
 
             do {
                 uchar b = *src++;
@@ -750,8 +1036,12 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in, QStringConve
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            if (simdDecodeNonAscii(dst, src, end))
+                continue;
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -804,6 +1094,15 @@ QUtf8::ValidUtf8Result QUtf8::isValidUtf8(QByteArrayView in)
         if (src == end)
             break;
 
+        // decode runs into a scratch buffer, which is large enough for as
+        // many characters as bytes
+        char16_t scratch[256];
+        char16_t *out = scratch;
+        if (simdDecodeNonAscii(out, src, src + qMin<qsizetype>(end - src, std::size(scratch)))) {
+            isValidAscii = false;
+            continue;
+        }
+
         do {
             uchar b = *src++;
             if ((b & 0x80) == 0)
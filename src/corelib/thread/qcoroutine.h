@@ -0,0 +1,307 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCOROUTINE_H
+#define QCOROUTINE_H
+
+#include <QtCore/qglobal.h>
+
+QT_REQUIRE_CONFIG(future);
+
+// Everything in here is inline, so it is available whenever the code
+// including this header is compiled with coroutine support, regardless of
+// the C++ standard Qt itself was built with.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+
+#include <QtCore/qfuture.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qpromise.h>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+template <typename T = void>
+class QCoroTask;
+
+namespace QtPrivate {
+
+// Base of promise types whose coroutines resume in the thread of a context object.
+struct QCoroutineContext
+{
+    QPointer<QObject> contextObject;
+    bool hasContextObject = false;
+};
+
+// Owns a suspended coroutine until it is resumed. If that never happens,
+// because the awaited operation was canceled or the context object is gone,
+// the coroutine frame is destroyed, which cancels the future of its task.
+// With a context object, the resumer must only be called in its thread,
+// which is also where it must be destroyed.
+class QCoroutineResumer
+{
+public:
+    template <typename Promise>
+    explicit QCoroutineResumer(std::coroutine_handle<Promise> handle)
+        : m_handle(handle)
+    {
+        if constexpr (std::is_base_of_v<QCoroutineContext, Promise>) {
+            m_context = handle.promise().contextObject;
+            m_hasContext = handle.promise().hasContextObject;
+        }
+    }
+
+    QCoroutineResumer(QCoroutineResumer &&other) noexcept
+        : m_handle(std::exchange(other.m_handle, {})),
+          m_context(std::move(other.m_context)),
+          m_hasContext(other.m_hasContext)
+    {
+    }
+    QCoroutineResumer &operator=(QCoroutineResumer &&) = delete;
+
+    ~QCoroutineResumer()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    bool hasContext() const noexcept { return m_hasContext; }
+    QObject *context() const noexcept { return m_context.data(); }
+
+    void operator()()
+    {
+        if (!m_handle)
+            return;
+        // the context can only be destroyed in its own thread, which is ours
+        if (m_hasContext && !m_context)
+            return; // the destructor gets rid of the coroutine
+        std::exchange(m_handle, {}).resume();
+    }
+
+private:
+    std::coroutine_handle<> m_handle;
+    QPointer<QObject> m_context;
+    bool m_hasContext = false;
+};
+
+template <typename T>
+class QFutureAwaiter
+{
+public:
+    explicit QFutureAwaiter(QFuture<T> future) : m_future(std::move(future)) { }
+
+    // A finished future does not suspend the coroutine at all. Canceled
+    // futures take the slow path, which ends the coroutine unless there is
+    // an exception to rethrow.
+    bool await_ready() const { return m_future.isFinished() && !m_future.isCanceled(); }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        // The continuation can run (and finish the coroutine) before then()
+        // returns, so don't touch any member afterwards.
+        QFuture<T> future = m_future;
+        QCoroutineResumer resumer(handle);
+        if (!resumer.hasContext()) {
+            future.then(QtFuture::Launch::Sync,
+                        [resumer = std::move(resumer)](const QFuture<T> &) mutable {
+                            resumer();
+                        });
+            return;
+        }
+
+        // The coroutine runs in the context's thread (or was started by code
+        // keeping the context alive), so the context can't go away meanwhile.
+        // Continuations with a context run, and are dropped, in its thread.
+        // Without a context left, the resumer ends the coroutine right here.
+        if (QObject *context = resumer.context()) {
+            future.then(context, [resumer = std::move(resumer)](const QFuture<T> &) mutable {
+                resumer();
+            });
+        }
+    }
+
+    T await_resume()
+    {
+        if constexpr (std::is_void_v<T>)
+            m_future.waitForFinished();
+        else if constexpr (std::is_copy_constructible_v<T>)
+            return m_future.result();
+        else
+            return m_future.takeResult();
+    }
+
+private:
+    QFuture<T> m_future;
+};
+
+template <typename T>
+class QCoroTaskPromiseBase : public QCoroutineContext
+{
+public:
+    explicit QCoroTaskPromiseBase(QObject *context = nullptr)
+    {
+        contextObject = context;
+        hasContextObject = context != nullptr;
+        m_promise.start();
+    }
+
+    // Coroutines that are members of a QObject subclass (or otherwise take a
+    // QObject as their first argument) resume in that object's thread.
+    template <typename First>
+    static QObject *contextFor(First &first)
+    {
+        if constexpr (std::is_base_of_v<QObject, std::remove_cv_t<First>>)
+            return const_cast<std::remove_cv_t<First> *>(&first);
+        else
+            return nullptr;
+    }
+
+    QCoroTask<T> get_return_object() { return QCoroTask<T>(m_promise.future()); }
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        m_promise.setException(std::current_exception());
+        m_promise.finish();
+#else
+        std::terminate();
+#endif
+    }
+
+protected:
+    QPromise<T> m_promise;
+};
+
+template <typename T>
+class QCoroTaskPromise : public QCoroTaskPromiseBase<T>
+{
+public:
+    QCoroTaskPromise() = default;
+    template <typename First, typename... Args>
+    QCoroTaskPromise(First &first, Args &...)
+        : QCoroTaskPromiseBase<T>(QCoroTaskPromiseBase<T>::contextFor(first))
+    {
+    }
+
+    template <typename U = T>
+    void return_value(U &&value)
+    {
+        this->m_promise.addResult(std::forward<U>(value));
+        this->m_promise.finish();
+    }
+};
+
+template <>
+class QCoroTaskPromise<void> : public QCoroTaskPromiseBase<void>
+{
+public:
+    QCoroTaskPromise() = default;
+    template <typename First, typename... Args>
+    QCoroTaskPromise(First &first, Args &...)
+        : QCoroTaskPromiseBase<void>(contextFor(first))
+    {
+    }
+
+    void return_void() { m_promise.finish(); }
+};
+
+} // namespace QtPrivate
+
+template <typename T>
+class QCoroTask
+{
+public:
+    using promise_type = QtPrivate::QCoroTaskPromise<T>;
+
+    QFuture<T> future() const { return m_future; }
+
+    QtPrivate::QFutureAwaiter<T> operator co_await() const
+    { return QtPrivate::QFutureAwaiter<T>(m_future); }
+
+private:
+    friend class QtPrivate::QCoroTaskPromiseBase<T>;
+    explicit QCoroTask(QFuture<T> future) : m_future(std::move(future)) { }
+
+    QFuture<T> m_future;
+};
+
+template <typename T>
+QtPrivate::QFutureAwaiter<T> operator co_await(QFuture<T> future)
+{
+    return QtPrivate::QFutureAwaiter<T>(std::move(future));
+}
+
+template <typename Sender, typename Signal>
+class QCoroSignal
+{
+public:
+    using Result = QtFuture::ArgsType<Signal>;
+
+    QCoroSignal(Sender *sender, Signal signal) : m_sender(sender), m_signal(signal) { }
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        QtPrivate::QCoroutineResumer resumer(handle);
+        // without a sender, or with its context gone, the coroutine ends here
+        if (!m_sender || (resumer.hasContext() && !resumer.context()))
+            return;
+
+        // With a context object the connection takes care of switching to
+        // its thread, otherwise the coroutine resumes in the emitting thread.
+        QObject *receiver = resumer.hasContext() ? resumer.context() : m_sender;
+        const auto type = Qt::ConnectionType(
+                Qt::SingleShotConnection
+                | (resumer.hasContext() ? Qt::AutoConnection : Qt::DirectConnection));
+
+        if constexpr (std::is_void_v<Result>) {
+            QObject::connect(m_sender, m_signal, receiver,
+                             [resumer = std::move(resumer)]() mutable { resumer(); }, type);
+        } else if constexpr (QtPrivate::ArgResolver<Signal>::HasExtraArgs) {
+            QObject::connect(m_sender, m_signal, receiver,
+                             [this, resumer = std::move(resumer)](auto... values) mutable {
+                                 m_result.emplace(QtPrivate::createTuple(std::move(values)...));
+                                 resumer();
+                             },
+                             type);
+        } else {
+            QObject::connect(m_sender, m_signal, receiver,
+                             [this, resumer = std::move(resumer)](Result value) mutable {
+                                 m_result.emplace(std::move(value));
+                                 resumer();
+                             },
+                             type);
+        }
+    }
+
+    Result await_resume()
+    {
+        if constexpr (!std::is_void_v<Result>)
+            return std::move(*m_result);
+    }
+
+private:
+    struct Empty { };
+    using Storage = std::conditional_t<std::is_void_v<Result>, Empty, std::optional<Result>>;
+
+    Sender *m_sender;
+    Signal m_signal;
+    Storage m_result;
+};
+
+QT_END_NAMESPACE
+
+#endif // __cpp_impl_coroutine
+
+#endif // QCOROUTINE_H
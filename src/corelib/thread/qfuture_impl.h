@@ -538,24 +538,24 @@ void Continuation<Function, ResultType, ParentResultType>::create(F &&func,
     auto continuation = [func = std::forward<F>(func), fi, promise_ = QPromise(fi), pool,
                          launchAsync](const QFutureInterfaceBase &parentData) mutable {
         const auto parent = QFutureInterface<ParentResultType>(parentData).future();
-        Continuation<Function, ResultType, ParentResultType> *continuationJob = nullptr;
         if (launchAsync) {
-            auto asyncJob = new AsyncContinuation<Function, ResultType, ParentResultType>(
+            auto continuationJob = new AsyncContinuation<Function, ResultType, ParentResultType>(
                     std::forward<Function>(func), parent, std::move(promise_), pool);
-            fi.setRunnable(asyncJob);
-            continuationJob = asyncJob;
+            fi.setRunnable(continuationJob);
+            bool isLaunched = continuationJob->execute();
+            // If continuation is successfully launched, AsyncContinuation will be deleted
+            // by the QThreadPool which has started it.
+            if (!isLaunched) {
+                delete continuationJob;
+                continuationJob = nullptr;
+            }
         } else {
-            continuationJob = new SyncContinuation<Function, ResultType, ParentResultType>(
+            // Synchronous continuations run to completion right here, so there
+            // is no need to allocate the job: every stage of a chain of .then()
+            // calls would otherwise cost an extra heap allocation.
+            SyncContinuation<Function, ResultType, ParentResultType> continuationJob(
                     std::forward<Function>(func), parent, std::move(promise_));
-        }
-
-        bool isLaunched = continuationJob->execute();
-        // If continuation is successfully launched, AsyncContinuation will be deleted
-        // by the QThreadPool which has started it. Synchronous continuation will be
-        // executed immediately, so it's safe to always delete it here.
-        if (!(launchAsync && isLaunched)) {
-            delete continuationJob;
-            continuationJob = nullptr;
+            continuationJob.execute();
         }
     };
     f->d.setContinuation(ContinuationWrapper(std::move(continuation)), fi.d);
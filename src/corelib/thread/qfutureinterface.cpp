@@ -158,21 +158,24 @@ QFutureInterfaceBase::~QFutureInterfaceBase()
         delete d;
 }
 
+// State changes are released, and queryState() acquires, so that a thread
+// seeing the Finished state also sees the results and the exception without
+// taking the mutex.
 static inline int switch_on(QAtomicInt &a, int which)
 {
-    return a.fetchAndOrRelaxed(which) | which;
+    return a.fetchAndOrRelease(which) | which;
 }
 
 static inline int switch_off(QAtomicInt &a, int which)
 {
-    return a.fetchAndAndRelaxed(~which) & ~which;
+    return a.fetchAndAndRelease(~which) & ~which;
 }
 
 static inline int switch_from_to(QAtomicInt &a, int from, int to)
 {
     const auto adjusted = [&](int old) { return (old & ~from) | to; };
     int value = a.loadRelaxed();
-    while (!a.testAndSetRelaxed(value, adjusted(value), value))
+    while (!a.testAndSetRelease(value, adjusted(value), value))
         qYieldCpu();
     return value;
 }
@@ -492,7 +495,7 @@ int QFutureInterfaceBase::expectedResultCount()
 
 bool QFutureInterfaceBase::queryState(State state) const
 {
-    return d->state.loadRelaxed() & state;
+    return d->state.loadAcquire() & state;
 }
 
 int QFutureInterfaceBase::loadState() const
@@ -500,13 +503,18 @@ int QFutureInterfaceBase::loadState() const
     // Used from ~QPromise, so this check is needed
     if (!d)
         return QFutureInterfaceBase::State::NoState;
-    return d->state.loadRelaxed();
+    return d->state.loadAcquire();
 }
 
 void QFutureInterfaceBase::waitForResult(int resultIndex)
 {
+    // Results aren't added once finished, so the common case of a
+    // continuation reading the result of its parent doesn't need the mutex
+    const bool finished = isFinished();
     if (d->hasException)
         d->data.m_exceptionStore.rethrowException();
+    if (finished)
+        return;
 
     QMutexLocker lock(&d->m_mutex);
     if (!isRunningOrPending())
@@ -529,14 +537,10 @@ void QFutureInterfaceBase::waitForResult(int resultIndex)
 
 void QFutureInterfaceBase::waitForFinished()
 {
-    QMutexLocker lock(&d->m_mutex);
-    const bool alreadyFinished = isFinished();
-    lock.unlock();
-
-    if (!alreadyFinished) {
+    if (!isFinished()) {
         d->pool()->d_func()->stealAndRunRunnable(d->runnable);
 
-        lock.relock();
+        QMutexLocker lock(&d->m_mutex);
 
         while (!isFinished())
             d->waitCondition.wait(&d->m_mutex);
@@ -911,7 +915,7 @@ void QFutureInterfaceBasePrivate::disconnectOutputInterface(QFutureCallOutInterf
 
 void QFutureInterfaceBasePrivate::setState(QFutureInterfaceBase::State newState)
 {
-    state.storeRelaxed(newState);
+    state.storeRelease(newState);
 }
 
 void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInterfaceBase &)> func)
@@ -924,6 +928,11 @@ void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInter
 {
     QMutexLocker lock(&d->continuationMutex);
 
+    // Pairs with the fence in runContinuation(): either it sees the flag and
+    // waits for the mutex, or we see the Finished state
+    d->hasContinuation.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
     // If the state is ready, run continuation immediately,
     // otherwise save it for later.
     if (isFinished()) {
@@ -957,6 +966,12 @@ void QFutureInterfaceBase::cleanContinuation()
 
 void QFutureInterfaceBase::runContinuation() const
 {
+    // Called once finished. Most futures, and the last one of every chain,
+    // never get a continuation, so don't lock for them; see setContinuation().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!d->hasContinuation.load(std::memory_order_relaxed))
+        return;
+
     QMutexLocker lock(&d->continuationMutex);
     if (d->continuation) {
         // Save the continuation in a local function, to avoid calling
@@ -0,0 +1,171 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qlockcontention_p.h"
+
+#include "qmutex.h"
+#include "qthread.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace QLockContention {
+
+namespace {
+
+constexpr int MinSpins = 8;
+constexpr int MaxSpins = 256;
+constexpr int EstimateSlots = 256;
+
+std::atomic<quint16> spinEstimates[EstimateSlots] = {};
+
+inline size_t slotIndex(const void *lock, size_t tableSize)
+{
+    // locks are at least pointer-aligned; mix the address so that locks in
+    // the same object don't all land next to each other
+    const quintptr key = quintptr(lock) >> 3;
+    return size_t((quint64(key) * Q_UINT64_C(0x9E3779B97F4A7C15)) >> 32) % tableSize;
+}
+
+bool spinningIsUseful()
+{
+    // with a single CPU the lock holder can't make progress while we spin
+    static const bool useful = QThread::idealThreadCount() > 1;
+    return useful;
+}
+
+} // unnamed namespace
+
+Spinner::Spinner(const void *lock) noexcept
+    : m_estimate(&spinEstimates[slotIndex(lock, EstimateSlots)]),
+      m_budget(0)
+{
+    if (spinningIsUseful()) {
+        const int estimate = m_estimate->load(std::memory_order_relaxed);
+        m_budget = std::min(2 * estimate + MinSpins, MaxSpins);
+    }
+}
+
+void Spinner::acquiredAfter(int spins) noexcept
+{
+    // exponential moving average with a weight of 1/8, like glibc's adaptive
+    // mutexes; lost updates from concurrent spinners don't matter
+    const int estimate = m_estimate->load(std::memory_order_relaxed);
+    m_estimate->store(quint16(estimate + (spins - estimate) / 8), std::memory_order_relaxed);
+}
+
+void Spinner::spinFailed() noexcept
+{
+    // the lock was held for longer than we were willing to spin, so spin
+    // less next time
+    const int estimate = m_estimate->load(std::memory_order_relaxed);
+    m_estimate->store(quint16(estimate - (estimate + 7) / 8), std::memory_order_relaxed);
+}
+
+#if QT_CONFIG(lock_statistics)
+namespace {
+
+constexpr int StatisticsSlots = 4096;
+constexpr int MaxProbes = 16;
+
+struct StatisticsSlot
+{
+    std::atomic<const void *> lock = nullptr;
+    std::atomic<quint64> acquisitions = 0;
+    std::atomic<quint64> contendedAcquisitions = 0;
+    std::atomic<quint64> spinAcquisitions = 0;
+    std::atomic<quint64> waitTime = 0;
+};
+
+StatisticsSlot statisticsTable[StatisticsSlots];
+
+// Returns the slot of \a lock, claiming a free one if \a create is set.
+StatisticsSlot *findSlot(const void *lock, bool create)
+{
+    const size_t start = slotIndex(lock, StatisticsSlots);
+    for (int probe = 0; probe < MaxProbes; ++probe) {
+        StatisticsSlot &slot = statisticsTable[(start + probe) % StatisticsSlots];
+        const void *owner = slot.lock.load(std::memory_order_acquire);
+        if (owner == lock)
+            return &slot;
+        if (owner)
+            continue;
+        if (!create)
+            return nullptr;
+        if (slot.lock.compare_exchange_strong(owner, lock, std::memory_order_acq_rel)
+                || owner == lock) {
+            return &slot;
+        }
+    }
+    return nullptr; // table full around here, drop it
+}
+
+} // unnamed namespace
+
+void WaitRecorder::acquired(bool bySpinning) const noexcept
+{
+    const auto waited = std::chrono::steady_clock::now() - m_start;
+    if (StatisticsSlot *slot = findSlot(m_lock, true)) {
+        slot->contendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (bySpinning)
+            slot->spinAcquisitions.fetch_add(1, std::memory_order_relaxed);
+        slot->waitTime.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count(),
+                std::memory_order_relaxed);
+    }
+}
+
+/*!
+    \internal
+
+    Returns the counters collected for the QMutex or QReadWriteLock at
+    \a lock. Locks the table had no room for report all zeros.
+*/
+Statistics statistics(const void *lock)
+{
+    Statistics result;
+    if (const StatisticsSlot *slot = findSlot(lock, false)) {
+        result.acquisitions = slot->acquisitions.load(std::memory_order_relaxed);
+        result.contendedAcquisitions = slot->contendedAcquisitions.load(std::memory_order_relaxed);
+        result.spinAcquisitions = slot->spinAcquisitions.load(std::memory_order_relaxed);
+        result.waitTime = std::chrono::nanoseconds(slot->waitTime.load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Forgets all collected counters. Locks acquired concurrently may keep
+    part of their counts.
+*/
+void resetStatistics()
+{
+    for (StatisticsSlot &slot : statisticsTable) {
+        slot.lock.store(nullptr, std::memory_order_relaxed);
+        slot.acquisitions.store(0, std::memory_order_relaxed);
+        slot.contendedAcquisitions.store(0, std::memory_order_relaxed);
+        slot.spinAcquisitions.store(0, std::memory_order_relaxed);
+        slot.waitTime.store(0, std::memory_order_relaxed);
+    }
+}
+#endif // QT_CONFIG(lock_statistics)
+
+} // namespace QLockContention
+
+#if QT_CONFIG(lock_statistics)
+/*!
+    \internal
+
+    Counts an acquisition of the lock at \a lock. Contended acquisitions are
+    additionally reported through QLockContention::WaitRecorder.
+*/
+void QtPrivate::lockAcquired(const void *lock) noexcept
+{
+    if (auto slot = QLockContention::findSlot(lock, true))
+        slot->acquisitions.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+QT_END_NAMESPACE
@@ -0,0 +1,119 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QLOCKCONTENTION_P_H
+#define QLOCKCONTENTION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists for the convenience of
+// qmutex.cpp and qreadwritelock.cpp. This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qyieldcpu.h>
+
+#include <atomic>
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+namespace QLockContention {
+
+// Spin-then-park policy for contended locks. Before a thread goes to sleep
+// waiting for a lock, it spins for a while, re-trying to acquire it. How long
+// is learned per lock: each successful spin updates a running average of the
+// spin iterations that were needed, which tracks the average time the lock is
+// held while others wait for it. Locks that are held for long stop spinning.
+//
+// The averages live in a small table indexed by the lock's address, so two
+// locks can occasionally share (and disturb) an estimate; that only affects
+// performance.
+class Spinner
+{
+public:
+    explicit Spinner(const void *lock) noexcept;
+
+    // Calls tryAcquire() until it returns true or the spin budget for this
+    // lock is exhausted. Returns whether the lock was acquired.
+    template <typename TryAcquire>
+    bool spin(TryAcquire tryAcquire) noexcept
+    {
+        for (int i = 1; i <= m_budget; ++i) {
+            qYieldCpu();
+            if (tryAcquire()) {
+                acquiredAfter(i);
+                return true;
+            }
+        }
+        if (m_budget)
+            spinFailed();
+        return false;
+    }
+
+private:
+    void acquiredAfter(int spins) noexcept;
+    void spinFailed() noexcept;
+
+    std::atomic<quint16> *m_estimate;
+    int m_budget;
+};
+
+#if QT_CONFIG(lock_statistics)
+// Per-lock counters, kept for as many locks as fit in a fixed-size table.
+// Statistics of a destroyed lock carry over to the next one allocated at the
+// same address.
+struct Statistics
+{
+    quint64 acquisitions = 0;           // all successful lock operations
+    quint64 contendedAcquisitions = 0;  // ... that found the lock taken
+    quint64 spinAcquisitions = 0;       // ... and got it by spinning
+    std::chrono::nanoseconds waitTime = {}; // spent in contended acquisitions
+};
+
+Q_CORE_EXPORT Statistics statistics(const void *lock);
+Q_CORE_EXPORT void resetStatistics();
+
+// Measures one contended acquisition, from construction to acquired(). The
+// acquisition itself is counted with countAcquisition().
+class WaitRecorder
+{
+public:
+    explicit WaitRecorder(const void *lock) noexcept
+        : m_lock(lock), m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    void acquired(bool bySpinning = false) const noexcept;
+
+private:
+    const void *m_lock;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+inline void countAcquisition(const void *lock) noexcept
+{
+    QtPrivate::lockAcquired(lock);
+}
+#else
+class WaitRecorder
+{
+public:
+    explicit WaitRecorder(const void *) noexcept { }
+    void acquired(bool = false) const noexcept { }
+};
+
+inline void countAcquisition(const void *) noexcept { }
+#endif
+
+} // namespace QLockContention
+
+QT_END_NAMESPACE
+
+#endif // QLOCKCONTENTION_P_H
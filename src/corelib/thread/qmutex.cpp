@@ -11,6 +11,9 @@
 #include "qfutex_p.h"
 #include "qthread.h"
 #include "qmutex_p.h"
+#include "qlockcontention_p.h"
+
+#include <qtcore_tracepoints_p.h>
 
 #ifndef QT_ALWAYS_USE_FUTEX
 #include "private/qfreelist_p.h"
@@ -18,12 +21,40 @@
 
 QT_BEGIN_NAMESPACE
 
+Q_TRACE_POINT(qtcore, QMutex_lockContended_entry, const void *mutex);
+Q_TRACE_POINT(qtcore, QMutex_lockContended_exit, bool acquired);
+
 using namespace QtFutex;
 static inline QMutexPrivate *dummyFutexValue()
 {
     return reinterpret_cast<QMutexPrivate *>(quintptr(3));
 }
 
+namespace {
+// One trip through the slow path of QBasicMutex::lockInternal(), from
+// finding the mutex locked to acquiring it or giving up.
+class ContendedAcquisition
+{
+public:
+    explicit ContendedAcquisition(const QBasicMutex *mutex) noexcept
+        : m_recorder(mutex)
+    {
+        Q_TRACE(QMutex_lockContended_entry, mutex);
+    }
+    ~ContendedAcquisition() { Q_TRACE(QMutex_lockContended_exit, m_acquired); }
+
+    void acquired(bool bySpinning = false) noexcept
+    {
+        m_recorder.acquired(bySpinning);
+        m_acquired = true;
+    }
+
+private:
+    QLockContention::WaitRecorder m_recorder;
+    bool m_acquired = false;
+};
+} // unnamed namespace
+
 /*
     \class QBasicMutex
     \inmodule QtCore
@@ -640,6 +671,16 @@ void QRecursiveMutex::unlock() noexcept
 void QBasicMutex::lockInternal() QT_MUTEX_LOCK_NOEXCEPT
 {
     if (futexAvailable()) {
+        ContendedAcquisition recorder(this);
+
+        // critical sections are usually short, so spin a little before
+        // going to sleep
+        QLockContention::Spinner spinner(this);
+        if (spinner.spin([this] { return fastTryLock(); })) {
+            recorder.acquired(true);
+            return;
+        }
+
         // note we must set to dummyFutexValue because there could be other threads
         // also waiting
         while (d_ptr.fetchAndStoreAcquire(dummyFutexValue()) != nullptr) {
@@ -649,6 +690,8 @@ void QBasicMutex::lockInternal() QT_MUTEX_LOCK_NOEXCEPT
             // we got woken up, so try to acquire the mutex
         }
         Q_ASSERT(d_ptr.loadRelaxed());
+        QLockContention::countAcquisition(this);
+        recorder.acquired();
     } else {
         lockInternal(-1);
     }
@@ -681,11 +724,24 @@ bool QBasicMutex::lockInternal(QDeadlineTimer deadlineTimer) QT_MUTEX_LOCK_NOEXC
             return true;
         }
 
+        ContendedAcquisition recorder(this);
+        QLockContention::Spinner spinner(this);
+        if (spinner.spin([this] { return fastTryLock(); })) {
+            recorder.acquired(true);
+            return true;
+        }
+
+        const auto acquired = [&] {
+            QLockContention::countAcquisition(this);
+            recorder.acquired();
+            return true;
+        };
+
         // The mutex is already locked, set a bit indicating we're waiting.
         // Note we must set to dummyFutexValue because there could be other threads
         // also waiting.
         if (d_ptr.fetchAndStoreAcquire(dummyFutexValue()) == nullptr)
-            return true;
+            return acquired();
 
         for (;;) {
             if (!futexWait(d_ptr, dummyFutexValue(), deadlineTimer))
@@ -695,7 +751,7 @@ bool QBasicMutex::lockInternal(QDeadlineTimer deadlineTimer) QT_MUTEX_LOCK_NOEXC
             // to dummyFutexValue() again because there could be other threads
             // waiting.
             if (d_ptr.fetchAndStoreAcquire(dummyFutexValue()) == nullptr)
-                return true;
+                return acquired();
 
             if (deadlineTimer.hasExpired())
                 return false;
@@ -703,6 +759,13 @@ bool QBasicMutex::lockInternal(QDeadlineTimer deadlineTimer) QT_MUTEX_LOCK_NOEXC
     }
 
 #if !defined(QT_ALWAYS_USE_FUTEX)
+    ContendedAcquisition recorder(this);
+    QLockContention::Spinner spinner(this);
+    if (spinner.spin([this] { return fastTryLock(); })) {
+        recorder.acquired(true);
+        return true;
+    }
+
     while (!fastTryLock()) {
         QMutexPrivate *copy = d_ptr.loadAcquire();
         if (!copy) // if d is 0, the mutex is unlocked
@@ -755,6 +818,8 @@ bool QBasicMutex::lockInternal(QDeadlineTimer deadlineTimer) QT_MUTEX_LOCK_NOEXC
                 if (d_ptr.testAndSetAcquire(d, dummyLocked())) {
                     // Mutex acquired
                     d->deref();
+                    QLockContention::countAcquisition(this);
+                    recorder.acquired();
                     return true;
                 } else {
                     Q_ASSERT(d != d_ptr.loadRelaxed()); //else testAndSetAcquire should have succeeded
@@ -784,6 +849,8 @@ bool QBasicMutex::lockInternal(QDeadlineTimer deadlineTimer) QT_MUTEX_LOCK_NOEXC
             d->derefWaiters(1);
             //we got the lock. (do not deref)
             Q_ASSERT(d == d_ptr.loadRelaxed());
+            QLockContention::countAcquisition(this);
+            recorder.acquired();
             return true;
         } else {
             // timed out
@@ -800,6 +867,7 @@ bool QBasicMutex::lockInternal(QDeadlineTimer deadlineTimer) QT_MUTEX_LOCK_NOEXC
         }
     }
     Q_ASSERT(d_ptr.loadRelaxed() != 0);
+    recorder.acquired();
     return true;
 #else
     Q_UNREACHABLE();
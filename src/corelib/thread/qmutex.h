@@ -25,6 +25,12 @@ class QMutex;
 class QRecursiveMutex;
 class QMutexPrivate;
 
+#if QT_CONFIG(lock_statistics)
+namespace QtPrivate {
+Q_CORE_EXPORT void lockAcquired(const void *lock) noexcept;
+}
+#endif
+
 class Q_CORE_EXPORT QBasicMutex
 {
     Q_DISABLE_COPY_MOVE(QBasicMutex)
@@ -76,7 +82,14 @@ private:
     {
         if (d_ptr.loadRelaxed() != nullptr)
             return false;
+#if QT_CONFIG(lock_statistics)
+        if (!d_ptr.testAndSetAcquire(nullptr, dummyLocked()))
+            return false;
+        QtPrivate::lockAcquired(this);
+        return true;
+#else
         return d_ptr.testAndSetAcquire(nullptr, dummyLocked());
+#endif
     }
     inline bool fastTryUnlock() noexcept {
         return d_ptr.testAndSetRelease(dummyLocked(), nullptr);
@@ -8,10 +8,12 @@
 
 #include "qthread.h"
 #include "qreadwritelock_p.h"
+#include "qlockcontention_p.h"
 #include "private/qfreelist_p.h"
 #include "private/qlocking_p.h"
 
 #include <algorithm>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -36,6 +38,52 @@ const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintp
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
+
+// Spins at most once per lock operation and records contention statistics
+// for operations that had to wait.
+class ContentionTracker
+{
+public:
+    explicit ContentionTracker(const void *lock) : m_lock(lock) { }
+
+    template <typename Released>
+    bool spin(Released released)
+    {
+        startWaiting();
+        if (m_spun)
+            return false;
+        m_spun = true;
+        QLockContention::Spinner spinner(m_lock);
+        m_spinSucceeded = spinner.spin(released);
+        return m_spinSucceeded;
+    }
+
+    // about to sleep on the lock's private mutex
+    void park()
+    {
+        startWaiting();
+        m_spinSucceeded = false;
+    }
+
+    bool acquired() const
+    {
+        if (m_recorder)
+            m_recorder->acquired(m_spinSucceeded);
+        return true;
+    }
+
+private:
+    void startWaiting()
+    {
+        if (!m_recorder)
+            m_recorder.emplace(m_lock);
+    }
+
+    const void *m_lock;
+    std::optional<QLockContention::WaitRecorder> m_recorder;
+    bool m_spun = false;
+    bool m_spinSucceeded = false;
+};
 }
 
 static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
@@ -185,19 +233,25 @@ bool QReadWriteLock::tryLockForRead(QDeadlineTimer timeout)
 {
     // Fast case: non contended:
     QReadWriteLockPrivate *d = d_ptr.loadRelaxed();
-    if (d == nullptr && d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
+    if (d == nullptr && d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d)) {
+        QLockContention::countAcquisition(this);
         return true;
-    return contendedTryLockForRead(d_ptr, timeout, d);
+    }
+    const bool locked = contendedTryLockForRead(d_ptr, timeout, d);
+    if (locked)
+        QLockContention::countAcquisition(this);
+    return locked;
 }
 
 Q_NEVER_INLINE static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
                                                    QDeadlineTimer timeout, QReadWriteLockPrivate *d)
 {
+    ContentionTracker contention(&d_ptr);
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
                 continue;
-            return true;
+            return contention.acquired();
         }
 
         if ((quintptr(d) & StateMask) == StateLockedForRead) {
@@ -207,13 +261,17 @@ Q_NEVER_INLINE static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLock
                        "Overflow in lock counter");
             if (!d_ptr.testAndSetAcquire(d, val, d))
                 continue;
-            return true;
+            return contention.acquired();
         }
 
         if (d == dummyLockedForWrite) {
             if (timeout.hasExpired())
                 return false;
 
+            // the writer is likely done soon, wait for it without sleeping
+            if (contention.spin([&] { return (d = d_ptr.loadAcquire()) != dummyLockedForWrite; }))
+                continue;
+
             // locked for write, assign a d_ptr and wait.
             auto val = QReadWriteLockPrivate::allocate();
             val->writerCount = 1;
@@ -230,6 +288,7 @@ Q_NEVER_INLINE static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLock
         if (d->recursive)
             return d->recursiveLockForRead(timeout);
 
+        contention.park();
         auto lock = qt_unique_lock(d->mutex);
         if (d != d_ptr.loadRelaxed()) {
             // d_ptr has changed: this QReadWriteLock was unlocked before we had
@@ -241,7 +300,7 @@ Q_NEVER_INLINE static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLock
             d = d_ptr.loadAcquire();
             continue;
         }
-        return d->lockForRead(lock, timeout);
+        return d->lockForRead(lock, timeout) && contention.acquired();
     }
 }
 
@@ -300,25 +359,35 @@ bool QReadWriteLock::tryLockForWrite(QDeadlineTimer timeout)
 {
     // Fast case: non contended:
     QReadWriteLockPrivate *d = d_ptr.loadRelaxed();
-    if (d == nullptr && d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
+    if (d == nullptr && d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d)) {
+        QLockContention::countAcquisition(this);
         return true;
-    return contendedTryLockForWrite(d_ptr, timeout, d);
+    }
+    const bool locked = contendedTryLockForWrite(d_ptr, timeout, d);
+    if (locked)
+        QLockContention::countAcquisition(this);
+    return locked;
 }
 
 Q_NEVER_INLINE static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
                                                     QDeadlineTimer timeout, QReadWriteLockPrivate *d)
 {
+    ContentionTracker contention(&d_ptr);
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(d, dummyLockedForWrite, d))
                 continue;
-            return true;
+            return contention.acquired();
         }
 
         if (isUncontendedLocked(d)) {
             if (timeout.hasExpired())
                 return false;
 
+            // the current owners are likely done soon, wait for them without sleeping
+            if (contention.spin([&] { return !isUncontendedLocked(d = d_ptr.loadAcquire()); }))
+                continue;
+
             // locked for either read or write, assign a d_ptr and wait.
             auto val = QReadWriteLockPrivate::allocate();
             if (d == dummyLockedForWrite)
@@ -338,6 +407,7 @@ Q_NEVER_INLINE static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLoc
         if (d->recursive)
             return d->recursiveLockForWrite(timeout);
 
+        contention.park();
         auto lock = qt_unique_lock(d->mutex);
         if (d != d_ptr.loadRelaxed()) {
             // The mutex was unlocked before we had time to lock the mutex.
@@ -346,7 +416,7 @@ Q_NEVER_INLINE static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLoc
             d = d_ptr.loadAcquire();
             continue;
         }
-        return d->lockForWrite(lock, timeout);
+        return d->lockForWrite(lock, timeout) && contention.acquired();
     }
 }
 
@@ -81,6 +81,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    flushPostEventInbox();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -93,6 +94,15 @@ QThreadData::~QThreadData()
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
+void QThreadData::flushPostEventInbox()
+{
+    const qsizetype flushed = postEventList.inbox.drain([this](QObject *receiver, QEvent *event) {
+        postEventList.addEvent(QPostEvent(receiver, event, Qt::NormalEventPriority));
+    });
+    if (flushed)
+        canWait = false;
+}
+
 void QThreadData::ref()
 {
 #if QT_CONFIG(thread)
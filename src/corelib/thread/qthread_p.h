@@ -26,10 +26,12 @@
 #endif
 #include "QtCore/qmap.h"
 #include "QtCore/qcoreapplication.h"
+#include "QtCore/qyieldcpu.h"
 #include "private/qobject_p.h"
 
 #include <algorithm>
 #include <atomic>
+#include <new>
 
 QT_BEGIN_NAMESPACE
 
@@ -56,6 +58,133 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// Bounded multi-producer, single-consumer ring of posted events (after
+// Dmitry Vyukov's bounded queue). QCoreApplication::postEvent() pushes
+// queued slot invocations here without taking QPostEventList::mutex; whoever
+// holds that mutex next moves them into the list, so per-producer ordering is
+// preserved relative to events posted through the locked path.
+class QPostEventInbox
+{
+    Q_DISABLE_COPY_MOVE(QPostEventInbox)
+public:
+    static constexpr size_t Capacity = 256;
+
+    QPostEventInbox() = default;
+    ~QPostEventInbox() { delete[] cells.loadRelaxed(); }
+
+    // Producer side. A producer must enter() before checking that the receiver
+    // still belongs to this list's thread and leave() once it has pushed.
+    bool enter() noexcept
+    {
+        producers.ref();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (Q_LIKELY(!blocked.loadRelaxed()))
+            return true;
+        producers.deref();
+        return false;
+    }
+    void leave() noexcept { producers.deref(); }
+
+    // returns false if the ring is full
+    bool push(QObject *receiver, QEvent *event) noexcept
+    {
+        Cell *buffer = cells.loadAcquire();
+        if (!buffer && !(buffer = allocateCells()))
+            return false;
+
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = buffer[pos % Capacity];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = qptrdiff(seq) - qptrdiff(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.receiver = receiver;
+                    cell.event = event;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer side, QPostEventList::mutex must be held.
+    template <typename Consumer>
+    qsizetype drain(Consumer consumer)
+    {
+        Cell *buffer = cells.loadAcquire();
+        if (!buffer)
+            return 0;
+
+        qsizetype count = 0;
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = buffer[pos % Capacity];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                break;
+            QObject *receiver = cell.receiver;
+            QEvent *event = cell.event;
+            cell.sequence.store(pos + Capacity, std::memory_order_release);
+            dequeuePos.store(++pos, std::memory_order_relaxed);
+            ++count;
+            consumer(receiver, event);
+        }
+        return count;
+    }
+
+    // Stops producers from entering and waits for those already in to leave.
+    // Used by QObject::moveToThread() with QPostEventList::mutex held.
+    void block() noexcept
+    {
+        blocked.storeRelaxed(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (producers.loadAcquire())
+            qYieldCpu();
+    }
+    void unblock() noexcept { blocked.storeRelease(0); }
+
+    // includes pushes that are still in progress
+    qsizetype size() const noexcept
+    {
+        return qsizetype(enqueuePos.load(std::memory_order_relaxed)
+                         - dequeuePos.load(std::memory_order_relaxed));
+    }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        QObject *receiver;
+        QEvent *event;
+    };
+
+    Cell *allocateCells() noexcept
+    {
+        Cell *buffer = new (std::nothrow) Cell[Capacity];
+        if (!buffer)
+            return nullptr;
+        for (size_t i = 0; i < Capacity; ++i)
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        Cell *other;
+        if (!cells.testAndSetOrdered(nullptr, buffer, other)) {
+            delete[] buffer;
+            return other;
+        }
+        return buffer;
+    }
+
+    QAtomicPointer<Cell> cells;
+    QAtomicInt producers;
+    QAtomicInt blocked;
+    alignas(64) std::atomic<size_t> enqueuePos = 0;
+    alignas(64) std::atomic<size_t> dequeuePos = 0;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 // It's used in a virtual in QCoreApplication, so ELFVERSION:ignore-next
@@ -72,6 +201,9 @@ public:
 
     QMutex mutex;
 
+    // events posted without taking mutex, see QThreadData::flushPostEventInbox()
+    QPostEventInbox inbox;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev);
@@ -307,9 +439,13 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && postEventList.inbox.isEmpty();
     }
 
+    // moves the events pushed into postEventList.inbox into postEventList;
+    // postEventList.mutex must be held
+    void flushPostEventInbox();
+
 private:
     QAtomicInt _ref;
 
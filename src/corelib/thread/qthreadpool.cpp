@@ -6,6 +6,8 @@
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
 
+#include <qtcore_tracepoints_p.h>
+
 #include <algorithm>
 #include <memory>
 
@@ -13,6 +15,11 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+Q_TRACE_POINT(qtcore, QThreadPool_enqueue, const void *pool, const void *runnable, int priority, int queuedTasks);
+Q_TRACE_POINT(qtcore, QThreadPool_dequeue, const void *pool, const void *runnable, int queuedTasks);
+Q_TRACE_POINT(qtcore, QThreadPool_run_entry, const void *runnable);
+Q_TRACE_POINT(qtcore, QThreadPool_run_exit);
+
 /*
     QThread wrapper, provides synchronization against a ThreadPool
 */
@@ -23,12 +30,22 @@ public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
     void run() override;
     void registerThreadInactive();
+    QRunnable *takeLocalTask();
+    void giveBackLocalTasks();
 
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // Tasks started from this thread in work-stealing mode. The owner pushes
+    // and pops at the back; other threads steal from the front. The mutex is
+    // only contended while another thread is stealing.
+    QMutex localMutex;
+    QList<QRunnable *> localQueue;
 };
 
+Q_CONSTINIT static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -48,6 +65,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -55,37 +73,50 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                // run the task, followed by the ones it started locally
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        Q_TRACE_SCOPE(QThreadPool_run, r);
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+                } while ((r = takeLocalTask()));
                 locker.relock();
             }
 
             // if too many threads are active, stop working in this one
-            if (manager->tooManyThreadsActive())
+            if (manager->tooManyThreadsActive()) {
+                giveBackLocalTasks();
                 break;
+            }
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
-                break;
+            if (manager->queue.isEmpty()) {
+                // all work is done, unless this or another thread queued some
+                // locally; with the queue empty there is no higher priority
+                // task to wait for
+                r = takeLocalTask();
+                if (!r)
+                    r = manager->stealTask(this);
+                if (!r)
+                    break;
+                continue;
+            }
 
             QueuePage *page = manager->queue.constFirst();
             r = page->pop();
@@ -94,6 +125,10 @@ void QThreadPoolThread::run()
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updatePriorityHint();
+            if (Q_TRACE_ENABLED(QThreadPool_dequeue)) {
+                Q_UNCONDITIONAL_TRACE(QThreadPool_dequeue, manager, r, manager->queuedTaskCount());
+            }
         } while (true);
 
         // this thread is about to be deleted, do not wait or expire
@@ -106,10 +141,12 @@ void QThreadPoolThread::run()
         if (manager->tooManyThreadsActive()) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->spareThreads.storeRelaxed(1);
             return;
         }
         manager->waitingThreads.enqueue(this);
         registerThreadInactive();
+        manager->spareThreads.storeRelaxed(1);
         // wait for work, exiting after the expiry timeout is reached
         runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
         // this thread is about to be deleted, do not work or expire
@@ -131,6 +168,37 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+/*
+    \internal
+
+    Returns the most recently started local task, or \nullptr if there is
+    none or tasks of a higher priority are waiting in the shared queue.
+*/
+QRunnable *QThreadPoolThread::takeLocalTask()
+{
+    if (manager->priorityTaskQueued.loadRelaxed())
+        return nullptr;
+
+    QMutexLocker locker(&localMutex);
+    if (localQueue.isEmpty())
+        return nullptr;
+    return localQueue.takeLast();
+}
+
+/*
+    \internal
+
+    Moves the local tasks to the shared queue, so that they are not lost when
+    this thread stops working. Must be called with the pool mutex held.
+*/
+void QThreadPoolThread::giveBackLocalTasks()
+{
+    QMutexLocker locker(&localMutex);
+    for (QRunnable *r : std::as_const(localQueue))
+        manager->enqueueTask(r);
+    localQueue.clear();
+}
+
 
 /*
     \internal
@@ -188,14 +256,107 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    const auto traceEnqueue = qScopeGuard([&] {
+        if (Q_TRACE_ENABLED(QThreadPool_enqueue)) {
+            Q_UNCONDITIONAL_TRACE(QThreadPool_enqueue, this, runnable, priority, queuedTaskCount());
+        }
+    });
     for (QueuePage *page : std::as_const(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
+            updatePriorityHint();
             return;
         }
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updatePriorityHint();
+}
+
+/*!
+    \internal
+
+    Returns the number of tasks waiting in the shared queue. Must be called
+    with the mutex locked.
+*/
+int QThreadPoolPrivate::queuedTaskCount() const
+{
+    int count = 0;
+    for (const QueuePage *page : queue)
+        count += page->size();
+    return count;
+}
+
+/*!
+    \internal
+
+    In work-stealing mode, queues \a task on the calling thread's own queue if
+    it is a thread of this pool, and returns \c true. Otherwise, returns
+    \c false and \a task has to go through the shared queue.
+*/
+bool QThreadPoolPrivate::pushLocalTask(QRunnable *task)
+{
+    if (!workStealing.loadRelaxed())
+        return false;
+
+    QThreadPoolThread *self = currentPoolThread;
+    if (!self || self->manager != this)
+        return false;
+
+    {
+        QMutexLocker locker(&self->localMutex);
+        self->localQueue.append(task);
+    }
+
+    // give an idle thread the chance to steal it
+    if (spareThreads.loadRelaxed()) {
+        QMutexLocker locker(&mutex);
+        tryToStartThief();
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Takes the oldest task from the local queue of another thread. Must be
+    called with the mutex held.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        if (thread == thief)
+            continue;
+        QMutexLocker locker(&thread->localMutex);
+        if (!thread->localQueue.isEmpty())
+            return thread->localQueue.takeFirst();
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Wakes up or starts a thread without a task of its own, so that it steals
+    one. Must be called with the mutex held.
+*/
+void QThreadPoolPrivate::tryToStartThief()
+{
+    if (!areAllThreadsActive()) {
+        if (!waitingThreads.isEmpty()) {
+            waitingThreads.takeFirst()->runnableReady.wakeOne();
+        } else if (!expiredThreads.isEmpty()) {
+            QThreadPoolThread *thread = expiredThreads.dequeue();
+            Q_ASSERT(thread->runnable == nullptr);
+            ++activeThreads;
+            thread->wait();
+            Q_ASSERT(thread->isFinished());
+            thread->start(threadPriority);
+        } else {
+            startThread();
+        }
+    }
+    updateSpareThreadsHint();
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -221,6 +382,8 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updatePriorityHint();
+    updateSpareThreadsHint();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -240,7 +403,7 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
+    // a thread started without a runnable looks for work to steal
     auto thread = std::make_unique<QThreadPoolThread>(this);
     if (objectName.isEmpty())
         objectName = u"Thread (pooled)"_s;
@@ -321,6 +484,19 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updatePriorityHint();
+
+    // tasks queued locally by the threads in work-stealing mode
+    QList<QRunnable *> localTasks;
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        localTasks.append(std::exchange(thread->localQueue, {}));
+    }
+    locker.unlock();
+    for (QRunnable *r : std::as_const(localTasks)) {
+        if (r->autoDelete())
+            delete r;
+    }
 }
 
 /*!
@@ -354,10 +530,17 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                 d->queue.removeOne(page);
                 delete page;
             }
+            d->updatePriorityHint();
             return true;
         }
     }
 
+    for (QThreadPoolThread *thread : std::as_const(d->allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (thread->localQueue.removeOne(runnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -503,6 +686,10 @@ QThreadPool *QThreadPoolPrivate::qtGuiInstance()
     ownership of \a runnable remains with the caller. Note that
     changing the auto-deletion on \a runnable after calling this
     functions results in undefined behavior.
+
+    If \l workStealingEnabled is \c true and this function is called with the
+    default \a priority from one of the pool's own threads, \a runnable is
+    queued on that thread instead.
 */
 void QThreadPool::start(QRunnable *runnable, int priority)
 {
@@ -510,6 +697,9 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->pushLocalTask(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
@@ -734,6 +924,41 @@ QThread::Priority QThreadPool::threadPriority() const
     return d->threadPriority;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \brief whether runnables started from the pool's own threads are queued
+    on those threads.
+
+    By default, all runnables go through one run queue shared by all threads
+    of the pool. When this property is \c true, a runnable started with the
+    default priority from inside another runnable of the same pool is queued
+    on the thread that started it instead. Each thread runs its own runnables
+    most-recently-started first, and threads that run out of work take the
+    oldest runnables queued by other threads. This avoids contention on the
+    shared queue when runnables spawn many small runnables.
+
+    Runnables queued with a priority other than the default, or from threads
+    that do not belong to the pool, still go through the shared queue, and
+    runnables with a higher priority in that queue are run before locally
+    queued ones. waitForDone(), clear() and tryTake() take the locally
+    queued runnables into account.
+
+    The default value is \c false.
+
+    \since 6.7
+*/
+
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.storeRelaxed(enabled);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.loadRelaxed();
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -100,6 +100,9 @@ public:
 
     int priority() const { return m_priority; }
 
+    // includes the entries cleared by tryTake()
+    int size() const { return m_lastIndex - m_firstIndex + 1; }
+
 private:
     int m_priority = 0;
     int m_firstIndex = 0;
@@ -118,6 +121,7 @@ public:
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    int queuedTaskCount() const;
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -134,6 +138,14 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    bool pushLocalTask(QRunnable *task);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    void tryToStartThief();
+    void updatePriorityHint()
+    { priorityTaskQueued.storeRelaxed(!queue.isEmpty() && queue.constFirst()->priority() > 0); }
+    void updateSpareThreadsHint()
+    { spareThreads.storeRelaxed(!areAllThreadsActive()); }
+
     static QThreadPool *qtGuiInstance();
 
     mutable QMutex mutex;
@@ -150,6 +162,12 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    // Work-stealing mode. The hints below are read without holding the mutex;
+    // they only decide whether it is worth taking it.
+    QAtomicInt workStealing; // bool
+    QAtomicInt priorityTaskQueued; // bool, queue holds tasks with priority > 0
+    QAtomicInt spareThreads = 1; // bool, a thread could be woken up or started
 };
 
 QT_END_NAMESPACE
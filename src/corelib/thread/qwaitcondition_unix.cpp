@@ -14,12 +14,17 @@
 #include "private/qcore_unix_p.h"
 #include "qreadwritelock_p.h"
 
+#include <qtcore_tracepoints_p.h>
+
 #include <errno.h>
 #include <sys/time.h>
 #include <time.h>
 
 QT_BEGIN_NAMESPACE
 
+Q_TRACE_POINT(qtcore, QWaitCondition_wait_entry, const void *condition, const void *lock);
+Q_TRACE_POINT(qtcore, QWaitCondition_wait_exit, bool woken);
+
 static constexpr clockid_t SteadyClockClockId =
 #if !defined(CLOCK_MONOTONIC)
         // we don't know how to set the monotonic clock
@@ -173,6 +178,7 @@ bool QWaitCondition::wait(QMutex *mutex, QDeadlineTimer deadline)
     if (!mutex)
         return false;
 
+    Q_TRACE(QWaitCondition_wait_entry, this, mutex);
     qt_report_pthread_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
     ++d->waiters;
     mutex->unlock();
@@ -180,6 +186,7 @@ bool QWaitCondition::wait(QMutex *mutex, QDeadlineTimer deadline)
     bool returnValue = d->wait(deadline);
 
     mutex->lock();
+    Q_TRACE(QWaitCondition_wait_exit, returnValue);
 
     return returnValue;
 }
@@ -205,6 +212,7 @@ bool QWaitCondition::wait(QReadWriteLock *readWriteLock, QDeadlineTimer deadline
         return false;
     }
 
+    Q_TRACE(QWaitCondition_wait_entry, this, readWriteLock);
     qt_report_pthread_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
     ++d->waiters;
 
@@ -216,6 +224,7 @@ bool QWaitCondition::wait(QReadWriteLock *readWriteLock, QDeadlineTimer deadline
         readWriteLock->lockForWrite();
     else
         readWriteLock->lockForRead();
+    Q_TRACE(QWaitCondition_wait_exit, returnValue);
 
     return returnValue;
 }
@@ -6,15 +6,29 @@
 #include <qcryptographichash.h>
 #include <qmessageauthenticationcode.h>
 
+#include <qendian.h>
+#include <qfiledevice.h>
 #include <qiodevice.h>
 #include <qmutex.h>
 #include <qvarlengtharray.h>
 #include <private/qlocking_p.h>
+#include <private/qsimd_p.h>
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
+
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <climits>
 #include <numeric>
 
+#if defined(Q_OS_UNIX) && !defined(QT_BOOTSTRAPPED)
+#include <fcntl.h>
+#endif
+
 #include "../../3rdparty/sha1/sha1.cpp"
 
 #if defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1)
@@ -306,7 +320,9 @@ public:
 
     void reset() noexcept;
     void addData(QByteArrayView bytes) noexcept;
-    bool addData(QIODevice *dev);
+    bool addData(QIODevice *dev)
+    { return addData(dev, [](qint64, qint64) { return true; }); }
+    bool addData(QIODevice *dev, qxp::function_ref<bool(qint64, qint64)> progress);
     void finalize() noexcept;
     // when not called from the static hash() function, this function needs to be
     // called with finalizeMutex held (finalize() will do that):
@@ -915,6 +931,11 @@ void QCryptographicHashPrivate::State::addData(QCryptographicHash::Algorithm met
 /*!
   Reads the data from the open QIODevice \a device until it ends
   and hashes it. Returns \c true if reading was successful.
+
+  If \a device is a QFileDevice that supports mapping, such as a QFile
+  opened on a regular file, the data is hashed straight from the mapped
+  file instead of being copied through the device's buffers.
+
   \since 5.0
  */
 bool QCryptographicHash::addData(QIODevice *device)
@@ -922,7 +943,60 @@ bool QCryptographicHash::addData(QIODevice *device)
     return d->addData(device);
 }
 
-bool QCryptographicHashPrivate::addData(QIODevice *device)
+/*!
+  \overload
+  \since 6.7
+
+  Reads the data from the open QIODevice \a device until it ends
+  and hashes it, calling \a progress after each block of data has been
+  hashed. Returns \c true if reading was successful.
+
+  \a progress is called with the number of bytes hashed so far and the
+  number of bytes that were available in \a device when hashing started,
+  or -1 if \a device is sequential. If it returns \c false, hashing stops
+  and this function returns \c false; the data hashed until then remains
+  part of the hash.
+ */
+bool QCryptographicHash::addData(QIODevice *device,
+                                 qxp::function_ref<bool(qint64, qint64)> progress)
+{
+    return d->addData(device, progress);
+}
+
+#ifndef QT_BOOTSTRAPPED
+// Largest part of a file mapped at once. Large enough that mapping costs
+// nothing compared to hashing, small enough to always find address space.
+static constexpr qint64 MaxMappedFileRegion = 64 * 1024 * 1024;
+
+// Hashes as much of the file from its current position as can be mapped,
+// leaving it positioned after that. Returns the number of bytes hashed, or
+// -1 if hashing must stop.
+static qint64 addMappedFileData(QCryptographicHashPrivate *d, QFileDevice *file,
+                                qxp::function_ref<bool(qint64, qint64)> progress)
+{
+    if (file->isSequential() || file->isTextModeEnabled() || file->isTransactionStarted())
+        return 0;
+
+    const qint64 start = file->pos();
+    const qint64 size = file->size();
+    qint64 pos = start;
+    while (pos < size) {
+        const qint64 length = qMin(size - pos, MaxMappedFileRegion);
+        uchar *data = file->map(pos, length);
+        if (!data)
+            break;
+        d->addData({data, qsizetype(length)});
+        file->unmap(data);
+        pos += length;
+        if (!file->seek(pos) || !progress(pos - start, size - start))
+            return -1;
+    }
+    return pos - start;
+}
+#endif // !QT_BOOTSTRAPPED
+
+bool QCryptographicHashPrivate::addData(QIODevice *device,
+                                        qxp::function_ref<bool(qint64, qint64)> progress)
 {
     if (!device->isReadable())
         return false;
@@ -930,11 +1004,34 @@ bool QCryptographicHashPrivate::addData(QIODevice *device)
     if (!device->isOpen())
         return false;
 
-    char buffer[1024];
+    const qint64 total = device->isSequential() ? -1 : device->size() - device->pos();
+
+    qint64 hashed = 0;
+#ifndef QT_BOOTSTRAPPED
+    if (auto file = qobject_cast<QFileDevice *>(device)) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+        // have the page cache read ahead aggressively, whether the file is
+        // mapped or read
+        if (const int fd = file->handle(); fd >= 0)
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        // if the file can't be mapped, or grew in the meantime, read the rest
+        hashed = addMappedFileData(this, file, progress);
+        if (hashed < 0)
+            return false;
+    }
+#endif
+
+    // large enough for QIODevice::read() to bypass the device's own buffer
+    char buffer[16 * 1024];
     qint64 length;
 
-    while ((length = device->read(buffer, sizeof(buffer))) > 0)
-        addData({buffer, qsizetype(length)}); // length always <= 1024
+    while ((length = device->read(buffer, sizeof(buffer))) > 0) {
+        addData({buffer, qsizetype(length)}); // length always <= sizeof(buffer)
+        hashed += length;
+        if (!progress(hashed, total))
+            return false;
+    }
 
     return device->atEnd();
 }
@@ -1136,6 +1233,720 @@ QByteArray QCryptographicHash::hash(QByteArrayView data, Algorithm method)
     return hash.resultView().toByteArray();
 }
 
+/*
+    Multi-buffer hashing.
+
+    SHA-1, SHA-224/256 and BLAKE2s only use 32-bit additions, rotations and
+    logical operations, so N independent messages can be hashed at once by
+    keeping word i of the state of every message in lane i of a SIMD register
+    (SSE2: 4 lanes, AVX2: 8 lanes). hashManyUnchecked() schedules the messages
+    on the lanes, longest first, refilling a lane as soon as its message is
+    done; the last (padded) blocks of each message are built in a per-lane
+    buffer.
+
+    The other algorithms, and targets without SSE2, hash one message at a
+    time.
+*/
+#if defined(__SSE2__) && !defined(QT_BOOTSTRAPPED)
+#  define QT_CRYPTOGRAPHICHASH_MULTI_LANE
+#endif
+
+#ifdef QT_CRYPTOGRAPHICHASH_MULTI_LANE
+// The kernels below are templates, not compiled for AVX2 themselves, that
+// get inlined into the functions that are; GCC warns about the AVX vectors
+// they handle before inlining happens.
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_GCC("-Wpsabi")
+
+namespace {
+struct Sse2Lanes
+{
+    using Vector = __m128i;
+    static constexpr int Count = 4;
+
+    static Vector load(const quint32 *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static void store(quint32 *p, Vector v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+    static Vector set1(quint32 x) { return _mm_set1_epi32(int(x)); }
+    static Vector add(Vector a, Vector b) { return _mm_add_epi32(a, b); }
+    static Vector bitAnd(Vector a, Vector b) { return _mm_and_si128(a, b); }
+    static Vector bitAndNot(Vector a, Vector b) { return _mm_andnot_si128(a, b); } // ~a & b
+    static Vector bitOr(Vector a, Vector b) { return _mm_or_si128(a, b); }
+    static Vector bitXor(Vector a, Vector b) { return _mm_xor_si128(a, b); }
+    template <int N> static Vector shr(Vector a) { return _mm_srli_epi32(a, N); }
+    template <int N> static Vector rotr(Vector a)
+    { return _mm_or_si128(_mm_srli_epi32(a, N), _mm_slli_epi32(a, 32 - N)); }
+};
+
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+struct Avx2Lanes
+{
+    using Vector = __m256i;
+    static constexpr int Count = 8;
+
+    QT_FUNCTION_TARGET(AVX2) static Vector load(const quint32 *p)
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    QT_FUNCTION_TARGET(AVX2) static void store(quint32 *p, Vector v)
+    { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+    QT_FUNCTION_TARGET(AVX2) static Vector set1(quint32 x) { return _mm256_set1_epi32(int(x)); }
+    QT_FUNCTION_TARGET(AVX2) static Vector add(Vector a, Vector b) { return _mm256_add_epi32(a, b); }
+    QT_FUNCTION_TARGET(AVX2) static Vector bitAnd(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+    QT_FUNCTION_TARGET(AVX2) static Vector bitAndNot(Vector a, Vector b) { return _mm256_andnot_si256(a, b); }
+    QT_FUNCTION_TARGET(AVX2) static Vector bitOr(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+    QT_FUNCTION_TARGET(AVX2) static Vector bitXor(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+    template <int N> QT_FUNCTION_TARGET(AVX2) static Vector shr(Vector a)
+    { return _mm256_srli_epi32(a, N); }
+    template <int N> QT_FUNCTION_TARGET(AVX2) static Vector rotr(Vector a)
+    { return _mm256_or_si256(_mm256_srli_epi32(a, N), _mm256_slli_epi32(a, 32 - N)); }
+};
+#  endif
+
+// Per-lane state of a compression: the hash state, transposed so that each
+// row can be loaded into a vector, and for BLAKE2s the byte counter and
+// finalization flag.
+template <int Count>
+struct LaneBlocks
+{
+    alignas(32) quint32 state[8][Count];
+    alignas(32) quint32 counterLow[Count];
+    alignas(32) quint32 counterHigh[Count];
+    alignas(32) quint32 finalFlag[Count];
+    const uchar *blocks[Count];
+};
+
+// Loads the 16 words of the block of each lane, transposed. Vectors are
+// passed by pointer, as these functions are not compiled for AVX2 (they get
+// inlined into functions that are).
+template <typename L, bool BigEndian>
+Q_ALWAYS_INLINE static void gatherWords(typename L::Vector *w, const uchar *const *blocks)
+{
+    alignas(32) quint32 words[16][L::Count];
+    for (int lane = 0; lane < L::Count; ++lane) {
+        for (int i = 0; i < 16; ++i) {
+            if constexpr (BigEndian)
+                words[i][lane] = qFromBigEndian<quint32>(blocks[lane] + 4 * i);
+            else
+                words[i][lane] = qFromLittleEndian<quint32>(blocks[lane] + 4 * i);
+        }
+    }
+    for (int i = 0; i < 16; ++i)
+        w[i] = L::load(words[i]);
+}
+
+struct Sha1Lanes
+{
+    static constexpr int BlockSize = 64;
+    static constexpr int StateWords = 5;
+    static constexpr bool BigEndian = true;
+    static constexpr bool MerkleDamgard = true;
+
+    static void init(quint32 *state, int)
+    {
+        static constexpr quint32 iv[] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+        std::copy(std::begin(iv), std::end(iv), state);
+    }
+
+    template <typename L>
+    Q_ALWAYS_INLINE static void compress(LaneBlocks<L::Count> &b)
+    {
+        using V = typename L::Vector;
+        V w[16];
+        gatherWords<L, true>(w, b.blocks);
+
+        V a = L::load(b.state[0]), bb = L::load(b.state[1]), c = L::load(b.state[2]);
+        V d = L::load(b.state[3]), e = L::load(b.state[4]);
+        for (int i = 0; i < 80; ++i) {
+            if (i >= 16) {
+                const V x = L::bitXor(L::bitXor(w[(i - 3) & 15], w[(i - 8) & 15]),
+                                      L::bitXor(w[(i - 14) & 15], w[i & 15]));
+                w[i & 15] = L::template rotr<31>(x);
+            }
+            V f, k;
+            if (i < 20) {
+                f = L::bitOr(L::bitAnd(bb, c), L::bitAndNot(bb, d));
+                k = L::set1(0x5a827999);
+            } else if (i < 40) {
+                f = L::bitXor(L::bitXor(bb, c), d);
+                k = L::set1(0x6ed9eba1);
+            } else if (i < 60) {
+                f = L::bitOr(L::bitAnd(bb, c), L::bitAnd(d, L::bitOr(bb, c)));
+                k = L::set1(0x8f1bbcdc);
+            } else {
+                f = L::bitXor(L::bitXor(bb, c), d);
+                k = L::set1(0xca62c1d6);
+            }
+            const V t = L::add(L::add(L::template rotr<27>(a), f), L::add(L::add(e, k), w[i & 15]));
+            e = d;
+            d = c;
+            c = L::template rotr<2>(bb);
+            bb = a;
+            a = t;
+        }
+        L::store(b.state[0], L::add(L::load(b.state[0]), a));
+        L::store(b.state[1], L::add(L::load(b.state[1]), bb));
+        L::store(b.state[2], L::add(L::load(b.state[2]), c));
+        L::store(b.state[3], L::add(L::load(b.state[3]), d));
+        L::store(b.state[4], L::add(L::load(b.state[4]), e));
+    }
+};
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+struct Sha256Lanes
+{
+    static constexpr int BlockSize = 64;
+    static constexpr int StateWords = 8;
+    static constexpr bool BigEndian = true;
+    static constexpr bool MerkleDamgard = true;
+
+    static void init(quint32 *state, int hashLength)
+    {
+        static constexpr quint32 sha224[] = {
+            0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+            0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+        };
+        static constexpr quint32 sha256[] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+        const quint32 *iv = hashLength == SHA224HashSize ? sha224 : sha256;
+        std::copy(iv, iv + StateWords, state);
+    }
+
+    template <typename L>
+    Q_ALWAYS_INLINE static void compress(LaneBlocks<L::Count> &b)
+    {
+        static constexpr quint32 k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        using V = typename L::Vector;
+        V w[16];
+        gatherWords<L, true>(w, b.blocks);
+
+        V s[8];
+        for (int i = 0; i < 8; ++i)
+            s[i] = L::load(b.state[i]);
+        V a = s[0], bb = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (int i = 0; i < 64; ++i) {
+            if (i >= 16) {
+                const V w15 = w[(i - 15) & 15];
+                const V w2 = w[(i - 2) & 15];
+                const V sigma0 = L::bitXor(L::bitXor(L::template rotr<7>(w15), L::template rotr<18>(w15)),
+                                           L::template shr<3>(w15));
+                const V sigma1 = L::bitXor(L::bitXor(L::template rotr<17>(w2), L::template rotr<19>(w2)),
+                                           L::template shr<10>(w2));
+                w[i & 15] = L::add(L::add(w[i & 15], sigma0), L::add(w[(i - 7) & 15], sigma1));
+            }
+            const V sum1 = L::bitXor(L::bitXor(L::template rotr<6>(e), L::template rotr<11>(e)),
+                                     L::template rotr<25>(e));
+            const V ch = L::bitXor(L::bitAnd(e, f), L::bitAndNot(e, g));
+            const V t1 = L::add(L::add(L::add(h, sum1), L::add(ch, L::set1(k[i]))), w[i & 15]);
+            const V sum0 = L::bitXor(L::bitXor(L::template rotr<2>(a), L::template rotr<13>(a)),
+                                     L::template rotr<22>(a));
+            const V maj = L::bitXor(L::bitAnd(a, bb), L::bitAnd(c, L::bitXor(a, bb)));
+            const V t2 = L::add(sum0, maj);
+            h = g;
+            g = f;
+            f = e;
+            e = L::add(d, t1);
+            d = c;
+            c = bb;
+            bb = a;
+            a = L::add(t1, t2);
+        }
+
+        const V out[8] = { a, bb, c, d, e, f, g, h };
+        for (int i = 0; i < 8; ++i)
+            L::store(b.state[i], L::add(s[i], out[i]));
+    }
+};
+
+struct Blake2sLanes
+{
+    static constexpr int BlockSize = BLAKE2S_BLOCKBYTES;
+    static constexpr int StateWords = 8;
+    static constexpr bool BigEndian = false;
+    static constexpr bool MerkleDamgard = false;
+
+    static constexpr quint32 iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    // Vectors are passed by pointer, as these functions are not compiled
+    // for AVX2 (they get inlined into functions that are)
+    template <typename L>
+    Q_ALWAYS_INLINE static void g(typename L::Vector *v, int a, int b, int c, int d,
+                                  const typename L::Vector *x, const typename L::Vector *y)
+    {
+        v[a] = L::add(L::add(v[a], v[b]), *x);
+        v[d] = L::template rotr<16>(L::bitXor(v[d], v[a]));
+        v[c] = L::add(v[c], v[d]);
+        v[b] = L::template rotr<12>(L::bitXor(v[b], v[c]));
+        v[a] = L::add(L::add(v[a], v[b]), *y);
+        v[d] = L::template rotr<8>(L::bitXor(v[d], v[a]));
+        v[c] = L::add(v[c], v[d]);
+        v[b] = L::template rotr<7>(L::bitXor(v[b], v[c]));
+    }
+
+    static void init(quint32 *state, int hashLength)
+    {
+        std::copy(std::begin(iv), std::end(iv), state);
+        // parameter block: digest length, no key, fanout 1, depth 1
+        state[0] ^= 0x01010000 ^ quint32(hashLength);
+    }
+
+    template <typename L>
+    Q_ALWAYS_INLINE static void compress(LaneBlocks<L::Count> &b)
+    {
+        static constexpr uchar sigma[10][16] = {
+            {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+            { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+            { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+            {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+            {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+            {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+            { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+            { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+            {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+            { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+        };
+
+        using V = typename L::Vector;
+        V m[16];
+        gatherWords<L, false>(m, b.blocks);
+
+        V v[16];
+        for (int i = 0; i < 8; ++i)
+            v[i] = L::load(b.state[i]);
+        for (int i = 0; i < 4; ++i)
+            v[8 + i] = L::set1(iv[i]);
+        v[12] = L::bitXor(L::set1(iv[4]), L::load(b.counterLow));
+        v[13] = L::bitXor(L::set1(iv[5]), L::load(b.counterHigh));
+        v[14] = L::bitXor(L::set1(iv[6]), L::load(b.finalFlag));
+        v[15] = L::set1(iv[7]);
+
+        for (const auto &s : sigma) {
+            g<L>(v, 0, 4,  8, 12, &m[s[ 0]], &m[s[ 1]]);
+            g<L>(v, 1, 5,  9, 13, &m[s[ 2]], &m[s[ 3]]);
+            g<L>(v, 2, 6, 10, 14, &m[s[ 4]], &m[s[ 5]]);
+            g<L>(v, 3, 7, 11, 15, &m[s[ 6]], &m[s[ 7]]);
+            g<L>(v, 0, 5, 10, 15, &m[s[ 8]], &m[s[ 9]]);
+            g<L>(v, 1, 6, 11, 12, &m[s[10]], &m[s[11]]);
+            g<L>(v, 2, 7,  8, 13, &m[s[12]], &m[s[13]]);
+            g<L>(v, 3, 4,  9, 14, &m[s[14]], &m[s[15]]);
+        }
+
+        for (int i = 0; i < 8; ++i)
+            L::store(b.state[i], L::bitXor(L::load(b.state[i]), L::bitXor(v[i], v[i + 8])));
+    }
+};
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
+// A message being hashed in a lane
+struct LaneMessage
+{
+    qsizetype index = -1;           // index of the message, -1 if the lane is idle
+    const uchar *data = nullptr;    // next full block to be read from the message
+    qsizetype fullBlocks = 0;       // full blocks still to be read from the message
+    quint64 counter = 0;            // BLAKE2s: bytes compressed so far
+    int tailBlocks = 0;             // blocks still to be read from tail
+    int tailIndex = 0;
+    int tailBytes = 0;              // BLAKE2s: bytes of the message in tail
+    alignas(16) uchar tail[2 * 64]; // the last, padded, blocks of the message
+};
+
+template <typename Algo>
+static void startLaneMessage(LaneMessage &lane, qsizetype index, QByteArrayView data)
+{
+    constexpr int BlockSize = Algo::BlockSize;
+    const qsizetype size = data.size();
+    lane.index = index;
+    lane.data = reinterpret_cast<const uchar *>(data.data());
+    lane.counter = 0;
+    lane.tailIndex = 0;
+
+    if constexpr (Algo::MerkleDamgard) {
+        // SHA-1 and SHA-2: append 0x80, zeros, and the length in bits
+        lane.fullBlocks = size / BlockSize;
+        const int rest = int(size % BlockSize);
+        lane.tailBlocks = rest < BlockSize - 8 ? 1 : 2;
+        memset(lane.tail, 0, lane.tailBlocks * BlockSize);
+        if (rest)
+            memcpy(lane.tail, lane.data + lane.fullBlocks * BlockSize, rest);
+        lane.tail[rest] = 0x80;
+        qToBigEndian(quint64(size) * 8, lane.tail + lane.tailBlocks * BlockSize - 8);
+    } else {
+        // BLAKE2: the last block (which may be full, or empty for an empty
+        // message) is zero-padded and compressed with the final flag set
+        lane.fullBlocks = size ? (size - 1) / BlockSize : 0;
+        lane.tailBlocks = 1;
+        lane.tailBytes = int(size - lane.fullBlocks * BlockSize);
+        memset(lane.tail, 0, BlockSize);
+        if (lane.tailBytes)
+            memcpy(lane.tail, lane.data + lane.fullBlocks * BlockSize, lane.tailBytes);
+    }
+}
+
+template <typename L, typename Algo>
+Q_ALWAYS_INLINE static void hashLanes(const QByteArrayView *data, const qsizetype *order,
+                                      qsizetype count, int hashLength, uchar *out)
+{
+    constexpr int Count = L::Count;
+    alignas(64) static const uchar idleBlock[Algo::BlockSize] = {};
+
+    LaneBlocks<Count> b;
+    LaneMessage lanes[Count];
+    qsizetype next = 0;
+    int active = 0;
+
+    const auto assign = [&](int lane) {
+        if (next == count) {
+            lanes[lane].index = -1;
+            return;
+        }
+        const qsizetype index = order[next++];
+        startLaneMessage<Algo>(lanes[lane], index, data[index]);
+        quint32 iv[Algo::StateWords];
+        Algo::init(iv, hashLength);
+        for (int i = 0; i < Algo::StateWords; ++i)
+            b.state[i][lane] = iv[i];
+        ++active;
+    };
+
+    for (int lane = 0; lane < Count; ++lane)
+        assign(lane);
+
+    while (active) {
+        for (int lane = 0; lane < Count; ++lane) {
+            LaneMessage &m = lanes[lane];
+            b.finalFlag[lane] = 0;
+            if (m.index < 0) {
+                b.blocks[lane] = idleBlock;
+            } else if (m.fullBlocks) {
+                b.blocks[lane] = m.data;
+                m.data += Algo::BlockSize;
+                --m.fullBlocks;
+                m.counter += Algo::BlockSize;
+            } else {
+                b.blocks[lane] = m.tail + m.tailIndex++ * Algo::BlockSize;
+                --m.tailBlocks;
+                if constexpr (!Algo::MerkleDamgard) {
+                    m.counter += m.tailBytes;
+                    b.finalFlag[lane] = ~0u;
+                }
+            }
+            b.counterLow[lane] = quint32(m.counter);
+            b.counterHigh[lane] = quint32(m.counter >> 32);
+        }
+
+        Algo::template compress<L>(b);
+
+        for (int lane = 0; lane < Count; ++lane) {
+            const LaneMessage &m = lanes[lane];
+            if (m.index < 0 || m.fullBlocks || m.tailBlocks)
+                continue;
+            uchar digest[Algo::StateWords * 4];
+            for (int i = 0; i < Algo::StateWords; ++i) {
+                if constexpr (Algo::BigEndian)
+                    qToBigEndian(b.state[i][lane], digest + 4 * i);
+                else
+                    qToLittleEndian(b.state[i][lane], digest + 4 * i);
+            }
+            memcpy(out + m.index * hashLength, digest, hashLength);
+            --active;
+            assign(lane);
+        }
+    }
+}
+
+template <typename Algo>
+static void hashSse2(const QByteArrayView *data, const qsizetype *order, qsizetype count,
+                     int hashLength, uchar *out)
+{
+    hashLanes<Sse2Lanes, Algo>(data, order, count, hashLength, out);
+}
+
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+template <typename Algo>
+QT_FUNCTION_TARGET(AVX2)
+static void hashAvx2(const QByteArrayView *data, const qsizetype *order, qsizetype count,
+                     int hashLength, uchar *out)
+{
+    hashLanes<Avx2Lanes, Algo>(data, order, count, hashLength, out);
+}
+#  endif
+
+template <typename Algo>
+static void hashMultiLane(const QByteArrayView *data, qsizetype count, int hashLength, uchar *out)
+{
+    // Longest messages first, so that the lanes run out of work as late
+    // (and as much at the same time) as possible
+    QVarLengthArray<qsizetype, 256> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [data](qsizetype lhs, qsizetype rhs) {
+        return data[lhs].size() > data[rhs].size();
+    });
+
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (count > Sse2Lanes::Count && qCpuHasFeature(AVX2))
+        return hashAvx2<Algo>(data, order.constData(), count, hashLength, out);
+#  endif
+    hashSse2<Algo>(data, order.constData(), count, hashLength, out);
+}
+} // unnamed namespace
+
+QT_WARNING_POP
+#endif // QT_CRYPTOGRAPHICHASH_MULTI_LANE
+
+/*!
+    \internal
+
+    Hashes each of the \a count messages in \a data with \a method, and
+    writes the results one after the other, hashLength(method) bytes each,
+    into \a out. Returns \c false if \a method is not supported.
+*/
+static bool hashManyUnchecked(const QByteArrayView *data, qsizetype count,
+                              QCryptographicHash::Algorithm method, uchar *out)
+{
+    const int hashLength = hashLengthInternal(method);
+
+#ifdef QT_CRYPTOGRAPHICHASH_MULTI_LANE
+    if (count > 1) {
+        switch (method) {
+        case QCryptographicHash::Sha1:
+            hashMultiLane<Sha1Lanes>(data, count, hashLength, out);
+            return true;
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+        case QCryptographicHash::Sha224:
+        case QCryptographicHash::Sha256:
+            hashMultiLane<Sha256Lanes>(data, count, hashLength, out);
+            return true;
+        case QCryptographicHash::Blake2s_128:
+        case QCryptographicHash::Blake2s_160:
+        case QCryptographicHash::Blake2s_224:
+        case QCryptographicHash::Blake2s_256:
+            hashMultiLane<Blake2sLanes>(data, count, hashLength, out);
+            return true;
+#endif
+        default:
+            break;
+        }
+    }
+#endif
+
+    QCryptographicHashPrivate hash(method);
+    for (qsizetype i = 0; i < count; ++i) {
+        if (i)
+            hash.reset();
+        hash.addData(data[i]);
+        hash.finalizeUnchecked(); // no mutex needed: no-one but us has access to 'hash'
+        const QByteArrayView result = hash.resultView();
+        if (result.size() != hashLength)
+            return false; // not supported by OpenSSL
+        memcpy(out + i * hashLength, result.data(), hashLength);
+    }
+    return true;
+}
+
+/*!
+    \since 6.7
+
+    Returns the hashes of each of the byte arrays in \a data using \a method,
+    in the same order.
+
+    This is equivalent to calling hash() for each element of \a data, but
+    faster for many, small, inputs: for the SHA-1, SHA-224, SHA-256 and
+    BLAKE2s algorithms, QCryptographicHash uses the SIMD instructions of the
+    CPU, when available, to hash several of the inputs at once.
+
+    \sa hash(), hashTree()
+*/
+QList<QByteArray> QCryptographicHash::hashMany(const QList<QByteArrayView> &data, Algorithm method)
+{
+    const int length = hashLengthInternal(method);
+    QByteArray digests(data.size() * length, Qt::Uninitialized);
+    const bool ok = hashManyUnchecked(data.constData(), data.size(), method,
+                                      reinterpret_cast<uchar *>(digests.data()));
+
+    QList<QByteArray> result;
+    result.reserve(data.size());
+    for (qsizetype i = 0; i < data.size(); ++i)
+        result.append(ok ? digests.sliced(i * length, length) : QByteArray());
+    return result;
+}
+
+/*!
+    \since 6.7
+    \overload
+*/
+QList<QByteArray> QCryptographicHash::hashMany(const QList<QByteArray> &data, Algorithm method)
+{
+    return hashMany(QList<QByteArrayView>(data.begin(), data.end()), method);
+}
+
+/*!
+    \internal
+
+    Hashes the chunks of \a data, \a chunkSize bytes each, into \a leaves.
+    The chunks are split in contiguous groups, hashed in parallel on the
+    global thread pool (by as many threads as it can spare) and in the
+    calling thread.
+*/
+static bool hashTreeLeaves(QByteArrayView data, qsizetype chunkSize,
+                           QCryptographicHash::Algorithm method, uchar *leaves)
+{
+    const int length = hashLengthInternal(method);
+    const qsizetype chunkCount = qMax((data.size() + chunkSize - 1) / chunkSize, qsizetype(1));
+    QVarLengthArray<QByteArrayView, 256> chunks(chunkCount);
+    for (qsizetype i = 0; i < chunkCount; ++i)
+        chunks[i] = data.sliced(i * chunkSize, qMin(chunkSize, data.size() - i * chunkSize));
+
+    std::atomic<bool> ok = true;
+    const auto hashGroup = [&](qsizetype begin, qsizetype end) {
+        if (!hashManyUnchecked(chunks.constData() + begin, end - begin, method, leaves + begin * length))
+            ok.store(false, std::memory_order_relaxed);
+    };
+
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype groupCount = qMin(qsizetype(qMax(pool->maxThreadCount(), 1)), chunkCount);
+    if (groupCount > 1) {
+        QSemaphore done;
+        int started = 0;
+        // Hand the first groups to the pool, but don't wait for a thread to
+        // become available (we may be running in the pool ourselves): if
+        // none is, hash the group here.
+        for (qsizetype group = 1; group < groupCount; ++group) {
+            const qsizetype begin = chunkCount * group / groupCount;
+            const qsizetype end = chunkCount * (group + 1) / groupCount;
+            const bool onPool = pool->tryStart([&hashGroup, &done, begin, end] {
+                hashGroup(begin, end);
+                done.release();
+            });
+            if (onPool)
+                ++started;
+            else
+                hashGroup(begin, end);
+        }
+        hashGroup(0, chunkCount / groupCount);
+        done.acquire(started);
+        return ok;
+    }
+#endif
+
+    hashGroup(0, chunkCount);
+    return ok;
+}
+
+/*!
+    \since 6.7
+
+    Returns the tree hash of \a data, using \a method and chunks of
+    \a chunkSize bytes.
+
+    \a data is split into chunks of \a chunkSize bytes (the last chunk may be
+    shorter; empty \a data makes one empty chunk). Each chunk is hashed with
+    \a method, and the tree hash is the hash, with \a method, of the
+    concatenation of the hashes of the chunks:
+
+    \code
+    hash(hash(chunk[0]) + hash(chunk[1]) + ... + hash(chunk[n - 1]))
+    \endcode
+
+    Unlike the hash of \a data, the hashes of the chunks can be calculated
+    independently: this function does so in parallel, using the global
+    QThreadPool, and hashes several chunks at once, as hashMany() does. This
+    makes it suitable for hashing large amounts of data, e.g. memory-mapped
+    files, for content-addressed storage.
+
+    \note The tree hash is not the same as hash() of \a data, and it
+    depends on \a chunkSize: the same chunk size must be used to produce and
+    to verify a tree hash.
+
+    \sa hash(), hashMany()
+*/
+QByteArray QCryptographicHash::hashTree(QByteArrayView data, Algorithm method, qsizetype chunkSize)
+{
+    Q_ASSERT(chunkSize > 0);
+    const int length = hashLengthInternal(method);
+    const qsizetype chunkCount = qMax((data.size() + chunkSize - 1) / chunkSize, qsizetype(1));
+    QByteArray leaves(chunkCount * length, Qt::Uninitialized);
+    if (!hashTreeLeaves(data, chunkSize, method, reinterpret_cast<uchar *>(leaves.data())))
+        return QByteArray();
+    return hash(leaves, method);
+}
+
+/*!
+    \since 6.7
+    \overload
+
+    Returns the tree hash of the data read from \a device until it ends,
+    using \a method and chunks of \a chunkSize bytes. Returns a null
+    QByteArray if \a device is not open for reading, or reading fails.
+
+    The data is read and hashed in batches of a few chunks per thread, and
+    at most 64 MiB (or a single chunk, if \a chunkSize is larger) are held
+    in memory at any time.
+*/
+QByteArray QCryptographicHash::hashTree(QIODevice *device, Algorithm method, qsizetype chunkSize)
+{
+    Q_ASSERT(chunkSize > 0);
+    if (!device->isReadable() || !device->isOpen())
+        return QByteArray();
+
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    const int threads = qMax(QThreadPool::globalInstance()->maxThreadCount(), 1);
+#else
+    const int threads = 1;
+#endif
+    // A few chunks per thread keep every thread busy; the ceiling bounds the
+    // buffer however large the pool is (but a batch holds at least one chunk)
+    constexpr qsizetype ChunksPerThread = 4;
+    constexpr qsizetype MaxBatchSize = 64 * 1024 * 1024;
+    const qsizetype batchChunks = qMax(qMin(qsizetype(threads) * ChunksPerThread,
+                                            MaxBatchSize / chunkSize), qsizetype(1));
+    const qsizetype batchSize = batchChunks * chunkSize;
+
+    const int length = hashLengthInternal(method);
+    QByteArray buffer;
+    QByteArray leaves;
+    bool empty = true;
+    while (true) {
+        buffer.resize(batchSize);
+        qsizetype size = 0;
+        while (size < batchSize) {
+            const qint64 read = device->read(buffer.data() + size, batchSize - size);
+            if (read <= 0)
+                break;
+            size += read;
+        }
+        if (size == 0 && !empty)
+            break;
+        const qsizetype batchLeaves = qMax((size + chunkSize - 1) / chunkSize, qsizetype(1));
+        const qsizetype offset = leaves.size();
+        leaves.resize(offset + batchLeaves * length);
+        if (!hashTreeLeaves(QByteArrayView(buffer).first(size), chunkSize, method,
+                            reinterpret_cast<uchar *>(leaves.data()) + offset)) {
+            return QByteArray();
+        }
+        empty = false;
+        if (size < batchSize)
+            break;
+    }
+
+    if (!device->atEnd())
+        return QByteArray();
+    return hash(leaves, method);
+}
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
@@ -7,7 +7,9 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qobjectdefs.h>
+#include <QtCore/qxpfunctional.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -83,6 +85,7 @@ public:
 #endif
     void addData(QByteArrayView data) noexcept;
     bool addData(QIODevice *device);
+    bool addData(QIODevice *device, qxp::function_ref<bool(qint64, qint64)> progress);
 
     QByteArray result() const;
     QByteArrayView resultView() const noexcept;
@@ -91,6 +94,12 @@ public:
     static QByteArray hash(const QByteArray &data, Algorithm method);
 #endif
     static QByteArray hash(QByteArrayView data, Algorithm method);
+    static QList<QByteArray> hashMany(const QList<QByteArrayView> &data, Algorithm method);
+    static QList<QByteArray> hashMany(const QList<QByteArray> &data, Algorithm method);
+    static QByteArray hashTree(QByteArrayView data, Algorithm method,
+                               qsizetype chunkSize = 1024 * 1024);
+    static QByteArray hashTree(QIODevice *device, Algorithm method,
+                               qsizetype chunkSize = 1024 * 1024);
     static int hashLength(Algorithm method);
     static bool supportsAlgorithm(Algorithm method);
 private:
@@ -17,6 +17,26 @@ static bool s_triedLoading = false;
 static bool s_prevent_recursion = false;
 static bool s_shutdown = false;
 static QCtfLib* s_plugin = nullptr;
+// Set while the plugin handles a tracepoint. The plugin locks mutexes and
+// waits on wait conditions, which have tracepoints of their own.
+Q_CONSTINIT static thread_local bool s_inTracepoint = false;
+
+namespace {
+class TracepointGuard
+{
+public:
+    TracepointGuard() : m_entered(!s_inTracepoint) { s_inTracepoint = true; }
+    ~TracepointGuard()
+    {
+        if (m_entered)
+            s_inTracepoint = false;
+    }
+    bool entered() const { return m_entered; }
+
+private:
+    const bool m_entered;
+};
+} // unnamed namespace
 
 #if defined(Q_OS_ANDROID)
 static QString findPlugin(const QString &plugin)
@@ -92,14 +112,16 @@ static bool initialize()
 
 bool _tracepoint_enabled(const QCtfTracePointEvent &point)
 {
-    if (!initialize())
+    const TracepointGuard guard;
+    if (!guard.entered() || !initialize())
         return false;
     return s_plugin ? s_plugin->tracepointEnabled(point) : false;
 }
 
 void _do_tracepoint(const QCtfTracePointEvent &point, const QByteArray &arr)
 {
-    if (!initialize())
+    const TracepointGuard guard;
+    if (!guard.entered() || !initialize())
         return;
     if (s_plugin)
         s_plugin->doTracepoint(point, arr);
@@ -107,7 +129,8 @@ void _do_tracepoint(const QCtfTracePointEvent &point, const QByteArray &arr)
 
 QCtfTracePointPrivate *_initialize_tracepoint(const QCtfTracePointEvent &point)
 {
-    if (!initialize())
+    const TracepointGuard guard;
+    if (!guard.entered() || !initialize())
         return nullptr;
     return s_plugin ? s_plugin->initializeTracepoint(point) : nullptr;
 }
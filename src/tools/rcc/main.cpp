@@ -137,11 +137,11 @@ int runRcc(int argc, char *argv[])
     parser.addOption(rootOption);
 
 #if QT_CONFIG(zstd) && !defined(QT_NO_COMPRESS)
-#  define ALGOS     "[zstd], zlib, none"
+#  define ALGOS     "[zstd], zlib, auto, none"
 #elif QT_CONFIG(zstd)
-#  define ALGOS     "[zstd], none"
+#  define ALGOS     "[zstd], auto, none"
 #elif !defined(QT_NO_COMPRESS)
-#  define ALGOS     "[zlib], none"
+#  define ALGOS     "[zlib], auto, none"
 #else
 #  define ALGOS     "[none]"
 #endif
@@ -163,6 +163,12 @@ int runRcc(int argc, char *argv[])
     QCommandLineOption thresholdOption(QStringLiteral("threshold"), QStringLiteral("Threshold to consider compressing files."), QStringLiteral("level"));
     parser.addOption(thresholdOption);
 
+    QCommandLineOption decompressionCostOption(QStringLiteral("decompression-cost"),
+            QStringLiteral("With --compress-algo=auto, compress a file only if it saves <bytes> "
+                           "for each microsecond its decompression is estimated to take."),
+            QStringLiteral("bytes"));
+    parser.addOption(decompressionCostOption);
+
     QCommandLineOption binaryOption(QStringLiteral("binary"), QStringLiteral("Output a binary file for use as a dynamic resource."));
     parser.addOption(binaryOption);
 
@@ -243,6 +249,8 @@ int runRcc(int argc, char *argv[])
     }
     if (parser.isSet(thresholdOption))
         library.setCompressThreshold(parser.value(thresholdOption).toInt());
+    if (parser.isSet(decompressionCostOption))
+        library.setDecompressionCost(parser.value(decompressionCostOption).toInt());
     if (parser.isSet(binaryOption))
         library.setFormat(RCCResourceLibrary::Binary);
     if (parser.isSet(generatorOption)) {
@@ -32,7 +32,8 @@ enum {
     CONSTANT_COMPRESSLEVEL_DEFAULT = -1,
     CONSTANT_ZSTDCOMPRESSLEVEL_CHECK = 1,   // Zstd level to check if compressing is a good idea
     CONSTANT_ZSTDCOMPRESSLEVEL_STORE = 14,  // Zstd level to actually store the data
-    CONSTANT_COMPRESSTHRESHOLD_DEFAULT = 70
+    CONSTANT_COMPRESSTHRESHOLD_DEFAULT = 70,
+    CONSTANT_DECOMPRESSIONCOST_DEFAULT = 8  // bytes to save per microsecond of decompression
 };
 
 void RCCResourceLibrary::write(const char *str, int len)
@@ -91,6 +92,7 @@ public:
     QString resourceName() const;
 
 public:
+    void chooseCompression(RCCResourceLibrary &lib, QByteArray *data);
     qint64 writeDataBlob(RCCResourceLibrary &lib, qint64 offset, QString *errorMessage);
     qint64 writeDataName(RCCResourceLibrary &, qint64 offset);
     void writeDataInfo(RCCResourceLibrary &lib);
@@ -217,6 +219,90 @@ void RCCFileInfo::writeDataInfo(RCCResourceLibrary &lib)
     }
 }
 
+// Estimated time to decompress \a size bytes of output, in microseconds. The
+// rates are typical for a desktop CPU; they're constants rather than measured
+// here, so that the choice, and thus the output, doesn't depend on the machine
+// or its load.
+static double decompressionMicroseconds(RCCResourceLibrary::CompressionAlgorithm algo,
+                                        qsizetype size)
+{
+    constexpr double PerCall = 1;
+    constexpr double PerMiB[] = { 3000 /* zlib */, 1000 /* zstd */ };
+    const double mib = size / (1024.0 * 1024.0);
+    switch (algo) {
+    case RCCResourceLibrary::CompressionAlgorithm::Zlib:
+        return PerCall + mib * PerMiB[0];
+    case RCCResourceLibrary::CompressionAlgorithm::Zstd:
+        return PerCall + mib * PerMiB[1];
+    default:
+        break;
+    }
+    return 0;
+}
+
+// Picks the algorithm for --compress-algo=auto: the one that saves the most
+// space once its decompression cost is accounted for, or none. Replaces
+// \a data with its compressed form, if any.
+void RCCFileInfo::chooseCompression(RCCResourceLibrary &lib, QByteArray *data)
+{
+    using Algorithm = RCCResourceLibrary::CompressionAlgorithm;
+    Algorithm best = Algorithm::None;
+    int bestLevel = CONSTANT_COMPRESSLEVEL_DEFAULT;
+    double bestScore = 0;
+    QByteArray bestData;
+    const qsizetype size = data->size();
+    const auto consider = [&](Algorithm algo, int level, QByteArray &&compressed) {
+        const double score = double(size - compressed.size())
+                - lib.m_decompressionCost * decompressionMicroseconds(algo, size);
+        if (score > bestScore) {
+            best = algo;
+            bestLevel = level;
+            bestScore = score;
+            bestData = std::move(compressed);
+        }
+    };
+
+#if QT_CONFIG(zstd)
+    if (!m_noZstd && lib.formatVersion() >= 3) {
+        if (lib.m_zstdCCtx == nullptr)
+            lib.m_zstdCCtx = ZSTD_createCCtx();
+        const qsizetype bound = ZSTD_COMPRESSBOUND(size);
+        QByteArray compressed(bound, Qt::Uninitialized);
+        const size_t n = ZSTD_compressCCtx(lib.m_zstdCCtx, compressed.data(), bound,
+                                           data->constData(), size,
+                                           CONSTANT_ZSTDCOMPRESSLEVEL_STORE);
+        if (!ZSTD_isError(n)) {
+            compressed.truncate(qsizetype(n));
+            consider(Algorithm::Zstd, CONSTANT_ZSTDCOMPRESSLEVEL_STORE, std::move(compressed));
+        }
+    }
+#endif
+#ifndef QT_NO_COMPRESS
+    consider(Algorithm::Zlib, 9,
+             qCompress(reinterpret_cast<const uchar *>(data->constData()), size, 9));
+#endif
+
+    if (lib.verbose()) {
+        const char *name = best == Algorithm::Zstd ? "zstd"
+                         : best == Algorithm::Zlib ? "zlib" : "none";
+        const qsizetype bestSize = best == Algorithm::None ? size : bestData.size();
+        QString msg = QString::fromLatin1("%1: note: automatic compression chose %2 (%3 -> %4)\n")
+                .arg(m_name, QLatin1StringView(name)).arg(size).arg(bestSize);
+        lib.m_errorDevice->write(msg.toUtf8());
+    }
+    m_compressAlgo = best;
+    m_compressLevel = bestLevel;
+    if (best == Algorithm::Zstd) {
+        lib.m_overallFlags |= CompressedZstd;
+        m_flags |= CompressedZstd;
+    } else if (best == Algorithm::Zlib) {
+        lib.m_overallFlags |= Compressed;
+        m_flags |= Compressed;
+    }
+    if (best != Algorithm::None)
+        *data = std::move(bestData);
+}
+
 qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
     QString *errorMessage)
 {
@@ -243,12 +329,17 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
 
     // Check if compression is useful for this file
     if (data.size() != 0) {
+        // the automatic choice keeps the data it compressed to decide
+        const bool chosen = m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Auto;
+        if (chosen)
+            chooseCompression(lib, &data);
 #if QT_CONFIG(zstd)
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Best && !m_noZstd) {
             m_compressAlgo = RCCResourceLibrary::CompressionAlgorithm::Zstd;
             m_compressLevel = 19;   // not ZSTD_maxCLevel(), as 20+ are experimental
         }
-        if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zstd && !m_noZstd) {
+        if (!chosen && m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zstd
+            && !m_noZstd) {
             if (lib.m_zstdCCtx == nullptr)
                 lib.m_zstdCCtx = ZSTD_createCCtx();
             qsizetype size = data.size();
@@ -296,7 +387,7 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
             m_compressAlgo = RCCResourceLibrary::CompressionAlgorithm::Zlib;
             m_compressLevel = 9;
         }
-        if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zlib) {
+        if (!chosen && m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zlib) {
             QByteArray compressed =
                     qCompress(reinterpret_cast<uchar *>(data.data()), data.size(), m_compressLevel);
 
@@ -441,6 +532,7 @@ RCCResourceLibrary::RCCResourceLibrary(quint8 formatVersion)
     m_compressionAlgo(CompressionAlgorithm::Best),
     m_compressLevel(CONSTANT_COMPRESSLEVEL_DEFAULT),
     m_compressThreshold(CONSTANT_COMPRESSTHRESHOLD_DEFAULT),
+    m_decompressionCost(CONSTANT_DECOMPRESSIONCOST_DEFAULT),
     m_treeOffset(0),
     m_namesOffset(0),
     m_dataOffset(0),
@@ -867,6 +959,8 @@ RCCResourceLibrary::CompressionAlgorithm RCCResourceLibrary::parseCompressionAlg
 {
     if (value == "best"_L1)
         return CompressionAlgorithm::Best;
+    if (value == "auto"_L1)
+        return CompressionAlgorithm::Auto;
     if (value == "zlib"_L1) {
 #ifdef QT_NO_COMPRESS
         *errorMsg = "zlib support not compiled in"_L1;
@@ -893,6 +987,7 @@ int RCCResourceLibrary::parseCompressionLevel(CompressionAlgorithm algo, const Q
     if (ok) {
         switch (algo) {
         case CompressionAlgorithm::None:
+        case CompressionAlgorithm::Auto:
         case CompressionAlgorithm::Best:
             return 0;
         case CompressionAlgorithm::Zlib:
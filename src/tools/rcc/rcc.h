@@ -59,6 +59,7 @@ public:
         Zlib,
         Zstd,
 
+        Auto = 98,
         Best = 99,
         None = -1
     };
@@ -74,6 +75,9 @@ public:
     void setCompressThreshold(int t) { m_compressThreshold = t; }
     int compressThreshold() const { return m_compressThreshold; }
 
+    void setDecompressionCost(int c) { m_decompressionCost = c; }
+    int decompressionCost() const { return m_decompressionCost; }
+
     void setResourceRoot(const QString &root) { m_resourceRoot = root; }
     QString resourceRoot() const { return m_resourceRoot; }
 
@@ -139,6 +143,7 @@ private:
     CompressionAlgorithm m_compressionAlgo;
     int m_compressLevel;
     int m_compressThreshold;
+    int m_decompressionCost;
     int m_treeOffset;
     int m_namesOffset;
     int m_dataOffset;
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include <QTest>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #if QT_CONFIG(process)
 #include <QProcess>
@@ -14,6 +15,8 @@
 #include <qfileinfo.h>
 #include <qstringlist.h>
 
+#include <algorithm>
+
 #if defined(Q_OS_WIN)
 #include <QtCore/private/qfsfileengine_p.h>
 #endif
@@ -81,6 +84,7 @@ private slots:
     void entryListWithTestFiles();
 
     void entryListTimedSort();
+    void entryListLargeSort();
 
     void entryListSimple_data();
     void entryListSimple();
@@ -1007,6 +1011,43 @@ void tst_QDir::entryListTimedSort()
 #endif // QT_CONFIG(process)
 }
 
+void tst_QDir::entryListLargeSort()
+{
+    // Enough entries for their metadata to be fetched in several chunks
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const int count = 500;
+    const QDateTime base = QDateTime::currentDateTimeUtc().addDays(-1);
+    QStringList bySize;
+    QStringList byTime;
+    for (int i = 0; i < count; ++i) {
+        // file names, sizes and times each in a different order
+        const QString name = QString::number((i * 7) % count).rightJustified(3, u'0');
+        QFile file(dir.filePath(name));
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        QCOMPARE(file.write(QByteArray(i, 'x')), qint64(i));
+        QVERIFY(file.flush());
+        QVERIFY(file.setFileTime(base.addSecs((i * 13) % count), QFile::FileModificationTime));
+        bySize.prepend(name);
+    }
+    for (int t = 0; t < count; ++t) {
+        for (int i = 0; i < count; ++i) {
+            if ((i * 13) % count == t)
+                byTime.prepend(QString::number((i * 7) % count).rightJustified(3, u'0'));
+        }
+    }
+
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files, QDir::Size), bySize);
+    std::reverse(bySize.begin(), bySize.end());
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files, QDir::Size | QDir::Reversed), bySize);
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files, QDir::Time), byTime);
+
+    const QFileInfoList infos = QDir(dir.path()).entryInfoList(QDir::Files, QDir::Size);
+    QCOMPARE(infos.size(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(infos.at(i).size(), qint64(count - 1 - i));
+}
+
 void tst_QDir::entryListSimple_data()
 {
     QTest::addColumn<QString>("dirName");
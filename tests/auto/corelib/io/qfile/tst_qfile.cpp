@@ -24,6 +24,10 @@
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
 #include <private/qfilesystemengine_p.h>
+#if QT_CONFIG(future)
+#include <QFuture>
+#include <private/qasyncfileio_p.h>
+#endif
 
 #ifdef Q_OS_WIN
 #include <QtCore/private/qfunctions_win_p.h>
@@ -286,6 +290,11 @@ private slots:
 
     void reuseQFile();
 
+    void readAsync();
+    void writeAsync();
+    void readAllAsync_data();
+    void readAllAsync();
+
     void moveToTrash_data();
     void moveToTrash();
     void moveToTrashOpenFile_data();
@@ -3913,6 +3922,135 @@ void tst_QFile::reuseQFile()
     }
 }
 
+void tst_QFile::readAsync()
+{
+#if QT_CONFIG(future)
+    QFile file(m_testSourceFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QVERIFY(file.seek(10));
+
+    QFuture<QByteArray> future = file.readAsync(100, 50);
+    QCOMPARE(future.result(), contents.mid(100, 50));
+    QCOMPARE(file.pos(), 10);
+
+    // past the end, and the file closed meanwhile
+    future = file.readAsync(contents.size() - 5, 100);
+    file.close();
+    QCOMPARE(future.result(), contents.right(5));
+
+    // no native handle
+    QFile resource(":/tst_qfileinfo/resources/file1.ext1");
+    QVERIFY(resource.open(QIODevice::ReadOnly));
+    QCOMPARE(resource.readAsync(0, 100).result(), resource.readAll());
+
+    QTest::ignoreMessage(QtWarningMsg, "QFile::readAsync: File not open for reading");
+    QVERIFY(file.readAsync(0, 10).result().isNull());
+
+#ifdef Q_OS_UNIX
+    int pipes[2] = { -1, -1 };
+    QVERIFY2(pipe(pipes) == 0, qPrintable(qt_error_string()));
+    QFile pipeFile;
+    QVERIFY(pipeFile.open(pipes[0], QIODevice::ReadOnly, QFile::AutoCloseHandle));
+    qt_safe_close(pipes[1]);
+    QVERIFY(pipeFile.isSequential());
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QFile::readAsync: Cannot read from a sequential file at an offset");
+    QVERIFY(pipeFile.readAsync(0, 10).result().isNull());
+#endif
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
+void tst_QFile::writeAsync()
+{
+#if QT_CONFIG(future)
+    QFile file("writeAsync.txt");
+    QVERIFY(file.open(QIODevice::ReadWrite | QIODevice::Truncate));
+    file.write("0123456789");
+
+    // the buffered write is flushed first
+    QFuture<qint64> future = file.writeAsync(5, "abcdefghij");
+    QCOMPARE(future.result(), 10);
+    QCOMPARE(file.pos(), 10);
+    QCOMPARE(file.readAsync(0, 100).result(), "01234abcdefghij");
+    file.close();
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), "01234abcdefghij");
+    QTest::ignoreMessage(QtWarningMsg, "QFile::writeAsync: File not open for writing");
+    QCOMPARE(file.writeAsync(0, "x").result(), -1);
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
+void tst_QFile::readAllAsync_data()
+{
+#if QT_CONFIG(future) && defined(QT_BUILD_INTERNAL)
+    QTest::addColumn<bool>("threadPool");
+    QTest::newRow("default") << false;
+    QTest::newRow("threadpool") << true;
+#endif
+}
+
+void tst_QFile::readAllAsync()
+{
+#if QT_CONFIG(future)
+    // more files than the io_uring takes in flight at once
+    QStringList fileNames;
+    QList<QByteArray> expected;
+    for (int i = 0; i < 300; ++i) {
+        const QString fileName = u"readAllAsync%1.txt"_s.arg(i);
+        QByteArray contents = QByteArray::number(i).repeated(i * 10);
+        if (contents.isNull())
+            contents = QByteArray("", 0);   // empty, not an error
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(contents), contents.size());
+        fileNames.append(fileName);
+        expected.append(contents);
+    }
+    fileNames.append("readAllAsync-missing.txt");
+    expected.append(QByteArray());
+    fileNames.append(m_temporaryDir.path());
+    expected.append(QByteArray());
+    fileNames.append(":/tst_qfileinfo/resources/file1.ext1");
+    QFile resource(fileNames.last());
+    QVERIFY(resource.open(QIODevice::ReadOnly));
+    expected.append(resource.readAll());
+#  if defined(Q_OS_LINUX)
+    // claims a size of 0
+    fileNames.append("/proc/self/status");
+    expected.append(QByteArray());
+#  endif
+
+#  ifdef QT_BUILD_INTERNAL
+    QFETCH(bool, threadPool);
+    QAsyncFileIO io(threadPool ? QAsyncFileIO::Backend::ThreadPool
+                               : QAsyncFileIO::Backend::Automatic);
+    const QFuture<QByteArray> future = io.readFiles(fileNames);
+#  else
+    const QFuture<QByteArray> future = QFile::readAllAsync(fileNames);
+#  endif
+    const QList<QByteArray> results = future.results();
+    QCOMPARE(results.size(), expected.size());
+#  if defined(Q_OS_LINUX)
+    QVERIFY(results.last().contains("Name:"));
+    expected.last() = results.last();
+#  endif
+    for (qsizetype i = 0; i < results.size(); ++i) {
+        QCOMPARE(results.at(i), expected.at(i));
+        QCOMPARE(results.at(i).isNull(), expected.at(i).isNull());
+    }
+
+    QVERIFY(QFile::readAllAsync({}).isFinished());
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
 void tst_QFile::moveToTrash_data()
 {
     QTest::addColumn<QString>("source");
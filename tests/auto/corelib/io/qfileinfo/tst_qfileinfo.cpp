@@ -212,6 +212,7 @@ private slots:
     void isNativePath();
 
     void refresh();
+    void statList();
 
 #if defined(Q_OS_WIN)
     void ntfsJunctionPointsAndSymlinks_data();
@@ -1662,6 +1663,42 @@ void tst_QFileInfo::refresh()
     QCOMPARE(info2.size(), info.size());
 }
 
+void tst_QFileInfo::statList()
+{
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    QFileInfoList list;
+    for (int i = 0; i < 200; ++i) {
+        const QString fileName = dir.filePath(QString::number(i));
+        QFile file(fileName);
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        QCOMPARE(file.write(QByteArray(i, 'x')), qint64(i));
+        list.append(QFileInfo(fileName));
+    }
+    list.append(list.first()); // shares the private
+    list.append(QFileInfo(dir.filePath("missing")));
+    list.append(QFileInfo(":/tst_qfileinfo/resources/"));
+    list.append(QFileInfo());
+
+    QFileInfo::stat(list);
+
+    // The sizes must come from the cache, not from the files as they are now
+    for (int i = 0; i < 200; ++i) {
+        QFile file(list.at(i).filePath());
+        QVERIFY(file.open(QIODevice::Append));
+        QCOMPARE(file.write("more"), qint64(4));
+    }
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(list.at(i).size(), qint64(i));
+    QCOMPARE(list.at(200).size(), qint64(0));
+    QVERIFY(!list.at(201).exists());
+    QVERIFY(list.at(202).isDir());
+    QVERIFY(!list.at(203).exists());
+
+    list.first().refresh();
+    QCOMPARE(list.first().size(), qint64(4));
+}
+
 #if defined(Q_OS_WIN)
 
 struct NtfsTestResource {
@@ -10,6 +10,7 @@
 #include <QElapsedTimer>
 #include <QTextStream>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QDir>
 #include <QSignalSpy>
@@ -71,6 +72,10 @@ private slots:
     void watchDirectoryAttributeChanges();
 #endif
 
+    void recursivePath();
+    void recursivePathRemoved();
+    void coalescing();
+
 private:
     QString m_tempDirPattern;
 };
@@ -841,5 +846,170 @@ void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 }
 #endif
 
+static bool createFile(const QString &fileName, const QByteArray &contents = "data")
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+}
+
+static QStringList changedPaths(const QSignalSpy &spy)
+{
+    QStringList paths;
+    for (const QList<QVariant> &arguments : spy)
+        paths += arguments.at(0).toStringList();
+    return paths;
+}
+
+void tst_QFileSystemWatcher::recursivePath()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    const QString outside = temporaryDirectory.filePath("outside");
+    const QString root = temporaryDirectory.filePath("root");
+    QDir rootDir(root);
+    QVERIFY(rootDir.mkpath("a/b"));
+    QVERIFY(rootDir.mkpath(".hidden"));
+    QVERIFY(createFile(rootDir.filePath("file")));
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(root))
+        QSKIP("Recursive watching is not supported on this platform");
+    QCOMPARE(watcher.recursiveDirectories(), QStringList(root));
+    QVERIFY(!watcher.addRecursivePath(root));
+    QVERIFY(!watcher.addRecursivePath(rootDir.filePath("file")));
+    QVERIFY(!watcher.addRecursivePath(rootDir.filePath("missing")));
+    QVERIFY(watcher.directories().isEmpty());
+
+    QSignalSpy spy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    // existing directories, including hidden ones
+    QVERIFY(createFile(rootDir.filePath("a/b/new")));
+    QVERIFY(createFile(rootDir.filePath(".hidden/new")));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath("a/b/new")));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath(".hidden/new")));
+
+    // a new directory, and the entries created in it before it was watched
+    QVERIFY(rootDir.mkpath("c/d"));
+    QVERIFY(createFile(rootDir.filePath("c/d/new")));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath("c/d/new")));
+    spy.clear();
+    QVERIFY(createFile(rootDir.filePath("c/d/later")));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath("c/d/later")));
+
+    // moved within the tree
+    QVERIFY(rootDir.rename("c", "a/moved"));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath("a/moved")));
+    QVERIFY(createFile(rootDir.filePath("a/moved/d/new2")));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath("a/moved/d/new2")));
+
+    // moved out of the tree
+    spy.clear();
+    QVERIFY(QDir().rename(rootDir.filePath("a/moved"), outside));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath("a/moved")));
+    QVERIFY(createFile(outside + "/d/new3"));
+    QVERIFY(createFile(rootDir.filePath("marker")));
+    QTRY_VERIFY(changedPaths(spy).contains(rootDir.filePath("marker")));
+    for (const QString &path : changedPaths(spy))
+        QVERIFY2(!path.endsWith("new3"), qPrintable(path));
+
+    // each path is reported once per batch
+    for (const QList<QVariant> &arguments : std::as_const(spy)) {
+        const QStringList batch = arguments.at(0).toStringList();
+        QCOMPARE(QSet<QString>(batch.begin(), batch.end()).size(), batch.size());
+    }
+
+    QVERIFY(watcher.removeRecursivePath(root));
+    QVERIFY(watcher.recursiveDirectories().isEmpty());
+    QVERIFY(!watcher.removeRecursivePath(root));
+    spy.clear();
+    QVERIFY(createFile(rootDir.filePath("a/b/unwatched")));
+    QTest::qWait(200);
+    QCOMPARE(spy.size(), 0);
+}
+
+void tst_QFileSystemWatcher::recursivePathRemoved()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    const QString root = temporaryDirectory.filePath("root");
+    QVERIFY(QDir(temporaryDirectory.path()).mkpath("root/a/b"));
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(root))
+        QSKIP("Recursive watching is not supported on this platform");
+    QSignalSpy spy(&watcher, &QFileSystemWatcher::pathsChanged);
+
+    QVERIFY(QDir(root).removeRecursively());
+    QTRY_VERIFY(watcher.recursiveDirectories().isEmpty());
+    QTRY_VERIFY(changedPaths(spy).contains(root));
+    QVERIFY(changedPaths(spy).contains(root + "/a"));
+
+    // can be watched again once it's back
+    QVERIFY(QDir(temporaryDirectory.path()).mkdir("root"));
+    QVERIFY(watcher.addRecursivePath(root));
+}
+
+void tst_QFileSystemWatcher::coalescing()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    const QString fileName = temporaryDirectory.filePath("file");
+    const QString root = temporaryDirectory.filePath("root");
+    QVERIFY(createFile(fileName));
+    QVERIFY(QDir(temporaryDirectory.path()).mkdir("root"));
+
+    QFileSystemWatcher watcher;
+    QCOMPARE(watcher.coalescingInterval(), std::chrono::milliseconds(0));
+    watcher.setCoalescingInterval(std::chrono::milliseconds(500));
+    QCOMPARE(watcher.coalescingInterval(), std::chrono::milliseconds(500));
+    QVERIFY(watcher.addPath(fileName));
+    const bool recursive = watcher.addRecursivePath(root);
+
+    QSignalSpy fileSpy(&watcher, &QFileSystemWatcher::fileChanged);
+    QSignalSpy pathsSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::Append));
+    for (int i = 0; i < 20; ++i) {
+        QCOMPARE(file.write("more"), qint64(4));
+        QVERIFY(file.flush());
+        if (recursive)
+            QVERIFY(createFile(root + "/file" + QString::number(i % 4)));
+        QTest::qWait(5);
+    }
+    file.close();
+
+    QTRY_COMPARE(fileSpy.size(), 1);
+    QCOMPARE(fileSpy.at(0).at(0).toString(), fileName);
+    if (recursive) {
+        QTRY_COMPARE(pathsSpy.size(), 1);
+        QStringList paths = pathsSpy.at(0).at(0).toStringList();
+        paths.sort();
+        const QStringList expected = { root + "/file0", root + "/file1", root + "/file2",
+                                       root + "/file3" };
+        QCOMPARE(paths, expected);
+    }
+    QTest::qWait(700);
+    QCOMPARE(fileSpy.size(), 1);
+
+    // pending changes are reported when coalescing is turned off
+    QVERIFY(file.open(QIODevice::Append));
+    QCOMPARE(file.write("more"), qint64(4));
+    file.close();
+    QTest::qWait(100);
+    QCOMPARE(fileSpy.size(), 1);
+    watcher.setCoalescingInterval(std::chrono::milliseconds(0));
+    QCOMPARE(fileSpy.size(), 2);
+
+    // and not if the path is no longer watched
+    watcher.setCoalescingInterval(std::chrono::milliseconds(500));
+    QVERIFY(file.open(QIODevice::Append));
+    QCOMPARE(file.write("more"), qint64(4));
+    file.close();
+    QTest::qWait(100);
+    QVERIFY(watcher.removePath(fileName));
+    QTest::qWait(700);
+    QCOMPARE(fileSpy.size(), 2);
+}
+
 QTEST_MAIN(tst_QFileSystemWatcher)
 #include "tst_qfilesystemwatcher.moc"
@@ -0,0 +1,212 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QDirIterator>
+#include <QFile>
+#include <QParallelDirIterator>
+#include <QTemporaryDir>
+
+Q_DECLARE_METATYPE(QDir::Filters)
+Q_DECLARE_METATYPE(QParallelDirIterator::IteratorFlags)
+
+class tst_QParallelDirIterator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void sameEntriesAsDirIterator_data();
+    void sameEntriesAsDirIterator();
+    void fetchMetaData();
+    void stopLinkLoop();
+    void iterateResource();
+    void nonExistentPath();
+    void destroyWhileListing();
+
+private:
+    QStringList sortedParallel(const QString &path, const QStringList &nameFilters,
+                               QDir::Filters filters, QParallelDirIterator::IteratorFlags flags,
+                               int threads = -1);
+
+    QTemporaryDir tempDir;
+    QString treePath;
+};
+
+static bool createFile(const QString &fileName, const QByteArray &contents = {})
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+}
+
+// A tree with more entries than fit in one batch, with hidden entries and
+// symlinks.
+void tst_QParallelDirIterator::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    treePath = tempDir.filePath("tree");
+    QDir root(tempDir.path());
+    QVERIFY(root.mkdir("tree"));
+    QDir tree(treePath);
+    for (int i = 0; i < 8; ++i) {
+        const QString sub = QString::number(i);
+        QVERIFY(tree.mkpath(sub + "/a/b"));
+        for (int j = 0; j < 100; ++j)
+            QVERIFY(createFile(tree.filePath(sub + "/file" + QString::number(j) + ".txt")));
+        QVERIFY(createFile(tree.filePath(sub + "/a/b/deep.cpp"), "int main() {}"));
+    }
+    QVERIFY(tree.mkpath(".hidden/inside"));
+    QVERIFY(createFile(tree.filePath(".hidden/inside/secret.txt")));
+    QVERIFY(createFile(tree.filePath(".dotfile")));
+#if defined(Q_OS_UNIX)
+    QVERIFY(QFile::link("0/a", tree.filePath("linkToDir")));
+    QVERIFY(QFile::link("0/file0.txt", tree.filePath("linkToFile")));
+    QVERIFY(QFile::link("nowhere", tree.filePath("brokenLink")));
+#endif
+}
+
+QStringList tst_QParallelDirIterator::sortedParallel(const QString &path,
+                                                     const QStringList &nameFilters,
+                                                     QDir::Filters filters,
+                                                     QParallelDirIterator::IteratorFlags flags,
+                                                     int threads)
+{
+    QStringList list;
+    QParallelDirIterator it(path, nameFilters, filters, flags);
+    if (threads > 0)
+        it.setMaxThreadCount(threads);
+    while (it.hasNext())
+        list.append(it.next());
+    list.sort();
+    return list;
+}
+
+void tst_QParallelDirIterator::sameEntriesAsDirIterator_data()
+{
+    QTest::addColumn<QStringList>("nameFilters");
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QParallelDirIterator::IteratorFlags>("flags");
+    QTest::addColumn<int>("threads");
+
+    const QParallelDirIterator::IteratorFlags none;
+    for (int threads : { 1, 4 }) {
+        QTest::addRow("default-%d", threads)
+                << QStringList() << QDir::Filters(QDir::NoFilter) << none << threads;
+        QTest::addRow("files-%d", threads)
+                << QStringList() << QDir::Filters(QDir::Files) << none << threads;
+        QTest::addRow("dirs-hidden-%d", threads)
+                << QStringList() << QDir::Filters(QDir::Dirs | QDir::Hidden) << none << threads;
+        QTest::addRow("nosymlinks-%d", threads)
+                << QStringList() << QDir::Filters(QDir::AllEntries | QDir::NoSymLinks)
+                << none << threads;
+        QTest::addRow("system-%d", threads)
+                << QStringList() << QDir::Filters(QDir::AllEntries | QDir::System)
+                << none << threads;
+        QTest::addRow("namefilter-%d", threads)
+                << QStringList{ "*.cpp", "file1*" } << QDir::Filters(QDir::NoFilter)
+                << none << threads;
+        QTest::addRow("metadata-%d", threads)
+                << QStringList() << QDir::Filters(QDir::AllEntries | QDir::Hidden)
+                << QParallelDirIterator::IteratorFlags(QParallelDirIterator::FetchMetaData)
+                << threads;
+    }
+}
+
+void tst_QParallelDirIterator::sameEntriesAsDirIterator()
+{
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QParallelDirIterator::IteratorFlags, flags);
+    QFETCH(int, threads);
+
+    // QDirIterator lists "." and ".."; QDir::NoFilter can't be combined
+    const QDir::Filters dirIteratorFilters =
+            (filters == QDir::NoFilter ? QDir::AllEntries : filters) | QDir::NoDotAndDotDot;
+    QStringList expected;
+    QDirIterator it(treePath, nameFilters, dirIteratorFilters, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        expected.append(it.next());
+    expected.sort();
+    QVERIFY(!expected.isEmpty());
+
+    QCOMPARE(sortedParallel(treePath, nameFilters, filters, flags, threads), expected);
+}
+
+void tst_QParallelDirIterator::fetchMetaData()
+{
+    QParallelDirIterator it(treePath, { "deep.cpp" }, QDir::Files,
+                            QParallelDirIterator::FetchMetaData);
+    int count = 0;
+    while (it.hasNext()) {
+        const QFileInfo fi = it.nextFileInfo();
+        QCOMPARE(it.fileInfo(), fi);
+        QCOMPARE(it.filePath(), fi.filePath());
+        QVERIFY(fi.isFile());
+        QCOMPARE(fi.size(), qint64(strlen("int main() {}")));
+        QVERIFY(fi.lastModified().isValid());
+        ++count;
+    }
+    QCOMPARE(count, 8);
+    QCOMPARE(it.path(), treePath);
+}
+
+void tst_QParallelDirIterator::stopLinkLoop()
+{
+#if defined(Q_OS_UNIX)
+    const QString loopPath = tempDir.filePath("loop");
+    QVERIFY(QDir(tempDir.path()).mkpath("loop/sub"));
+    QVERIFY(QFile::link("..", loopPath + "/sub/up"));
+    QVERIFY(QFile::link(".", loopPath + "/self"));
+
+    const QStringList expected = {
+        loopPath + "/self",
+        loopPath + "/sub",
+        loopPath + "/sub/up",
+    };
+    QCOMPARE(sortedParallel(loopPath, {}, QDir::NoFilter, QParallelDirIterator::FollowSymlinks),
+             expected);
+
+    // A directory reachable through a symlink is listed once, through
+    // whichever path got there first
+    const QStringList list = sortedParallel(treePath, { "deep.cpp" }, QDir::Files,
+                                            QParallelDirIterator::FollowSymlinks);
+    QCOMPARE(list.size(), 8);
+#else
+    QSKIP("Symlinks are only created on Unix");
+#endif
+}
+
+void tst_QParallelDirIterator::iterateResource()
+{
+    const QStringList expected = {
+        ":/testdata/resources/directory",
+        ":/testdata/resources/directory/dummy",
+        ":/testdata/resources/file",
+    };
+    QCOMPARE(sortedParallel(":/testdata/resources", {}, QDir::NoFilter, {}), expected);
+}
+
+void tst_QParallelDirIterator::nonExistentPath()
+{
+    QParallelDirIterator it(tempDir.filePath("does-not-exist"));
+    QVERIFY(!it.hasNext());
+    QVERIFY(it.next().isEmpty());
+    QVERIFY(!it.nextFileInfo().exists());
+}
+
+void tst_QParallelDirIterator::destroyWhileListing()
+{
+    // Must neither hang nor crash with workers waiting for room in the queue
+    for (int threads : { 1, 4 }) {
+        QParallelDirIterator it(treePath);
+        it.setMaxThreadCount(threads);
+        QCOMPARE(it.maxThreadCount(), threads);
+        QVERIFY(it.hasNext());
+        it.next();
+    }
+}
+
+QTEST_MAIN(tst_QParallelDirIterator)
+
+#include "tst_qparalleldiriterator.moc"
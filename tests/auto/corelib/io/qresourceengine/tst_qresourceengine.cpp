@@ -6,6 +6,7 @@
 #include <QResource>
 #include <QtPlugin>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QProcess>
 #include <QtCore/QScopeGuard>
 #include <QtCore/private/qglobal_p.h>
 
@@ -32,6 +33,8 @@ private slots:
     void checkUnregisterResource();
     void compressedResource_data();
     void compressedResource();
+    void decompressionCacheInvalidation();
+    void decompressionCacheDisabled();
     void checkStructure_data();
     void checkStructure();
     void searchPath_data();
@@ -131,6 +134,10 @@ void tst_QResourceEngine::compressedResource()
     } else {
         // reasonable expectation:
         QVERIFY(resource.size() < ZERO_FILE_LEN);
+
+        // decompressed once, then shared
+        QCOMPARE(static_cast<const void *>(resource.uncompressedData().constData()),
+                 static_cast<const void *>(resource.uncompressedData().constData()));
     }
 
     // using the engine
@@ -152,6 +159,58 @@ void tst_QResourceEngine::compressedResource()
     QCOMPARE(data, expectedData);
 }
 
+void tst_QResourceEngine::decompressionCacheInvalidation()
+{
+    QFile file(QFINDTESTDATA("zlib.rcc"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray buffer = file.readAll();
+    const auto data = reinterpret_cast<const uchar *>(buffer.constData());
+
+    QVERIFY(QResource::registerResource(data, "/reloaded"));
+    const QByteArray first = QResource(":/reloaded/zero.txt").uncompressedData();
+    QCOMPARE(first, QByteArray(ZERO_FILE_LEN, '\0'));
+    QCOMPARE(QResource(":/reloaded/zero.txt").uncompressedData().constData(), first.constData());
+    QVERIFY(QResource::unregisterResource(data, "/reloaded"));
+
+    // registered again at the same address, the data must be decompressed anew
+    QVERIFY(QResource::registerResource(data, "/reloaded"));
+    auto unregister = qScopeGuard([=] { QResource::unregisterResource(data, "/reloaded"); });
+    const QByteArray second = QResource(":/reloaded/zero.txt").uncompressedData();
+    QCOMPARE(second, first);
+    QVERIFY(second.constData() != first.constData());
+}
+
+void tst_QResourceEngine::decompressionCacheDisabled()
+{
+    bool ok;
+    if (qEnvironmentVariableIntValue("QT_RESOURCE_CACHE_SIZE", &ok) == 0 && ok) {
+        // in the process started below
+        const QString fileName = QFINDTESTDATA("zlib.rcc");
+        QVERIFY(QResource::registerResource(fileName, "/uncached"));
+        auto unregister = qScopeGuard([=] { QResource::unregisterResource(fileName, "/uncached"); });
+        QResource resource(":/uncached/zero.txt");
+        const QByteArray first = resource.uncompressedData();
+        QCOMPARE(first, QByteArray(ZERO_FILE_LEN, '\0'));
+        QVERIFY(resource.uncompressedData().constData() != first.constData());
+        return;
+    }
+
+#if QT_CONFIG(process)
+    // the size of the cache is read once per process
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert("QT_RESOURCE_CACHE_SIZE", "0");
+    QProcess process;
+    process.setProcessEnvironment(environment);
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.start(QCoreApplication::applicationFilePath(), { "decompressionCacheDisabled" });
+    QVERIFY2(process.waitForFinished(), qPrintable(process.errorString()));
+    QVERIFY2(process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0,
+             process.readAll().constData());
+#else
+    QSKIP("This test requires QProcess support");
+#endif
+}
+
 
 void tst_QResourceEngine::checkStructure_data()
 {
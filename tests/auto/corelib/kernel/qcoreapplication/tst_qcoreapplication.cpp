@@ -17,6 +17,9 @@
 #include <QtCore/qt_windows.h>
 #endif
 
+#include <memory>
+#include <numeric>
+
 typedef QCoreApplication TestApplication;
 
 class EventSpy : public QObject
@@ -511,6 +514,80 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+class OrderedEvent : public QEvent
+{
+public:
+    OrderedEvent(int producer, int sequence)
+        : QEvent(QEvent::User), producer(producer), sequence(sequence)
+    {}
+    int producer;
+    int sequence;
+};
+
+class OrderRecordingObject : public QObject
+{
+public:
+    explicit OrderRecordingObject(int producerCount) : received(producerCount) {}
+
+    void record(int producer, int sequence)
+    {
+        received[producer].append(sequence);
+        ++total;
+    }
+
+    bool event(QEvent *event) override
+    {
+        if (event->type() == QEvent::User) {
+            const auto *e = static_cast<OrderedEvent *>(event);
+            record(e->producer, e->sequence);
+            return true;
+        }
+        return QObject::event(event);
+    }
+
+    QList<QList<int>> received;
+    int total = 0;
+};
+
+void tst_QCoreApplication::queuedInvocationsFromThreadsKeepOrder()
+{
+    // queued invocations take a lock-free path in postEvent(), other events
+    // don't; mixing the two must keep the order of each producer's events
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    constexpr int ProducerCount = 4;
+    // more than fits in the lock-free inbox, to exercise the fallback too
+    constexpr int EventsPerProducer = 5000;
+
+    OrderRecordingObject receiver(ProducerCount);
+    std::vector<std::unique_ptr<QThread>> producers;
+    for (int p = 0; p < ProducerCount; ++p) {
+        producers.emplace_back(QThread::create([&receiver, p] {
+            for (int i = 0; i < EventsPerProducer; ++i) {
+                if (i % 7 == 0) {
+                    QCoreApplication::postEvent(&receiver, new OrderedEvent(p, i));
+                } else {
+                    QMetaObject::invokeMethod(&receiver, [&receiver, p, i] {
+                        receiver.record(p, i);
+                    }, Qt::QueuedConnection);
+                }
+            }
+        }));
+        producers.back()->start();
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.total, ProducerCount * EventsPerProducer, 20000);
+    for (auto &producer : producers)
+        QVERIFY(producer->wait());
+
+    QList<int> expected(EventsPerProducer);
+    std::iota(expected.begin(), expected.end(), 0);
+    for (int p = 0; p < ProducerCount; ++p)
+        QCOMPARE(receiver.received.at(p), expected);
+}
 #endif // QT_CONFIG(thread)
 
 void tst_QCoreApplication::applicationPid()
@@ -20,6 +20,7 @@ private slots:
     void removePostedEvents();
 #if QT_CONFIG(thread)
     void deliverInDefinedOrder();
+    void queuedInvocationsFromThreadsKeepOrder();
 #endif
     void applicationPid();
 #ifdef QT_BUILD_INTERNAL
@@ -26,6 +26,7 @@
 #include <QThread>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QSemaphore>
 #include <QScopedPointer>
 #if QT_CONFIG(process)
 # include <QProcess>
@@ -33,6 +34,7 @@
 #include "qobject.h"
 #ifdef QT_BUILD_INTERNAL
 #include <private/qobject_p.h>
+#include <private/qeventmemorypool_p.h>
 #endif
 
 #include <functional>
@@ -147,6 +149,8 @@ private slots:
     void functorReferencesConnection();
     void disconnectDisconnects();
     void singleShotConnection();
+    void batchedConnection();
+    void queuedCallMemoryPool();
     void objectNameBinding();
     void emitToDestroyedClass();
     void declarativeData();
@@ -8265,6 +8269,163 @@ void tst_QObject::singleShotConnection()
     }
 }
 
+void tst_QObject::batchedConnection()
+{
+    const auto batched = Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection);
+
+    {
+        // calls to the same receiver share one posted event, in order
+        SenderObject sender;
+        QObject receiver;
+        EventSpy spy;
+        receiver.installEventFilter(&spy);
+
+        QList<int> calls;
+        connect(&sender, &SenderObject::signal7, &receiver,
+                [&](int i, const QString &s) {
+                    QCOMPARE(s, QString::number(i));
+                    calls << i;
+                }, batched);
+
+        for (int i = 0; i < 3; ++i)
+            emit sender.signal7(i, QString::number(i));
+        QVERIFY(calls.isEmpty());
+
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(calls, QList<int>({ 0, 1, 2 }));
+        QCOMPARE(spy.eventList().size(), 1);
+        QCOMPARE(spy.eventList().at(0).second, QEvent::MetaCall);
+
+        // a delivered batch is closed, the next emission opens a new one
+        emit sender.signal7(3, QString::number(3));
+        emit sender.signal7(4, QString::number(4));
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(calls, QList<int>({ 0, 1, 2, 3, 4 }));
+        QCOMPARE(spy.eventList().size(), 2);
+    }
+
+    {
+        // string-based connections, sender() is set for each call
+        SenderObject sender1;
+        SenderObject sender2;
+        struct : ReceiverObject { using QObject::sender; } receiver;
+        receiver.reset();
+        connect(&sender1, SIGNAL(signal1()), &receiver, SLOT(slot1()), batched);
+        connect(&sender2, SIGNAL(signal2()), &receiver, SLOT(slot2()), batched);
+        QObject *lastSender = nullptr;
+        connect(&sender2, &SenderObject::signal3, &receiver,
+                [&] { lastSender = receiver.sender(); }, batched);
+        sender1.emitSignal1();
+        sender2.emitSignal2();
+        sender2.emitSignal3();
+        QVERIFY(!receiver.called(1));
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        QCOMPARE(receiver.count_slot1, 1);
+        QCOMPARE(receiver.count_slot2, 1);
+        QVERIFY(receiver.sequence_slot1 < receiver.sequence_slot2);
+        QCOMPARE(lastSender, &sender2);
+    }
+
+    {
+        // the receiver is deleted by a call in the batch
+        SenderObject sender;
+        auto *receiver = new QObject;
+        QPointer<QObject> guard(receiver);
+        int calls = 0;
+        connect(&sender, &SenderObject::signal1, receiver, [&] {
+            ++calls;
+            delete receiver;
+        }, batched);
+        sender.emitSignal1();
+        sender.emitSignal1();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::MetaCall);
+        QVERIFY(!guard);
+        QCOMPARE(calls, 1);
+    }
+
+    {
+        // the receiver is deleted before the batch is delivered
+        SenderObject sender;
+        auto receiver = std::make_unique<QObject>();
+        int calls = 0;
+        connect(&sender, &SenderObject::signal7, receiver.get(),
+                [&](int, const QString &) { ++calls; }, batched);
+        emit sender.signal7(1, QStringLiteral("one"));
+        emit sender.signal7(2, QStringLiteral("two"));
+        receiver.reset();
+        emit sender.signal7(3, QStringLiteral("three"));
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::MetaCall);
+        QCOMPARE(calls, 0);
+    }
+
+    {
+        // calls from another thread arrive complete and in order
+        constexpr int Count = 5000;
+        SenderObject sender;
+        QObject receiver;
+        QList<int> calls;
+        connect(&sender, &SenderObject::signal7, &receiver,
+                [&](int i, const QString &) { calls << i; },
+                Qt::ConnectionType(Qt::AutoConnection | Qt::BatchedConnection));
+        std::unique_ptr<QThread> thread(QThread::create([&sender] {
+            for (int i = 0; i < Count; ++i)
+                emit sender.signal7(i, QString());
+        }));
+        thread->start();
+        QVERIFY(thread->wait());
+        QTRY_COMPARE(calls.size(), Count);
+        for (int i = 0; i < Count; ++i)
+            QCOMPARE(calls.at(i), i);
+    }
+}
+
+void tst_QObject::queuedCallMemoryPool()
+{
+    // The receiving thread frees the queued calls the emitting thread
+    // allocates; they must all arrive, in order, with their arguments
+    constexpr int Rounds = 10;
+    constexpr int CallsPerRound = 100;
+#if defined(QT_BUILD_INTERNAL) && !defined(QT_ASAN_ENABLED)
+    const auto before = QEventMemoryPool::statistics();
+#endif
+
+    SenderObject sender;
+    QObject receiver;
+    QSemaphore delivered;
+    int received = 0;
+    int outOfOrder = 0;
+    connect(&sender, &SenderObject::signal7, &receiver, [&](int value, const QString &text) {
+        if (value != received % CallsPerRound || text != QString::number(received))
+            ++outOfOrder;
+        ++received;
+        delivered.release();
+    }, Qt::QueuedConnection);
+
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        int sent = 0;
+        for (int round = 0; round < Rounds; ++round) {
+            for (int i = 0; i < CallsPerRound; ++i)
+                emit sender.signal7(i, QString::number(sent++));
+            delivered.acquire(CallsPerRound);
+        }
+    }));
+    thread->start();
+    QTRY_COMPARE(received, Rounds * CallsPerRound);
+    QVERIFY(thread->wait());
+    QCOMPARE(outOfOrder, 0);
+
+    // No call is delivered twice
+    QCoreApplication::processEvents();
+    QCOMPARE(received, Rounds * CallsPerRound);
+
+#if defined(QT_BUILD_INTERNAL) && !defined(QT_ASAN_ENABLED)
+    // The memory goes back to the emitting thread's pool
+    const auto after = QEventMemoryPool::statistics();
+    QVERIFY(after.remoteFrees > before.remoteFrees);
+    QVERIFY(after.hits > before.hits);
+#endif
+}
+
 void tst_QObject::objectNameBinding()
 {
     QObject obj;
@@ -12,10 +12,14 @@ QT_WARNING_DISABLE_DEPRECATED
 #include "qjsonobject.h"
 #include "qjsonvalue.h"
 #include "qjsondocument.h"
+#include "qcbormap.h"
+#include "qcborvalue.h"
 #include "qregularexpression.h"
 #include "private/qnumeric_p.h"
 #include <limits>
 
+using namespace Qt::StringLiterals;
+
 #define INVALID_UNICODE "\xCE\xBA\xE1"
 #define UNICODE_NON_CHARACTER "\xEF\xBF\xBF"
 #define UNICODE_DJE "\320\202" // Character from the Serbian Cyrillic alphabet
@@ -55,6 +59,7 @@ private Q_SLOTS:
     void testArrayIteration();
 
     void testObjectFind();
+    void testObjectFindLarge();
 
     void testDocument();
 
@@ -86,6 +91,7 @@ private Q_SLOTS:
     void toJsonDenormalValues();
     void fromJson();
     void fromJsonErrors();
+    void fromJsonView();
     void parseNumbers();
     void parseStrings();
     void parseDuplicateKeys();
@@ -121,6 +127,7 @@ private Q_SLOTS:
     void nesting();
 
     void longStrings();
+    void stringSpecialCharacterPositions();
 
     void arrayInitializerList();
     void objectInitializerList();
@@ -1226,6 +1233,69 @@ void tst_QtJson::testObjectFind()
     QCOMPARE(cit, object.constEnd());
 }
 
+void tst_QtJson::testObjectFindLarge()
+{
+    // enough keys and lookups for the object to build its key index
+    QJsonObject object;
+    for (int i = 0; i < 1000; ++i)
+        object[u"key_"_s + QString::number(i)] = i;
+    object[u"k\u00e9y"_s] = -1;
+    object[u"k\u20acy"_s] = -2;
+    QCOMPARE(object.size(), 1002);
+
+    auto checkAll = [](const QJsonObject &object, int keys) {
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int i = 0; i < keys; ++i) {
+                const QString key = u"key_"_s + QString::number(i);
+                if (object.value(key) != QJsonValue(i))
+                    return false;
+                if (object.value(QLatin1StringView(key.toLatin1())) != QJsonValue(i))
+                    return false;
+            }
+        }
+        return object.value(u"k\u00e9y"_s) == QJsonValue(-1)
+                && object.value(QLatin1StringView("k\xe9y")) == QJsonValue(-1)
+                && object.value(u"k\u20acy"_s) == QJsonValue(-2)
+                && !object.contains(u"key_"_s + QString::number(keys))
+                && !object.contains("key"_L1);
+    };
+    QVERIFY(checkAll(object, 1000));
+
+    // changes to the values keep the keys
+    object[u"key_5"_s] = 55;
+    QCOMPARE(object.value(u"key_5"_s), QJsonValue(55));
+    object[u"key_5"_s] = 5;
+
+    // changes to the keys
+    object.insert(u"key_1000"_s, 1000);
+    QVERIFY(checkAll(object, 1001));
+    object.remove(u"key_1000"_s);
+    QVERIFY(!object.contains(u"key_1000"_s));
+    QCOMPARE(object.take(u"key_999"_s), QJsonValue(999));
+    QVERIFY(checkAll(object, 999));
+    object.insert(u"key_999"_s, 999);
+
+    // copies, detached or not
+    const QJsonObject copy = object;
+    object.insert(u"key_1000"_s, 1000);
+    QVERIFY(checkAll(copy, 1000));
+    QVERIFY(!copy.contains(u"key_1000"_s));
+    QVERIFY(checkAll(object, 1001));
+
+    // round trips through CBOR, which appends keys
+    QCborMap map = QCborMap::fromJsonObject(object);
+    map[u"key_1001"_s] = 1001;
+    map.remove(u"key_0"_s);
+    map[u"key_0"_s] = 0;
+    QVERIFY(checkAll(map.toJsonObject(), 1002));
+
+    // from parsed JSON
+    const QJsonObject parsed = QJsonDocument::fromJson(QJsonDocument(object).toJson()).object();
+    QVERIFY(checkAll(parsed, 1001));
+    const QJsonObject view = QJsonDocument::fromJsonView(QJsonDocument(object).toJson()).object();
+    QVERIFY(checkAll(view, 1001));
+}
+
 void tst_QtJson::testDocument()
 {
     QJsonDocument doc;
@@ -1665,6 +1735,18 @@ void tst_QtJson::fromVariantHash()
     QCOMPARE(object.size(), 2);
     QCOMPARE(object.value(QLatin1String("key1")), QJsonValue(QLatin1String("value1")));
     QCOMPARE(object.value(QLatin1String("key2")), QJsonValue(QLatin1String("value2")));
+
+    // the keys come in hash order, but end up sorted
+    for (int i = 0; i < 100; ++i)
+        map.insert(QString::number(i), i);
+    object = QJsonObject::fromVariantHash(map);
+    QCOMPARE(object.size(), 102);
+    QVariantMap sorted;
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+        sorted.insert(it.key(), it.value());
+    QCOMPARE(object, QJsonObject::fromVariantMap(sorted));
+    QCOMPARE(object.keys(), sorted.keys());
+    QCOMPARE(object.value(QLatin1String("42")), QJsonValue(42));
 }
 
 void tst_QtJson::toVariantMap()
@@ -2249,6 +2331,63 @@ void tst_QtJson::fromJsonErrors()
     }
 }
 
+void tst_QtJson::fromJsonView()
+{
+    const QByteArray json =
+            "{\"ascii\": \"text\", \"utf8\": \"caf\xc3\xa9\", \"escaped\": \"a\\\"b\\n\\u00e9\\ud83d\\ude00\","
+            " \"k\\u00e9y\": 1, \"dup\": \"first\", \"dup\": \"second\","
+            " \"list\": [\"x\", \"y\\ty\", {\"z\": \"\"}]}";
+
+    QJsonDocument view;
+    {
+        // the document keeps its own reference to the text
+        QByteArray copy = json;
+        view = QJsonDocument::fromJsonView(copy);
+        copy.fill('?');
+    }
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    QVERIFY(!view.isNull());
+    QCOMPARE(view, doc);
+    QCOMPARE(view.toJson(), doc.toJson());
+    QCOMPARE(QCborValue::fromJsonValue(view.object()).toCbor(),
+             QCborValue::fromJsonValue(doc.object()).toCbor());
+
+    QJsonObject object = view.object();
+    QCOMPARE(object.keys(), doc.object().keys());
+    QCOMPARE(object.value("ascii").toString(), "text"_L1);
+    QCOMPARE(object.value("utf8").toString(), u"café"_s);
+    QCOMPARE(object.value("escaped").toString(), u"a\"b\né\U0001F600"_s);
+    QCOMPARE(object.value(u"kéy").toInteger(), 1);
+    QCOMPARE(object.value("dup").toString(), "second"_L1);
+    QCOMPARE(object.value("escaped"), QJsonValue(u"a\"b\né\U0001F600"_s));
+
+    QJsonArray list = object.value("list").toArray();
+    QVERIFY(list.contains(QJsonValue(u"y\ty"_s)));
+    QCOMPARE(list.at(2).toObject().value("z").toString(), QString(""));
+
+    // copies into other containers and modifications don't disturb the rest
+    QJsonArray other{ object.value("escaped"), object.value("utf8") };
+    list.append(list.at(1));
+    QCOMPARE(list.takeAt(0).toString(), "x"_L1);
+    object.insert("list", list);
+    object.insert("ascii", "changed"_L1);
+    QCOMPARE(other, (QJsonArray{ u"a\"b\né\U0001F600"_s, u"café"_s }));
+    QCOMPARE(object.value("list").toArray(),
+             (QJsonArray{ u"y\ty"_s, QJsonObject{ { "z", "" } }, u"y\ty"_s }));
+    QCOMPARE(object.value("ascii").toString(), "changed"_L1);
+    QCOMPARE(view, doc);
+
+    // same diagnostics as fromJson()
+    for (const QByteArray &broken : { "[\"\\u12x4\"]"_ba, "{\"a\": \"\\x\xff\"}"_ba, "[\"a\\\"]"_ba }) {
+        QJsonParseError viewError;
+        QJsonParseError error;
+        QVERIFY(QJsonDocument::fromJsonView(broken, &viewError).isNull());
+        QVERIFY(QJsonDocument::fromJson(broken, &error).isNull());
+        QCOMPARE(viewError.error, error.error);
+        QCOMPARE(viewError.offset, error.offset);
+    }
+}
+
 void tst_QtJson::parseNumbers()
 {
     {
@@ -3150,6 +3289,34 @@ void tst_QtJson::longStrings()
     }
 }
 
+void tst_QtJson::stringSpecialCharacterPositions()
+{
+    // the parser skips over plain ASCII in blocks of up to 32 characters;
+    // put the characters that end such a run at all positions within and
+    // across blocks
+    const QString specials[] = {
+        QStringLiteral("\""), QStringLiteral("\\"), QStringLiteral("\n"),
+        QString::fromUtf8("\xc3\xa9"), QString::fromUtf8("\xe2\x82\xac"),
+        QString::fromUtf8("\xf0\x9f\x98\x80")
+    };
+    for (const QString &special : specials) {
+        for (int i = 0; i < 70; ++i) {
+            const QString expected = QString(i, u'a') + special + QString(70 - i, u'b');
+            QByteArray json = QJsonDocument(QJsonArray{ expected }).toJson(QJsonDocument::Compact);
+
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().at(0).toString(), expected);
+
+            json.chop(2); // the closing quote and bracket
+            doc = QJsonDocument::fromJson(json, &error);
+            QVERIFY(doc.isNull());
+            QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+        }
+    }
+}
+
 void tst_QtJson::testJsonValueRefDefault()
 {
     QJsonObject empty;
@@ -3246,6 +3413,12 @@ void tst_QtJson::objectInitializerList()
         QJsonObject nested = object["nested"].toObject();
         QCOMPARE(QJsonValue(nested["innerProperty"]), QJsonValue(2));
     }
+    {   // duplicate keys and undefined values work like insert()
+        QJsonObject object{{"b", 1}, {"a", 2}, {"b", 3}, {"c", 4}, {"c", QJsonValue::Undefined},
+                           {"d", QJsonValue::Undefined}};
+        QCOMPARE(object, QJsonObject({{"a", 2}, {"b", 3}}));
+        QCOMPARE(object.keys(), QStringList({"a", "b"}));
+    }
     {   // nested array
         QJsonObject object{{"nested", QJsonArray{"innerValue", 2.1, "bum cyk cyk"}}};
         QCOMPARE(object.count(), 1);
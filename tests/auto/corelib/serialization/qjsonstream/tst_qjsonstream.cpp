@@ -0,0 +1,398 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qjsonstreamreader.h>
+#include <QtCore/qjsonstreamwriter.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tokens_data();
+    void tokens();
+    void byteByByte_data() { tokens_data(); }
+    void byteByByte();
+    void prematureEnd();
+    void newlineDelimited();
+    void largeDevice();
+    void errors_data();
+    void errors();
+
+    void writer_data();
+    void writer();
+    void writerNewlineDelimited();
+    void writerDevice();
+    void roundTrip_data() { tokens_data(); }
+    void roundTrip();
+};
+
+// Describes the tokens the reader returns until the data ends or an error.
+static QStringList readTokens(QJsonStreamReader &reader)
+{
+    QStringList tokens;
+    while (!reader.atEnd()) {
+        const QJsonStreamReader::TokenType type = reader.readNext();
+        switch (type) {
+        case QJsonStreamReader::NoToken:
+        case QJsonStreamReader::Invalid:
+            break;
+        case QJsonStreamReader::Name:
+        case QJsonStreamReader::String:
+            tokens << reader.tokenString() + u':' + reader.text();
+            break;
+        case QJsonStreamReader::Integer:
+            tokens << reader.tokenString() + u':' + QString::number(reader.toInteger());
+            break;
+        case QJsonStreamReader::Double:
+            tokens << reader.tokenString() + u':' + QString::number(reader.toDouble());
+            break;
+        case QJsonStreamReader::Bool:
+            tokens << reader.tokenString() + u':' + (reader.toBool() ? "true"_L1 : "false"_L1);
+            break;
+        default:
+            tokens << reader.tokenString();
+            break;
+        }
+    }
+    return tokens;
+}
+
+void tst_QJsonStream::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("empty-array") << "[]"_ba << QStringList{ "StartArray", "EndArray" };
+    QTest::newRow("empty-object") << " { } "_ba << QStringList{ "StartObject", "EndObject" };
+    QTest::newRow("bom") << "\xef\xbb\xbf[]"_ba << QStringList{ "StartArray", "EndArray" };
+    QTest::newRow("scalars")
+            << "[null, true, false, 0, -12, 1.5, 1e3, 2.0, \"\"]"_ba
+            << QStringList{ "StartArray", "Null", "Bool:true", "Bool:false", "Integer:0",
+                            "Integer:-12", "Double:1.5", "Integer:1000", "Integer:2", "String:",
+                            "EndArray" };
+    QTest::newRow("object")
+            << "{\"b\": [1, {\"c\": {}}], \"a\": \"x\", \"a\": 2}"_ba
+            << QStringList{ "StartObject", "Name:b", "StartArray", "Integer:1", "StartObject",
+                            "Name:c", "StartObject", "EndObject", "EndObject", "EndArray",
+                            "Name:a", "String:x", "Name:a", "Integer:2", "EndObject" };
+    QTest::newRow("strings")
+            << "[\"caf\xc3\xa9\", \"a\\\"b\\\\c\\/\\n\\t\", \"\\u00e9\\ud83d\\ude00\"]"_ba
+            << QStringList{ "StartArray", u"String:café"_s, "String:a\"b\\c/\n\t",
+                            u"String:é\U0001F600"_s, "EndArray" };
+    QTest::newRow("big-integer")
+            << "[9223372036854775807, 9223372036854775808]"_ba
+            << QStringList{ "StartArray", "Integer:9223372036854775807",
+                            "Double:" + QString::number(9223372036854775808.0), "EndArray" };
+}
+
+void tst_QJsonStream::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QStringList, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(readTokens(reader), expected);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(reader.depth(), 0);
+    QCOMPARE(reader.offset(), json.size());
+}
+
+void tst_QJsonStream::byteByByte()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QStringList, expected);
+
+    QJsonStreamReader reader;
+    QStringList tokens;
+    for (char c : std::as_const(json)) {
+        reader.addData(QByteArray(1, c));
+        tokens += readTokens(reader);
+        QVERIFY(reader.error() != QJsonStreamReader::NotWellFormedError);
+    }
+    QCOMPARE(tokens, expected);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+void tst_QJsonStream::prematureEnd()
+{
+    QJsonStreamReader reader("{\"name\": \"val"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    QVERIFY(reader.atEnd());
+    QCOMPARE(reader.depth(), 1);
+
+    // the partial string is kept until the rest arrives
+    reader.addData("ue\", \"n\": 1"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.text(), "value"_L1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+
+    // a number is only complete once something follows it
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.addData("23}"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Integer);
+    QCOMPARE(reader.toInteger(), 123);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QJsonStream::newlineDelimited()
+{
+    QJsonStreamReader reader("{\"a\":1}\n[2]\r\n\n{}\n"_ba);
+    QCOMPARE(readTokens(reader),
+             (QStringList{ "StartObject", "Name:a", "Integer:1", "EndObject", "StartArray",
+                           "Integer:2", "EndArray", "StartObject", "EndObject" }));
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QJsonStream::largeDevice()
+{
+    // many more records than fit into the reader's buffer, and a string
+    // that's larger than it
+    const QByteArray longText(100000, 'x');
+    QByteArray json;
+    constexpr int Records = 5000;
+    for (int i = 0; i < Records; ++i)
+        json += "{\"id\": " + QByteArray::number(i) + ", \"tags\": [\"a\", \"b\"]}\n";
+    json += "[\"" + longText + "\"]\n";
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    qint64 sum = 0;
+    int records = 0;
+    QString lastString;
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::Integer:
+            sum += reader.toInteger();
+            break;
+        case QJsonStreamReader::EndObject:
+            QCOMPARE(reader.depth(), 0);
+            ++records;
+            break;
+        case QJsonStreamReader::String:
+            lastString = reader.text();
+            break;
+        default:
+            break;
+        }
+    }
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    QCOMPARE(records, Records);
+    QCOMPARE(sum, qint64(Records) * (Records - 1) / 2);
+    QCOMPARE(lastString, QLatin1StringView(longText));
+    QCOMPARE(reader.offset(), json.size());
+}
+
+void tst_QJsonStream::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<int>("offset");
+
+    QTest::newRow("scalar-document") << "1 "_ba << 0;
+    QTest::newRow("missing-value-separator") << "[1 2]"_ba << 3;
+    QTest::newRow("missing-name-separator") << "{\"a\" 1}"_ba << 5;
+    QTest::newRow("trailing-comma-object") << "{\"a\": 1, }"_ba << 9;
+    QTest::newRow("trailing-comma-array") << "[1, ]"_ba << 4;
+    QTest::newRow("unquoted-name") << "{a: 1}"_ba << 1;
+    QTest::newRow("missing-value") << "{\"a\": ,}"_ba << 6;
+    QTest::newRow("illegal-literal") << "[nul ]"_ba << 1;
+    QTest::newRow("illegal-number") << "[-x]"_ba << 1;
+    QTest::newRow("illegal-escape") << "[\"\\u12x4\"]"_ba << 6;
+    QTest::newRow("illegal-utf8") << "[\"a\xff\"]"_ba << 2;
+    QTest::newRow("deep-nesting") << QByteArray(1025, '[') << 1024;
+}
+
+void tst_QJsonStream::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(int, offset);
+
+    QJsonStreamReader reader(json);
+    readTokens(reader);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.offset(), offset);
+
+    // same diagnostic as QJsonDocument
+    QJsonParseError parseError;
+    QVERIFY(QJsonDocument::fromJson(json, &parseError).isNull());
+    QCOMPARE(reader.errorString(), parseError.errorString());
+
+    // errors are sticky
+    reader.addData("[]"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    reader.clear();
+    reader.addData("[]"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+}
+
+void tst_QJsonStream::writer_data()
+{
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+    QTest::newRow("compact") << QJsonDocument::Compact;
+    QTest::newRow("indented") << QJsonDocument::Indented;
+}
+
+void tst_QJsonStream::writer()
+{
+    QFETCH(QJsonDocument::JsonFormat, format);
+
+    const QJsonObject object{
+        { "name"_L1, u"caf\u00e9 \"quoted\"\n"_s },
+        { "list"_L1, QJsonArray{ 1, 2.5, true, QJsonValue::Null, QJsonObject{ { "x"_L1, -3 } } } },
+    };
+
+    QByteArray json;
+    QJsonStreamWriter writer(&json);
+    writer.setFormat(format);
+    QCOMPARE(writer.format(), format);
+    writer.writeStartObject();
+    writer.writeName("list"_L1);
+    writer.writeStartArray();
+    writer.writeInteger(1);
+    writer.writeDouble(2.5);
+    writer.writeBool(true);
+    writer.writeNull();
+    writer.writeStartObject();
+    QCOMPARE(writer.depth(), 3);
+    writer.writeName(u"x");
+    writer.writeInteger(-3);
+    writer.writeEndObject();
+    writer.writeEndArray();
+    writer.writeName("name");
+    writer.writeString(object.value("name"_L1).toString());
+    writer.writeEndObject();
+    QCOMPARE(writer.depth(), 0);
+    QVERIFY(!writer.hasError());
+
+    // QJsonObject sorts its keys, so the members were written in that order
+    if (format == QJsonDocument::Compact)
+        QCOMPARE(json, QJsonDocument(object).toJson(format) + '\n');
+    QCOMPARE(QJsonDocument::fromJson(json).object(), object);
+
+    // writeValue() matches what the individual calls wrote
+    QByteArray fromValue;
+    QJsonStreamWriter valueWriter(&fromValue);
+    valueWriter.setFormat(format);
+    valueWriter.writeStartArray();
+    valueWriter.writeValue(object);
+    valueWriter.writeEndArray();
+    QCOMPARE(QJsonDocument::fromJson(fromValue).array(), QJsonArray{ object });
+}
+
+void tst_QJsonStream::writerNewlineDelimited()
+{
+    QByteArray json;
+    QJsonStreamWriter writer(&json);
+    for (int i = 0; i < 3; ++i) {
+        writer.writeStartObject();
+        writer.writeName("id");
+        writer.writeInteger(i);
+        writer.writeEndObject();
+    }
+    writer.writeStartArray();
+    writer.writeEndArray();
+    QCOMPARE(json, "{\"id\":0}\n{\"id\":1}\n{\"id\":2}\n[]\n"_ba);
+}
+
+void tst_QJsonStream::writerDevice()
+{
+    QByteArray json;
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QJsonStreamWriter writer(&buffer);
+    QCOMPARE(writer.device(), &buffer);
+
+    // output is buffered within a document, but not across documents
+    writer.writeStartArray();
+    writer.writeString("x");
+    QVERIFY(json.isEmpty());
+    constexpr int Elements = 20000;
+    for (int i = 1; i < Elements; ++i)
+        writer.writeString("x");
+    QVERIFY(!json.isEmpty());
+    writer.writeEndArray();
+    QCOMPARE(json.size(), 2 + Elements * 4);
+    QVERIFY(json.endsWith("\"x\"]\n"));
+
+    writer.writeStartArray();
+    writer.writeEndArray();
+    QVERIFY(json.endsWith("]\n[]\n"));
+    QVERIFY(!writer.hasError());
+
+    buffer.close();
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): ReadOnly device");
+    writer.writeStartArray();
+    writer.writeEndArray();
+    QVERIFY(writer.hasError());
+}
+
+void tst_QJsonStream::roundTrip()
+{
+    QFETCH(QByteArray, json);
+
+    // copying the tokens reproduces the compact form of the document
+    QByteArray copy;
+    QJsonStreamWriter writer(&copy);
+    QJsonStreamReader reader(json);
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::StartArray:
+            writer.writeStartArray();
+            break;
+        case QJsonStreamReader::EndArray:
+            writer.writeEndArray();
+            break;
+        case QJsonStreamReader::StartObject:
+            writer.writeStartObject();
+            break;
+        case QJsonStreamReader::EndObject:
+            writer.writeEndObject();
+            break;
+        case QJsonStreamReader::Name:
+            writer.writeName(reader.text());
+            break;
+        case QJsonStreamReader::String:
+            writer.writeString(reader.text());
+            break;
+        case QJsonStreamReader::Integer:
+            writer.writeInteger(reader.toInteger());
+            break;
+        case QJsonStreamReader::Double:
+            writer.writeDouble(reader.toDouble());
+            break;
+        case QJsonStreamReader::Bool:
+            writer.writeBool(reader.toBool());
+            break;
+        case QJsonStreamReader::Null:
+            writer.writeNull();
+            break;
+        case QJsonStreamReader::NoToken:
+        case QJsonStreamReader::Invalid:
+            break;
+        }
+    }
+    QVERIFY(!reader.hasError());
+    QCOMPARE(QJsonDocument::fromJson(copy), QJsonDocument::fromJson(json));
+}
+
+QTEST_MAIN(tst_QJsonStream)
+#include "tst_qjsonstream.moc"
@@ -1375,6 +1375,19 @@ void tst_QByteArrayApiSymmetry::toLongLong_data() const
     QTest::newRow("min - 1 hex") << big << 16 << 0LL << false;
     big.insert(1, "0x"); // after minus sign
     QTest::newRow("min - 1, 0x base 0") << big << 0 << 0LL << false;
+
+    // Decimal digits are read eight at a time, where possible:
+    QTest::newRow("8 digits") << QByteArray("12345678") << 10 << 12345678LL << true;
+    QTest::newRow("16 digits")
+        << QByteArray("1234567890123456") << 10 << 1234567890123456LL << true;
+    QTest::newRow("8 digits, junk") << QByteArray("1234567x") << 10 << 0LL << false;
+    QTest::newRow("9 digits, junk") << QByteArray("12345678x") << 10 << 0LL << false;
+    QTest::newRow("8 digits, colon") << QByteArray("1234567:") << 10 << 0LL << false;
+    QTest::newRow("8 digits, slash") << QByteArray("/1234567") << 10 << 0LL << false;
+    QTest::newRow("8 digits, space") << QByteArray("1234 5678") << 10 << 0LL << false;
+    QTest::newRow("many-0 one dec") << (QByteArray(30, '0') + '1') << 10 << 1LL << true;
+    QTest::newRow("neg zero") << QByteArray("-0") << 10 << 0LL << true;
+    QTest::newRow("plus minus") << QByteArray("+-12") << 10 << 0LL << false;
 }
 
 template <typename ByteArray> void tst_QByteArrayApiSymmetry::toLongLong() const
@@ -1475,6 +1488,16 @@ void tst_QByteArrayApiSymmetry::toULongLong_data() const
     // Number of bits is a multiple of four, so every digit of max is 'f'.
     big = '1' + QByteArray::number(ULL::max(), 16).replace('f', '0');
     QTest::newRow("max + 1 hex") << big << 16 << 0ULL << false;
+
+    // Decimal digits are read eight at a time, where possible:
+    QTest::newRow("19 digits")
+        << QByteArray("9999999999999999999") << 10 << 9999999999999999999ULL << true;
+    QTest::newRow("20 digits")
+        << QByteArray("10000000000000000000") << 10 << 10000000000000000000ULL << true;
+    QTest::newRow("8 digits, junk") << QByteArray("1234567x") << 10 << 0ULL << false;
+    QTest::newRow("17 digits, junk")
+        << QByteArray("1234567812345678x") << 10 << 0ULL << false;
+    QTest::newRow("plus minus") << QByteArray("+-12") << 10 << 0ULL << false;
 }
 
 template <typename ByteArray> void tst_QByteArrayApiSymmetry::toULongLong() const
@@ -1536,6 +1559,29 @@ void tst_QByteArrayApiSymmetry::toDouble_data() const
     QTest::newRow("exponential")
         << QByteArray("9.31322574615478515625e-10") << 9.31322574615478515625e-10 << true;
 
+    QTest::newRow("leading plus") << QByteArray("+1.5") << 1.5 << true;
+    QTest::newRow("leading plus, point") << QByteArray("+.5") << 0.5 << true;
+    QTest::newRow("leading minus, point") << QByteArray("-.5") << -0.5 << true;
+    QTest::newRow("plus minus") << QByteArray("+-1.5") << 0.0 << false;
+    QTest::newRow("minus plus") << QByteArray("-+1.5") << 0.0 << false;
+    QTest::newRow("point only") << QByteArray(".") << 0.0 << false;
+    QTest::newRow("trailing point") << QByteArray("12.") << 12.0 << true;
+    QTest::newRow("negative zero") << QByteArray("-0.0") << -0.0 << true;
+    QTest::newRow("incomplete exponent") << QByteArray("1.5e") << 0.0 << false;
+    QTest::newRow("space inside") << QByteArray("1 .5") << 0.0 << false;
+    QTest::newRow("infinity spelled out") << QByteArray("infinity") << 0.0 << false;
+    QTest::newRow("spaced inf") << QByteArray(" inf") << 0.0 << false;
+    QTest::newRow("hex") << QByteArray("0x1p3") << 0.0 << false;
+    QTest::newRow("overflow") << QByteArray("1e400") << 0.0 << false;
+    QTest::newRow("underflow") << QByteArray("1e-400") << 0.0 << false;
+    QTest::newRow("zero with big exponent") << QByteArray("0e-400") << 0.0 << true;
+    QTest::newRow("denormal") << QByteArray("4.9406564584124654e-324")
+                              << std::numeric_limits<double>::denorm_min() << true;
+    QTest::newRow("max") << QByteArray("1.7976931348623157e308")
+                         << std::numeric_limits<double>::max() << true;
+    QTest::newRow("halfway, rounds to even") << QByteArray("9007199254740993")
+                                             << 9007199254740992.0 << true;
+
     QTest::newRow("raw, null plus junk")
         << QByteArray::fromRawData("1.2\0 junk", 9) << 0.0 << false;
     QTest::newRow("raw, null-terminator excluded")
@@ -0,0 +1,276 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/QMultiByteArrayMatcher>
+#include <QtCore/QMultiStringMatcher>
+#include <QtCore/QRandomGenerator>
+
+using namespace Qt::StringLiterals;
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void indexIn_data();
+    void indexIn();
+    void findAll();
+    void caseInsensitiveLatin1();
+    void caseInsensitiveUtf16();
+    void emptyPatterns();
+    void from();
+    void copyAndSetters();
+    void compareToBruteForce_data();
+    void compareToBruteForce();
+};
+
+// every occurrence of every non-empty pattern, by position and pattern
+template <typename Match, typename String>
+static QList<Match> bruteForce(const QList<String> &patterns, const String &text,
+                               Qt::CaseSensitivity cs)
+{
+    QList<Match> matches;
+    for (qsizetype at = 0; at < text.size(); ++at) {
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            const String &pattern = patterns.at(i);
+            if (pattern.isEmpty() || at + pattern.size() > text.size())
+                continue;
+            bool equal;
+            if constexpr (std::is_same_v<String, QString>) {
+                equal = QStringView(text).sliced(at, pattern.size()).compare(pattern, cs) == 0;
+            } else {
+                const QLatin1StringView piece(text.constData() + at, pattern.size());
+                equal = piece.compare(QLatin1StringView(pattern), cs) == 0;
+            }
+            if (equal)
+                matches.append(Match{ at, pattern.size(), i });
+        }
+    }
+    return matches;
+}
+
+template <typename Match>
+static bool operator==(const QList<Match> &lhs, const QList<Match> &rhs)
+{
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(),
+                      [](const Match &l, const Match &r) {
+        return l.position == r.position && l.length == r.length
+                && l.patternIndex == r.patternIndex;
+    });
+}
+
+void tst_QMultiStringMatcher::indexIn_data()
+{
+    QTest::addColumn<QList<QByteArray>>("patterns");
+    QTest::addColumn<QByteArray>("text");
+    QTest::addColumn<qsizetype>("position");
+    QTest::addColumn<qsizetype>("patternIndex");
+
+    const QList<QByteArray> classic = { "he", "she", "his", "hers" };
+    QTest::newRow("none") << classic << QByteArray("ahoy") << qsizetype(-1) << qsizetype(-1);
+    QTest::newRow("single") << classic << QByteArray("this") << qsizetype(1) << qsizetype(2);
+    QTest::newRow("nested") << classic << QByteArray("ushers") << qsizetype(1) << qsizetype(1);
+    QTest::newRow("suffix") << QList<QByteArray>{ "bcd", "c" } << QByteArray("abcd")
+                            << qsizetype(1) << qsizetype(0);
+    QTest::newRow("leftmost-ends-later") << QList<QByteArray>{ "abcdef", "cd" }
+                                         << QByteArray("xabcdefx") << qsizetype(1) << qsizetype(0);
+    QTest::newRow("same-start-first-pattern") << QList<QByteArray>{ "abc", "ab" }
+                                              << QByteArray("xabc") << qsizetype(1) << qsizetype(0);
+    QTest::newRow("same-start-first-pattern2") << QList<QByteArray>{ "ab", "abc" }
+                                               << QByteArray("xabc") << qsizetype(1) << qsizetype(0);
+    QTest::newRow("duplicates") << QList<QByteArray>{ "x", "ab", "ab" } << QByteArray("-ab")
+                                << qsizetype(1) << qsizetype(1);
+    QTest::newRow("duplicates2") << QList<QByteArray>{ "ab", "b", "ab" } << QByteArray("-ab")
+                                 << qsizetype(1) << qsizetype(0);
+    QTest::newRow("at-end") << classic << QByteArray("------------------------------hers")
+                            << qsizetype(30) << qsizetype(0);
+    QTest::newRow("binary") << QList<QByteArray>{ QByteArray("\0\xff", 2) }
+                            << QByteArray("abc\0\0\xff", 6) << qsizetype(4) << qsizetype(0);
+}
+
+void tst_QMultiStringMatcher::indexIn()
+{
+    QFETCH(QList<QByteArray>, patterns);
+    QFETCH(QByteArray, text);
+    QFETCH(qsizetype, position);
+    QFETCH(qsizetype, patternIndex);
+
+    qsizetype index = -2;
+    QMultiByteArrayMatcher matcher(patterns);
+    QCOMPARE(matcher.indexIn(text, 0, &index), position);
+    QCOMPARE(index, patternIndex);
+
+    QList<QString> strings;
+    for (const QByteArray &pattern : patterns)
+        strings.append(QString::fromLatin1(pattern));
+    index = -2;
+    QMultiStringMatcher stringMatcher(strings);
+    QCOMPARE(stringMatcher.indexIn(QString::fromLatin1(text), 0, &index), position);
+    QCOMPARE(index, patternIndex);
+}
+
+void tst_QMultiStringMatcher::findAll()
+{
+    const QMultiByteArrayMatcher matcher({ "he", "she", "his", "hers" });
+    const auto matches = matcher.findAll("ushers and his sheep");
+    QCOMPARE(matches.size(), 6);
+    const qsizetype expected[][2] = { { 1, 1 }, { 2, 0 }, { 2, 3 }, { 11, 2 }, { 15, 1 },
+                                      { 16, 0 } };
+    for (qsizetype i = 0; i < matches.size(); ++i) {
+        QCOMPARE(matches.at(i).position, expected[i][0]);
+        QCOMPARE(matches.at(i).patternIndex, expected[i][1]);
+        QCOMPARE(matches.at(i).length, matcher.patterns().at(expected[i][1]).size());
+    }
+
+    // equal patterns are all found
+    const QMultiByteArrayMatcher equal({ "ab", "AB", "ab" }, Qt::CaseInsensitive);
+    const auto all = equal.findAll("xaB");
+    QCOMPARE(all.size(), 3);
+    for (qsizetype i = 0; i < all.size(); ++i) {
+        QCOMPARE(all.at(i).position, 1);
+        QCOMPARE(all.at(i).patternIndex, i);
+    }
+}
+
+void tst_QMultiStringMatcher::caseInsensitiveLatin1()
+{
+    const QList<QByteArray> patterns = { "\xc4rger", "Error" };
+    const QByteArray text = "no ERROR, no \xe4RGER";
+    QMultiByteArrayMatcher matcher(patterns);
+    QCOMPARE(matcher.indexIn(text), -1);
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    qsizetype index;
+    QCOMPARE(matcher.indexIn(text, 0, &index), 3);
+    QCOMPARE(index, 1);
+    QCOMPARE(matcher.indexIn(text, 4, &index), 13);
+    QCOMPARE(index, 0);
+    QCOMPARE(matcher.findAll(text).size(), 2);
+}
+
+void tst_QMultiStringMatcher::caseInsensitiveUtf16()
+{
+    QMultiStringMatcher matcher({ u"σοφία"_s, u"kelvin"_s }, Qt::CaseInsensitive);
+    qsizetype index;
+    QCOMPARE(matcher.indexIn(u"- ΣΟΦΙΑ"_s, 0, &index), -1);
+    QCOMPARE(matcher.indexIn(u"- ΣΟΦΊΑ"_s, 0, &index), 2);
+    QCOMPARE(index, 0);
+    // the Kelvin sign folds to k
+    QCOMPARE(matcher.indexIn(u"0 \u212aELVIN"_s, 0, &index), 2);
+    QCOMPARE(index, 1);
+    matcher.setCaseSensitivity(Qt::CaseSensitive);
+    QCOMPARE(matcher.indexIn(u"0 KELVIN"_s), -1);
+    QCOMPARE(matcher.indexIn(u"0 kelvin"_s), 2);
+}
+
+void tst_QMultiStringMatcher::emptyPatterns()
+{
+    QMultiByteArrayMatcher none;
+    QVERIFY(none.patterns().isEmpty());
+    QCOMPARE(none.indexIn("abc"), -1);
+    QVERIFY(none.findAll("abc").isEmpty());
+
+    QMultiByteArrayMatcher empty({ QByteArray(), "" });
+    QCOMPARE(empty.indexIn("abc"), -1);
+    QCOMPARE(empty.indexIn(""), -1);
+
+    QMultiStringMatcher mixed({ QString(), u"b"_s });
+    qsizetype index;
+    QCOMPARE(mixed.indexIn(u"abc", 0, &index), 1);
+    QCOMPARE(index, 1);
+}
+
+void tst_QMultiStringMatcher::from()
+{
+    const QMultiByteArrayMatcher matcher({ "ab", "b" });
+    const QByteArray text = "abab";
+    QCOMPARE(matcher.indexIn(text, -5), 0);
+    QCOMPARE(matcher.indexIn(text, 1), 1);
+    QCOMPARE(matcher.indexIn(text, 2), 2);
+    QCOMPARE(matcher.indexIn(text, 4), -1);
+    QCOMPARE(matcher.indexIn(text, 5), -1);
+    QCOMPARE(matcher.findAll(text, 1).size(), 3);
+    QVERIFY(matcher.findAll(text, 10).isEmpty());
+}
+
+void tst_QMultiStringMatcher::copyAndSetters()
+{
+    QMultiStringMatcher matcher({ u"one"_s, u"two"_s });
+    QMultiStringMatcher copy = matcher;
+    matcher.setPatterns({ u"three"_s });
+    QCOMPARE(matcher.patterns(), QList<QString>{ u"three"_s });
+    QCOMPARE(copy.patterns().size(), 2);
+    QCOMPARE(copy.indexIn(u"three two one"), 6);
+    QCOMPARE(matcher.indexIn(u"three two one"), 0);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+
+    copy = std::move(matcher);
+    QCOMPARE(copy.indexIn(u"one two three"), 8);
+    copy.swap(matcher);
+    QCOMPARE(matcher.indexIn(u"one two three"), 8);
+}
+
+void tst_QMultiStringMatcher::compareToBruteForce_data()
+{
+    QTest::addColumn<QByteArray>("alphabet");
+    QTest::addColumn<int>("patternCount");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    // few characters that start a pattern, many, and many with more than
+    // eight high nibbles
+    QTest::newRow("ab") << QByteArray("ab") << 3 << Qt::CaseSensitive;
+    QTest::newRow("ab-ci") << QByteArray("abAB") << 3 << Qt::CaseInsensitive;
+    QTest::newRow("letters") << QByteArray("abcdefghij") << 20 << Qt::CaseSensitive;
+    QTest::newRow("letters-ci") << QByteArray("abcdeABCDE\xe4\xc4") << 20 << Qt::CaseInsensitive;
+    QTest::newRow("nibbles") << QByteArray(" 0@Pp\x80\x90\xa0\xb0\xc0\xd0\xe0\xf0\x10")
+                             << 40 << Qt::CaseSensitive;
+}
+
+void tst_QMultiStringMatcher::compareToBruteForce()
+{
+    QFETCH(QByteArray, alphabet);
+    QFETCH(int, patternCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    QRandomGenerator rng(patternCount);
+    const auto randomText = [&](qsizetype size, QByteArray filler) {
+        QByteArray text;
+        for (qsizetype i = 0; i < size; ++i) {
+            // long stretches of characters that don't start patterns, to
+            // exercise skipping
+            if (!filler.isEmpty() && rng.bounded(4) == 0) {
+                for (int n = rng.bounded(40); n > 0; --n)
+                    text += filler;
+            }
+            text += alphabet.at(rng.bounded(alphabet.size()));
+        }
+        return text;
+    };
+    QList<QByteArray> patterns;
+    for (int i = 0; i < patternCount; ++i)
+        patterns.append(randomText(1 + rng.bounded(5), QByteArray()));
+
+    for (int round = 0; round < 20; ++round) {
+        const QByteArray text = randomText(round * 50, "~");
+        const QMultiByteArrayMatcher matcher(patterns, cs);
+        const auto expected = bruteForce<QMultiByteArrayMatcher::Match>(patterns, text, cs);
+        QVERIFY(matcher.findAll(text) == expected);
+        QCOMPARE(matcher.indexIn(text), expected.isEmpty() ? -1 : expected.first().position);
+
+        QList<QString> strings;
+        for (const QByteArray &pattern : patterns)
+            strings.append(QString::fromLatin1(pattern));
+        const QString string = QString::fromLatin1(text);
+        const QMultiStringMatcher stringMatcher(strings, cs);
+        const auto expectedStrings = bruteForce<QMultiStringMatcher::Match>(strings, string, cs);
+        QVERIFY(stringMatcher.findAll(string) == expectedStrings);
+        QCOMPARE(stringMatcher.indexIn(string),
+                 expectedStrings.isEmpty() ? -1 : expectedStrings.first().position);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_qmultistringmatcher.moc"
@@ -19,6 +19,8 @@ Q_DECLARE_METATYPE(QRegularExpression::PatternOptions)
 Q_DECLARE_METATYPE(QRegularExpression::MatchType)
 Q_DECLARE_METATYPE(QRegularExpression::MatchOptions)
 
+using namespace Qt::StringLiterals;
+
 class tst_QRegularExpression : public QObject
 {
     Q_OBJECT
@@ -69,6 +71,11 @@ private slots:
     void wildcard();
     void testInvalidWildcard_data();
     void testInvalidWildcard();
+    void compiledPatternCache();
+    void regularExpressionSet_data();
+    void regularExpressionSet();
+    void regularExpressionSetInvalid();
+    void regularExpressionSetSubject();
 
 private:
     void provideRegularExpressions();
@@ -2572,6 +2579,166 @@ void tst_QRegularExpression::testInvalidWildcard()
     QCOMPARE(re.isValid(), isValid);
 }
 
+void tst_QRegularExpression::compiledPatternCache()
+{
+    // The same pattern with different options must not share compiled code
+    {
+        const QRegularExpression cs(u"fo+"_s);
+        const QRegularExpression ci(u"fo+"_s, QRegularExpression::CaseInsensitiveOption);
+        QVERIFY(cs.match(u"FOO"_s).hasMatch() == false);
+        QVERIFY(ci.match(u"FOO"_s).hasMatch());
+        QVERIFY(cs.match(u"foo"_s).hasMatch());
+    }
+
+    // Errors are reported for every object, not just the first one
+    for (int i = 0; i < 3; ++i) {
+        const QRegularExpression re(u"a(b"_s);
+        QVERIFY(!re.isValid());
+        QCOMPARE(re.patternErrorOffset(), 3);
+        QCOMPARE(re.errorString(), u"missing closing parenthesis"_s);
+    }
+
+    // Overflow the cache, and check that both the evicted and the recently
+    // compiled patterns (and the objects still using them) work
+    const QRegularExpression first(u"^first (\\d+)$"_s);
+    QCOMPARE(first.match(u"first 42"_s).captured(1), u"42"_s);
+    for (int i = 0; i < 1000; ++i) {
+        const QRegularExpression re(u"^item%1-(\\w+)$"_s.arg(i));
+        QCOMPARE(re.captureCount(), 1);
+        QCOMPARE(re.match(u"item%1-x"_s.arg(i)).captured(1), u"x"_s);
+    }
+    QCOMPARE(first.match(u"first 43"_s).captured(1), u"43"_s);
+    const QRegularExpression again(u"^first (\\d+)$"_s);
+    QCOMPARE(again.match(u"first 44"_s).captured(1), u"44"_s);
+
+    // Changing the pattern of an object picks up the right code
+    QRegularExpression re(u"^item1-(\\w+)$"_s);
+    QVERIFY(re.match(u"item1-x"_s).hasMatch());
+    re.setPattern(u"^item2-(\\w+)$"_s);
+    QVERIFY(!re.match(u"item1-x"_s).hasMatch());
+    QVERIFY(re.match(u"item2-x"_s).hasMatch());
+    re.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(re.match(u"ITEM2-x"_s).hasMatch());
+}
+
+void tst_QRegularExpression::regularExpressionSet_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QRegularExpression::PatternOptions>("options");
+    QTest::addColumn<QString>("subject");
+
+    const QStringList routes = {
+        u"^/users/\\d+$"_s,
+        u"^/users/\\w+/avatar$"_s,
+        u"^/static/"_s,
+        u"\\.png$"_s,
+        u"^/users/"_s,
+        u"(?<first>a)(?<second>b)(c)(d)(e)(f)(g)(h)"_s,
+        u"x{20}"_s,
+        u""_s,
+    };
+    QTest::newRow("routes-users") << routes << QRegularExpression::PatternOptions() << u"/users/42"_s;
+    QTest::newRow("routes-avatar") << routes << QRegularExpression::PatternOptions() << u"/users/bob/avatar"_s;
+    QTest::newRow("routes-static") << routes << QRegularExpression::PatternOptions() << u"/static/logo.png"_s;
+    QTest::newRow("routes-none") << routes << QRegularExpression::PatternOptions() << u"/nowhere"_s;
+    QTest::newRow("routes-empty") << routes << QRegularExpression::PatternOptions() << QString();
+    QTest::newRow("routes-ci") << routes << QRegularExpression::PatternOptions(QRegularExpression::CaseInsensitiveOption)
+                               << u"/STATIC/LOGO.PNG"_s;
+    QTest::newRow("captures") << routes << QRegularExpression::PatternOptions() << u"--abcdefgh--"_s;
+    QTest::newRow("length") << routes << QRegularExpression::PatternOptions() << QString(20, u'x');
+    QTest::newRow("too-short") << routes << QRegularExpression::PatternOptions() << QString(19, u'x');
+
+    const QStringList unicode = {
+        u"\\p{Greek}+"_s,
+        u"\\w+"_s,
+        u"\u00e9t\u00e9"_s,
+        u"\U0001F600"_s,
+        u"^.$"_s,
+    };
+    QTest::newRow("unicode-greek") << unicode << QRegularExpression::PatternOptions() << u"\u03b1\u03b2\u03b3"_s;
+    QTest::newRow("unicode-ucp") << unicode << QRegularExpression::PatternOptions(QRegularExpression::UseUnicodePropertiesOption)
+                                 << u"\u03b1\u03b2\u03b3"_s;
+    QTest::newRow("unicode-latin") << unicode << QRegularExpression::PatternOptions() << u"l'\u00e9t\u00e9"_s;
+    QTest::newRow("unicode-ci") << unicode << QRegularExpression::PatternOptions(QRegularExpression::CaseInsensitiveOption)
+                                << u"\u00c9T\u00c9"_s;
+    QTest::newRow("unicode-emoji") << unicode << QRegularExpression::PatternOptions() << u"\U0001F600"_s;
+}
+
+void tst_QRegularExpression::regularExpressionSet()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QRegularExpression::PatternOptions, options);
+    QFETCH(QString, subject);
+
+    const QRegularExpressionSet set(patterns, options);
+    QVERIFY(set.isValid());
+    QCOMPARE(set.patterns(), patterns);
+    QCOMPARE(set.patternOptions(), options);
+
+    for (qsizetype offset : { qsizetype(0), qsizetype(1), qsizetype(-1), subject.size() }) {
+        QList<qsizetype> expected;
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            const QRegularExpression re(patterns.at(i), options);
+            if (re.matchView(subject, offset).hasMatch())
+                expected.append(i);
+        }
+
+        QCOMPARE(set.matchingPatterns(subject, offset), expected);
+        QCOMPARE(set.firstMatchingPattern(subject, offset), expected.isEmpty() ? -1 : expected.first());
+
+        const auto anchored = QRegularExpression::AnchorAtOffsetMatchOption;
+        expected.clear();
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            const QRegularExpression re(patterns.at(i), options);
+            if (re.matchView(subject, offset, QRegularExpression::NormalMatch, anchored).hasMatch())
+                expected.append(i);
+        }
+        QCOMPARE(set.matchingPatterns(subject, offset, anchored), expected);
+    }
+}
+
+void tst_QRegularExpression::regularExpressionSetInvalid()
+{
+    QRegularExpressionSet set;
+    QVERIFY(set.isValid());
+    QVERIFY(set.patterns().isEmpty());
+    QVERIFY(set.matchingPatterns(u"anything").isEmpty());
+    QCOMPARE(set.firstMatchingPattern(u"anything"), -1);
+
+    set.setPatterns({ u"any"_s, u"a(b"_s, u"thing"_s });
+    QVERIFY(!set.isValid());
+    QCOMPARE(set.matchingPatterns(u"anything"), QList<qsizetype>({ 0, 2 }));
+
+    const QRegularExpressionSet copy = set;
+    set.setPatterns({ u"ANY"_s });
+    QVERIFY(set.isValid());
+    QVERIFY(set.matchingPatterns(u"anything").isEmpty());
+    set.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(set.matchingPatterns(u"anything"), QList<qsizetype>({ 0 }));
+
+    // the copy is not affected
+    QVERIFY(!copy.isValid());
+    QCOMPARE(copy.patternOptions(), QRegularExpression::NoPatternOption);
+    QCOMPARE(copy.matchingPatterns(u"anything"), QList<qsizetype>({ 0, 2 }));
+}
+
+void tst_QRegularExpression::regularExpressionSetSubject()
+{
+    const QRegularExpressionSet set({ u"a"_s, u"\\x{1F600}"_s, u"$"_s });
+
+    // out of range offsets
+    QVERIFY(set.matchingPatterns(u"a", 2).isEmpty());
+    QVERIFY(set.matchingPatterns(u"a", -2).isEmpty());
+
+    // invalid UTF-16, and offsets in the middle of a surrogate pair
+    const QString emoji = u"a\U0001F600"_s;
+    QCOMPARE(set.matchingPatterns(emoji), QList<qsizetype>({ 0, 1, 2 }));
+    QCOMPARE(set.matchingPatterns(emoji, 1), QList<qsizetype>({ 1, 2 }));
+    QVERIFY(set.matchingPatterns(emoji, 2).isEmpty());
+    QVERIFY(set.matchingPatterns(emoji.left(2)).isEmpty());
+    QCOMPARE(set.matchingPatterns(emoji, 3), QList<qsizetype>({ 2 }));
+}
+
 QTEST_APPLESS_MAIN(tst_QRegularExpression)
 
 #include "tst_qregularexpression.moc"
@@ -155,6 +155,8 @@ private slots:
 
     void utf8Codec_data();
     void utf8Codec();
+    void utf8Runs_data();
+    void utf8Runs();
 
     void utf8bom_data();
     void utf8bom();
@@ -1782,6 +1784,106 @@ void tst_QStringConverter::utf8Codec()
     QCOMPARE(str, res);
 }
 
+void tst_QStringConverter::utf8Runs_data()
+{
+    QTest::addColumn<QString>("text");
+
+    auto run = [](char16_t first, int count, int step = 1) {
+        QString s;
+        for (int i = 0; i < count; ++i)
+            s += QChar(char16_t(first + i * step));
+        return s;
+    };
+    QTest::newRow("two-byte") << run(0x410, 64);
+    QTest::newRow("three-byte") << run(0x4e00, 64, 37);
+    QTest::newRow("two-byte-boundaries") << run(0x80, 40) + run(0x7ff - 39, 40);
+    QTest::newRow("three-byte-boundaries")
+            << run(0x800, 20) + run(0xd7ff - 19, 20) + run(0xe000, 20) + run(0xffe0, 20) + u'\xffff';
+    QTest::newRow("mixed-lengths") << run(0x3b1, 20) + run(0x3042, 20) + u"ab\U0001f600cd"_s
+                                      + run(0x5d0, 20) + u" "_s + run(0xac00, 20, 11);
+    QString interleaved;
+    for (int i = 0; i < 40; ++i) {
+        interleaved += QChar(char16_t(0x430 + i));
+        interleaved += QChar(char16_t(0x4e00 + i));
+        interleaved += QChar(char16_t(u'a' + i % 26));
+    }
+    QTest::newRow("interleaved") << interleaved;
+}
+
+void tst_QStringConverter::utf8Runs()
+{
+    QFETCH(QString, text);
+
+    // Pieces shorter than a SIMD block, cut where a sequence starts, decode
+    // and encode like the whole.
+    auto decodePieces = [](QByteArrayView utf8) {
+        QString result;
+        qsizetype start = 0;
+        for (qsizetype i = 1; i <= utf8.size(); ++i) {
+            if (i == utf8.size() || (i - start >= 8 && (uchar(utf8.at(i)) & 0xc0) != 0x80)) {
+                result += QString::fromUtf8(utf8.sliced(start, i - start));
+                start = i;
+            }
+        }
+        return result;
+    };
+    auto encodePieces = [](QStringView utf16) {
+        QByteArray result;
+        qsizetype start = 0;
+        for (qsizetype i = 1; i <= utf16.size(); ++i) {
+            if (i == utf16.size() || (i - start >= 4 && !utf16.at(i).isLowSurrogate())) {
+                result += utf16.sliced(start, i - start).toUtf8();
+                start = i;
+            }
+        }
+        return result;
+    };
+
+    const QByteArray utf8 = text.toUtf8();
+    QCOMPARE(utf8, encodePieces(text));
+    QCOMPARE(QString::fromUtf8(utf8), text);
+    QVERIFY(QUtf8StringView(utf8).isValidUtf8());
+    QStringDecoder chunked(QStringDecoder::Utf8);
+    QString halves = chunked(utf8.first(utf8.size() / 2));
+    halves += chunked(utf8.sliced(utf8.size() / 2));
+    QCOMPARE(halves, text);
+
+    // invalid sequences anywhere in a run
+    const QByteArrayView invalid[] = {
+        "\x80", "\xbf\xbf", "\xc0\x80", "\xc1\xbf", "\xe0\x80\x80", "\xe0\x9f\xbf",
+        "\xed\xa0\x80", "\xed\xbf\xbf", "\xf8", "\xff", "\xd0", "\xe4\xb8", "\xf0\x9f\x98"
+    };
+    for (qsizetype i = 0; i < utf8.size(); ++i) {
+        for (QByteArrayView bytes : invalid) {
+            QByteArray corrupt = utf8;
+            corrupt.replace(i, qMin(bytes.size(), corrupt.size() - i), bytes);
+            const QString decoded = QString::fromUtf8(corrupt);
+            if (decoded != decodePieces(corrupt))
+                QFAIL(qPrintable(u"mismatch decoding with %1 at %2"_s
+                                 .arg(QString::fromLatin1(bytes.toByteArray().toHex()))
+                                 .arg(i)));
+            // some replacements are no change
+            const bool valid = !decoded.contains(QChar::ReplacementCharacter);
+            QCOMPARE(QUtf8StringView(corrupt).isValidUtf8(), valid);
+
+            QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+            QCOMPARE(decoder(corrupt), decoded);
+            QCOMPARE(decoder.hasError(), !valid);
+        }
+    }
+
+    // lone surrogates anywhere
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        for (char16_t surrogate : { u'\xd800', u'\xdfff' }) {
+            QString corrupt = text;
+            corrupt[i] = QChar(surrogate);
+            if (corrupt.toUtf8() != encodePieces(corrupt))
+                QFAIL(qPrintable(u"mismatch encoding with %1 at %2"_s
+                                 .arg(QString::number(surrogate, 16)).arg(i)));
+        }
+    }
+}
+
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_DEPRECATED
 void tst_QStringConverter::utf8bom_data()
@@ -0,0 +1,321 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/qcoroutine.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <tuple>
+
+using namespace Qt::StringLiterals;
+
+class tst_QCoroutine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void awaitReadyFuture();
+    void awaitPendingFuture();
+    void awaitTask();
+    void canceledFutureEndsCoroutine();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptionIsRethrown();
+    void exceptionCompletesTask();
+#endif
+    void resumesInContextThread();
+    void readyFutureDoesNotPostEvents();
+    void contextDestroyedEndsCoroutine();
+    void contextDestroyedWhileFinishing();
+    void awaitSignal();
+    void awaitSignalSenderDestroyed();
+};
+
+class Emitter : public QObject
+{
+    Q_OBJECT
+signals:
+    void triggered();
+    void valueChanged(int value);
+    void pairChanged(int first, const QString &second);
+};
+
+// sets a flag when the coroutine frame holding it goes away
+struct FrameGuard
+{
+    std::shared_ptr<bool> destroyed;
+    ~FrameGuard() { *destroyed = true; }
+};
+
+static QCoroTask<int> addOne(QFuture<int> future)
+{
+    const int value = co_await future;
+    co_return value + 1;
+}
+
+static QCoroTask<int> addTwo(QFuture<int> future)
+{
+    const int value = co_await addOne(future);
+    co_return value + 1;
+}
+
+static QCoroTask<> awaitGuarded(QFuture<int> future, std::shared_ptr<bool> destroyed,
+                                bool *resumed)
+{
+    FrameGuard guard{ std::move(destroyed) };
+    co_await future;
+    *resumed = true;
+}
+
+// records the thread that destroys the coroutine frame holding it
+struct FrameThreadGuard
+{
+    std::shared_ptr<Qt::HANDLE> destroyedIn;
+    ~FrameThreadGuard() { *destroyedIn = QThread::currentThreadId(); }
+};
+
+class Worker : public QObject
+{
+public:
+    QCoroTask<Qt::HANDLE> resumedIn(QFuture<int> future)
+    {
+        co_await future;
+        co_return QThread::currentThreadId();
+    }
+
+    QCoroTask<> guarded(QFuture<int> future, std::shared_ptr<Qt::HANDLE> destroyedIn)
+    {
+        FrameThreadGuard guard{ std::move(destroyedIn) };
+        co_await future;
+    }
+};
+
+void tst_QCoroutine::awaitReadyFuture()
+{
+    auto task = addOne(QtFuture::makeReadyValueFuture(41));
+    QVERIFY(task.future().isFinished());
+    QCOMPARE(task.future().result(), 42);
+}
+
+void tst_QCoroutine::awaitPendingFuture()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    auto task = addOne(promise.future());
+    QVERIFY(!task.future().isFinished());
+
+    promise.addResult(1);
+    promise.finish();
+    QVERIFY(task.future().isFinished());
+    QCOMPARE(task.future().result(), 2);
+}
+
+void tst_QCoroutine::awaitTask()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    auto task = addTwo(promise.future());
+    QVERIFY(!task.future().isFinished());
+
+    promise.addResult(1);
+    promise.finish();
+    QVERIFY(task.future().isFinished());
+    QCOMPARE(task.future().result(), 3);
+}
+
+void tst_QCoroutine::canceledFutureEndsCoroutine()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    auto destroyed = std::make_shared<bool>(false);
+    bool resumed = false;
+    auto task = awaitGuarded(promise.future(), destroyed, &resumed);
+    QVERIFY(!*destroyed);
+
+    promise.future().cancel();
+    promise.finish();
+    QVERIFY(*destroyed);
+    QVERIFY(!resumed);
+    QVERIFY(task.future().isCanceled());
+
+    // already canceled futures end the coroutine right away
+    QPromise<int> canceled;
+    canceled.start();
+    canceled.future().cancel();
+    canceled.finish();
+    *destroyed = false;
+    task = awaitGuarded(canceled.future(), destroyed, &resumed);
+    QVERIFY(*destroyed);
+    QVERIFY(!resumed);
+    QVERIFY(task.future().isCanceled());
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QCoroutine::exceptionIsRethrown()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    bool caught = false;
+    auto catcher = [](QFuture<int> future, bool *caught) -> QCoroTask<> {
+        try {
+            co_await future;
+        } catch (const QException &) {
+            *caught = true;
+        }
+    };
+    auto task = catcher(promise.future(), &caught);
+
+    promise.setException(QException());
+    promise.finish();
+    QVERIFY(caught);
+    QVERIFY(task.future().isFinished());
+    QVERIFY(!task.future().isCanceled());
+}
+
+void tst_QCoroutine::exceptionCompletesTask()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    auto task = addOne(promise.future());
+    promise.setException(QException());
+    promise.finish();
+
+    QVERIFY(task.future().isFinished());
+    QVERIFY_THROWS_EXCEPTION(QException, task.future().result());
+}
+#endif
+
+void tst_QCoroutine::resumesInContextThread()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    Worker worker;
+    auto task = worker.resumedIn(promise.future());
+
+    std::unique_ptr<QThread> thread(QThread::create([&promise] {
+        promise.addResult(1);
+        promise.finish();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    // the continuation ran in the other thread and posted the resumption
+    QVERIFY(!task.future().isFinished());
+    QTRY_VERIFY(task.future().isFinished());
+    QCOMPARE(task.future().result(), QThread::currentThreadId());
+}
+
+void tst_QCoroutine::readyFutureDoesNotPostEvents()
+{
+    Worker worker;
+    auto task = worker.resumedIn(QtFuture::makeReadyValueFuture(1));
+    QVERIFY(task.future().isFinished());
+    QCOMPARE(task.future().result(), QThread::currentThreadId());
+}
+
+void tst_QCoroutine::contextDestroyedEndsCoroutine()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    auto worker = std::make_unique<Worker>();
+    auto task = worker->resumedIn(promise.future());
+
+    std::unique_ptr<QThread> thread(QThread::create([&promise] {
+        promise.addResult(1);
+        promise.finish();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    worker.reset();
+    QTRY_VERIFY(task.future().isCanceled());
+}
+
+void tst_QCoroutine::contextDestroyedWhileFinishing()
+{
+    // The thread finishing the future must neither look at the context nor
+    // destroy the coroutine, which belongs to the context's thread
+    for (int i = 0; i < 100; ++i) {
+        QPromise<int> promise;
+        promise.start();
+
+        auto worker = std::make_unique<Worker>();
+        auto destroyedIn = std::make_shared<Qt::HANDLE>(nullptr);
+        auto task = worker->guarded(promise.future(), destroyedIn);
+
+        QSemaphore started;
+        std::unique_ptr<QThread> thread(QThread::create([&promise, &started] {
+            started.release();
+            promise.addResult(1);
+            promise.finish();
+        }));
+        thread->start();
+        started.acquire();
+        worker.reset();
+        QVERIFY(thread->wait());
+
+        QTRY_VERIFY(task.future().isCanceled());
+        QCOMPARE(*destroyedIn, QThread::currentThreadId());
+    }
+}
+
+void tst_QCoroutine::awaitSignal()
+{
+    Emitter emitter;
+
+    bool triggered = false;
+    auto waitForTrigger = [](Emitter *emitter, bool *triggered) -> QCoroTask<> {
+        co_await QCoroSignal(emitter, &Emitter::triggered);
+        *triggered = true;
+    };
+    auto voidTask = waitForTrigger(&emitter, &triggered);
+    QVERIFY(!triggered);
+    emit emitter.triggered();
+    QVERIFY(triggered);
+    QVERIFY(voidTask.future().isFinished());
+
+    auto waitForValue = [](Emitter *emitter) -> QCoroTask<int> {
+        co_return co_await QCoroSignal(emitter, &Emitter::valueChanged);
+    };
+    auto valueTask = waitForValue(&emitter);
+    emit emitter.valueChanged(5);
+    // single shot: later emissions go nowhere
+    emit emitter.valueChanged(6);
+    QCOMPARE(valueTask.future().result(), 5);
+
+    auto waitForPair = [](Emitter *emitter) -> QCoroTask<std::tuple<int, QString>> {
+        co_return co_await QCoroSignal(emitter, &Emitter::pairChanged);
+    };
+    auto pairTask = waitForPair(&emitter);
+    emit emitter.pairChanged(1, u"one"_s);
+    QCOMPARE(pairTask.future().result(), std::make_tuple(1, u"one"_s));
+}
+
+void tst_QCoroutine::awaitSignalSenderDestroyed()
+{
+    auto emitter = std::make_unique<Emitter>();
+    auto destroyed = std::make_shared<bool>(false);
+
+    auto waitForTrigger = [](Emitter *emitter, std::shared_ptr<bool> destroyed) -> QCoroTask<> {
+        FrameGuard guard{ std::move(destroyed) };
+        co_await QCoroSignal(emitter, &Emitter::triggered);
+    };
+    auto task = waitForTrigger(emitter.get(), destroyed);
+    QVERIFY(!*destroyed);
+
+    emitter.reset();
+    QVERIFY(*destroyed);
+    QVERIFY(task.future().isCanceled());
+}
+
+QTEST_MAIN(tst_QCoroutine)
+#include "tst_qcoroutine.moc"
@@ -12,8 +12,11 @@
 #include <qthread.h>
 #include <qvarlengtharray.h>
 #include <qwaitcondition.h>
+#include <private/qlockcontention_p.h>
 #include <private/qvolatile_p.h>
 
+#include <memory>
+
 using namespace std::chrono_literals;
 
 class tst_QMutex : public QObject
@@ -42,6 +45,7 @@ private slots:
     void tryLockNegative_data();
     void tryLockNegative();
     void moreStress();
+    void contentionStatistics();
 };
 
 static const int iterations = 100;
@@ -1189,6 +1193,47 @@ void tst_QMutex::moreStress()
     QCOMPARE(MoreStressTestThread::errorCount.loadRelaxed(), 0);
 }
 
+void tst_QMutex::contentionStatistics()
+{
+#if !QT_CONFIG(lock_statistics)
+    QSKIP("Lock statistics are not enabled in this build");
+#else
+    QLockContention::resetStatistics();
+    QMutex mutex;
+
+    mutex.lock();
+    mutex.unlock();
+    QVERIFY(mutex.tryLock());
+    mutex.unlock();
+    auto stats = QLockContention::statistics(&mutex);
+    QCOMPARE(stats.acquisitions, 2u);
+    QCOMPARE(stats.contendedAcquisitions, 0u);
+
+    // the other thread may not have reached lock() yet when we unlock, so
+    // try a few times
+    quint64 expectedAcquisitions = stats.acquisitions;
+    for (int attempt = 1; attempt <= 10 && !stats.contendedAcquisitions; ++attempt) {
+        mutex.lock();
+        QSemaphore started;
+        std::unique_ptr<QThread> thread(QThread::create([&] {
+            started.release();
+            mutex.lock();
+            mutex.unlock();
+        }));
+        thread->start();
+        started.acquire();
+        QThread::sleep(std::chrono::milliseconds{10 * attempt});
+        mutex.unlock();
+        QVERIFY(thread->wait());
+        expectedAcquisitions += 2;
+        stats = QLockContention::statistics(&mutex);
+    }
+    QCOMPARE(stats.acquisitions, expectedAcquisitions);
+    QCOMPARE(stats.contendedAcquisitions, 1u);
+    QVERIFY(stats.spinAcquisitions <= stats.contendedAcquisitions);
+    QVERIFY(stats.waitTime > 0ns);
+#endif
+}
 
 QTEST_MAIN(tst_QMutex)
 #include "tst_qmutex.moc"
@@ -88,6 +88,9 @@ private slots:
     void waitForDoneAfterTake();
     void threadReuse();
     void nullFunctions();
+    void workStealing();
+    void workStealingTryTake();
+    void workStealingClear();
 
 private:
     QMutex m_functionTestMutex;
@@ -1488,5 +1491,67 @@ void tst_QThreadPool::nullFunctions()
     }
 }
 
+void tst_QThreadPool::workStealing()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    constexpr int FanOut = 1000;
+    QAtomicInt done;
+    const auto spawn = [&] {
+        for (int i = 0; i < FanOut; ++i)
+            threadPool.start([&done] { done.ref(); });
+    };
+    // tasks spawned from the pool's threads are queued locally, nested
+    // ones as well
+    threadPool.start(spawn);
+    threadPool.start([&] { threadPool.start(spawn); });
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(done.loadRelaxed(), 2 * FanOut);
+    QCOMPARE(threadPool.activeThreadCount(), 0);
+}
+
+void tst_QThreadPool::workStealingTryTake()
+{
+    TestThreadPool threadPool;
+    // with a single thread, nobody can steal the task before it is taken back
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QAtomicInt ran;
+    bool taken = false;
+    threadPool.start([&] {
+        QRunnable *child = QRunnable::create([&ran] { ran.ref(); });
+        child->setAutoDelete(false);
+        threadPool.start(child);
+        taken = threadPool.tryTake(child);
+        if (taken)
+            child->run();
+        delete child;
+    });
+    WAIT_FOR_DONE(threadPool);
+    QVERIFY(taken);
+    QCOMPARE(ran.loadRelaxed(), 1);
+}
+
+void tst_QThreadPool::workStealingClear()
+{
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QAtomicInt ran;
+    threadPool.start([&] {
+        for (int i = 0; i < 10; ++i)
+            threadPool.start([&ran] { ran.ref(); });
+        threadPool.clear();
+    });
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(ran.loadRelaxed(), 0);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
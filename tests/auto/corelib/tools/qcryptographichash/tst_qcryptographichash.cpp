@@ -7,6 +7,9 @@
 #include <QScopeGuard>
 #include <QCryptographicHash>
 #include <QtCore/QMetaEnum>
+#include <QtCore/QBuffer>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTemporaryFile>
 
 #include <thread>
 
@@ -27,12 +30,19 @@ private slots:
     void blake2();
     void files_data();
     void files();
+    void addDataFromFile_data();
+    void addDataFromFile();
+    void addDataProgress();
     void hashLength_data();
     void hashLength();
     void addDataAcceptsNullByteArrayView_data() { hashLength_data(); }
     void addDataAcceptsNullByteArrayView();
     void move();
     void swap();
+    void hashMany_data() { hashLength_data(); }
+    void hashMany();
+    void hashTree_data();
+    void hashTree();
     // keep last
     void moreThan4GiBOfData_data();
     void moreThan4GiBOfData();
@@ -389,6 +399,92 @@ void tst_QCryptographicHash::files()
     }
 }
 
+void tst_QCryptographicHash::addDataFromFile_data()
+{
+    QTest::addColumn<qint64>("size");
+    QTest::addColumn<qint64>("start");
+    QTest::addColumn<QIODevice::OpenMode>("mode");
+
+    const QIODevice::OpenMode modes[] = { QIODevice::ReadOnly, QIODevice::ReadWrite,
+                                          QIODevice::ReadOnly | QIODevice::Unbuffered,
+                                          QIODevice::ReadOnly | QIODevice::Text };
+    for (QIODevice::OpenMode mode : modes) {
+        for (qint64 size : { 0, 1, 4096, 100000 }) {
+            QTest::addRow("%lld-mode%d", size, int(mode)) << size << qint64(0) << mode;
+            if (size > 1)
+                QTest::addRow("%lld-from-%lld-mode%d", size, size / 2 + 1, int(mode))
+                        << size << size / 2 + 1 << mode;
+        }
+    }
+}
+
+void tst_QCryptographicHash::addDataFromFile()
+{
+    QFETCH(const qint64, size);
+    QFETCH(const qint64, start);
+    QFETCH(const QIODevice::OpenMode, mode);
+
+    QByteArray data(size, Qt::Uninitialized);
+    QRandomGenerator rng(size);
+    // no CR, so that the data reads the same in text mode
+    std::generate(data.begin(), data.end(), [&rng] { return char(rng.bounded(14, 256)); });
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), size);
+    file.close();
+
+    QFile reader(file.fileName());
+    QVERIFY(reader.open(mode));
+    if (start)
+        QCOMPARE(reader.read(start).size(), start);
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QVERIFY(hash.addData(&reader));
+    QVERIFY(reader.atEnd());
+    QCOMPARE(hash.result(), QCryptographicHash::hash(QByteArrayView(data).sliced(start),
+                                                     QCryptographicHash::Sha256));
+}
+
+void tst_QCryptographicHash::addDataProgress()
+{
+    QByteArray data(1000000, Qt::Uninitialized);
+    QRandomGenerator rng(42);
+    std::generate(data.begin(), data.end(), [&rng] { return char(rng.generate()); });
+    const QByteArray expected = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), data.size());
+    QVERIFY(file.seek(0));
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    for (QIODevice *device : { static_cast<QIODevice *>(&file), static_cast<QIODevice *>(&buffer) }) {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        qint64 last = 0;
+        QVERIFY(hash.addData(device, [&](qint64 done, qint64 total) {
+            [&] {
+                QCOMPARE(total, data.size());
+                QCOMPARE_GT(done, last);
+                QCOMPARE_LE(done, total);
+            }();
+            last = done;
+            return true;
+        }));
+        QCOMPARE(last, data.size());
+        QCOMPARE(hash.result(), expected);
+
+        // stopping
+        QVERIFY(device->seek(0));
+        hash.reset();
+        int calls = 0;
+        QVERIFY(!hash.addData(device, [&](qint64, qint64) { return ++calls < 1; }));
+        QCOMPARE(calls, 1);
+    }
+}
+
 void tst_QCryptographicHash::hashLength_data()
 {
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
@@ -470,6 +566,80 @@ void tst_QCryptographicHash::swap()
     QCOMPARE(hash1.result(), QCryptographicHash::hash("test", QCryptographicHash::Sha256));
 }
 
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+
+    if (algorithm == QCryptographicHash::NumAlgorithms)
+        QSKIP("Not an algorithm");
+    if (!QCryptographicHash::supportsAlgorithm(algorithm))
+        QSKIP("QCryptographicHash doesn't support this algorithm");
+
+    QCOMPARE(QCryptographicHash::hashMany(QList<QByteArrayView>(), algorithm), QList<QByteArray>());
+
+    // every length around the block sizes and the padding boundaries, in
+    // random order, so that messages of different lengths share the lanes
+    QRandomGenerator rng(42);
+    QList<QByteArray> messages;
+    for (int size = 0; size <= 300; ++size) {
+        QByteArray message(size, Qt::Uninitialized);
+        std::generate(message.begin(), message.end(), [&rng] { return char(rng.generate()); });
+        messages.append(message);
+    }
+    for (int size : { 1000, 4095, 4096, 4097, 70000 })
+        messages.append(QByteArray(size, char(size)));
+    std::shuffle(messages.begin(), messages.end(), rng);
+
+    for (qsizetype count : { 1, 2, 5, 9, int(messages.size()) }) {
+        const QList<QByteArray> input = messages.first(count);
+        const QList<QByteArray> result = QCryptographicHash::hashMany(input, algorithm);
+        QCOMPARE(result.size(), count);
+        for (qsizetype i = 0; i < count; ++i)
+            QCOMPARE(result.at(i), QCryptographicHash::hash(input.at(i), algorithm));
+    }
+}
+
+void tst_QCryptographicHash::hashTree_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<qsizetype>("chunkSize");
+
+    for (auto algorithm : { QCryptographicHash::Sha256, QCryptographicHash::Blake2s_256,
+                            QCryptographicHash::Sha512 }) {
+        const char *name = QMetaEnum::fromType<QCryptographicHash::Algorithm>().valueToKey(algorithm);
+        for (qsizetype size : { 0, 1, 999, 1000, 1001, 10007, 100000 })
+            QTest::addRow("%s-%lld", name, qlonglong(size)) << algorithm << size << qsizetype(1000);
+    }
+}
+
+void tst_QCryptographicHash::hashTree()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const qsizetype, size);
+    QFETCH(const qsizetype, chunkSize);
+
+    QByteArray data(size, Qt::Uninitialized);
+    QRandomGenerator rng(size);
+    std::generate(data.begin(), data.end(), [&rng] { return char(rng.generate()); });
+
+    QByteArray leaves;
+    qsizetype offset = 0;
+    do {
+        leaves += QCryptographicHash::hash(QByteArrayView(data).sliced(offset, qMin(chunkSize, size - offset)),
+                                           algorithm);
+        offset += chunkSize;
+    } while (offset < size);
+    const QByteArray expected = QCryptographicHash::hash(leaves, algorithm);
+
+    QCOMPARE(QCryptographicHash::hashTree(data, algorithm, chunkSize), expected);
+
+    QBuffer buffer(&data);
+    QVERIFY(QCryptographicHash::hashTree(&buffer, algorithm, chunkSize).isNull()); // not open
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCOMPARE(QCryptographicHash::hashTree(&buffer, algorithm, chunkSize), expected);
+}
+
 void tst_QCryptographicHash::ensureLargeData()
 {
 #if QT_POINTER_SIZE > 4
@@ -13,7 +13,10 @@
 #include <QtCore/QDirIterator>
 #include <QtCore/QMap>
 #include <QtCore/QList>
+#include <QtCore/QRandomGenerator>
 #include <QtCore/QResource>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QLocale>
 #include <QtCore/QtGlobal>
 
@@ -70,6 +73,9 @@ private slots:
 
     void python();
 
+    void autoCompression_data();
+    void autoCompression();
+
     void cleanupTestCase();
 
 private:
@@ -467,6 +473,66 @@ void tst_rcc::python()
         QFAIL(qPrintable(diff));
 }
 
+void tst_rcc::autoCompression_data()
+{
+    QTest::addColumn<QStringList>("options");
+    QTest::addColumn<bool>("compressBig");
+
+    QTest::newRow("default") << QStringList() << true;
+    QTest::newRow("expensive") << QStringList{ "-decompression-cost", "100000" } << false;
+}
+
+void tst_rcc::autoCompression()
+{
+    QFETCH(QStringList, options);
+    QFETCH(bool, compressBig);
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const auto writeFile = [&dir](const QString &name, const QByteArray &contents) {
+        QFile file(dir.filePath(name));
+        return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+    };
+    QByteArray random(4096, Qt::Uninitialized);
+    QRandomGenerator::global()->fillRange(reinterpret_cast<quint32 *>(random.data()),
+                                          random.size() / sizeof(quint32));
+    const QByteArray big = QByteArray("The quick brown fox jumps over the lazy dog.\n").repeated(1500);
+    const QByteArray tiny = "tiny";
+    QVERIFY(writeFile("big.txt", big));
+    QVERIFY(writeFile("random.bin", random));
+    QVERIFY(writeFile("tiny.txt", tiny));
+    QVERIFY(writeFile("auto.qrc", "<RCC><qresource prefix=\"/\">"
+                                  "<file>big.txt</file><file>random.bin</file><file>tiny.txt</file>"
+                                  "</qresource></RCC>"));
+
+    const QString rccFileName = dir.filePath("auto.rcc");
+    QProcess process;
+    process.setWorkingDirectory(dir.path());
+    process.start(m_rcc, QStringList{ "-binary", "-compress-algo", "auto", "-o", rccFileName,
+                                      "auto.qrc" } + options);
+    QVERIFY2(process.waitForStarted(), msgProcessStartFailed(process).constData());
+    if (!process.waitForFinished()) {
+        process.kill();
+        QFAIL(msgProcessTimeout(process).constData());
+    }
+    QVERIFY2(process.exitStatus() == QProcess::NormalExit,
+             msgProcessCrashed(process).constData());
+    QVERIFY2(process.exitCode() == 0, msgProcessFailed(process).constData());
+
+    QVERIFY(QResource::registerResource(rccFileName, "/auto"));
+    auto unregister = qScopeGuard([&] { QResource::unregisterResource(rccFileName, "/auto"); });
+
+    QResource bigResource(":/auto/big.txt");
+    QCOMPARE(bigResource.compressionAlgorithm() != QResource::NoCompression, compressBig);
+    QCOMPARE(bigResource.uncompressedData(), big);
+    QResource randomResource(":/auto/random.bin");
+    QCOMPARE(randomResource.compressionAlgorithm(), QResource::NoCompression);
+    QCOMPARE(randomResource.uncompressedData(), random);
+    QResource tinyResource(":/auto/tiny.txt");
+    QCOMPARE(tinyResource.compressionAlgorithm(), QResource::NoCompression);
+    QCOMPARE(tinyResource.uncompressedData(), tiny);
+}
+
 void tst_rcc::cleanupTestCase()
 {
     QDir dataDir(m_dataPath + QLatin1String("/binary"));
@@ -0,0 +1,87 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <algorithm>
+
+// Sorting a large directory by an attribute needs the metadata of every
+// entry. QDir fetches it in bulk before sorting; the "lazy" variants sort
+// an unsorted listing by hand, so that each entry fetches its metadata
+// when the comparison first asks for it, one file after the other.
+class tst_QDir_100000 : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void sorted_data();
+    void sorted();
+    void statList();
+
+private:
+    QTemporaryDir tempDir;
+};
+
+void tst_QDir_100000::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    for (int i = 0; i < 100000; ++i) {
+        QFile file(tempDir.filePath(QLatin1String("testfile_") + QString::number(i)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(i % 64, 'x'));
+    }
+}
+
+void tst_QDir_100000::sorted_data()
+{
+    QTest::addColumn<QDir::SortFlags>("sort");
+    QTest::addColumn<bool>("lazy");
+
+    QTest::newRow("size") << QDir::SortFlags(QDir::Size) << false;
+    QTest::newRow("size-lazy") << QDir::SortFlags(QDir::Size) << true;
+    QTest::newRow("time") << QDir::SortFlags(QDir::Time) << false;
+    QTest::newRow("time-lazy") << QDir::SortFlags(QDir::Time) << true;
+}
+
+void tst_QDir_100000::sorted()
+{
+    QFETCH(QDir::SortFlags, sort);
+    QFETCH(bool, lazy);
+
+    const QDir dir(tempDir.path());
+    QBENCHMARK {
+        QFileInfoList list;
+        if (!lazy) {
+            list = dir.entryInfoList(QDir::Files, sort);
+        } else {
+            list = dir.entryInfoList(QDir::Files, QDir::Unsorted);
+            if (sort == QDir::Size) {
+                std::sort(list.begin(), list.end(), [](const QFileInfo &a, const QFileInfo &b) {
+                    return a.size() > b.size();
+                });
+            } else {
+                std::sort(list.begin(), list.end(), [](const QFileInfo &a, const QFileInfo &b) {
+                    return a.lastModified() > b.lastModified();
+                });
+            }
+        }
+        QCOMPARE(list.size(), 100000);
+    }
+}
+
+void tst_QDir_100000::statList()
+{
+    const QDir dir(tempDir.path());
+    QBENCHMARK {
+        const QFileInfoList list = dir.entryInfoList(QDir::Files, QDir::Unsorted);
+        QFileInfo::stat(list);
+    }
+}
+
+QTEST_MAIN(tst_QDir_100000)
+
+#include "tst_bench_qdir_100000.moc"
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 #include <QDebug>
 #include <QDirIterator>
+#include <QParallelDirIterator>
 #include <QString>
 #include <qplatformdefs.h>
 
@@ -33,6 +34,12 @@ private slots:
     void posix_data() { data(); }
     void diriterator();
     void diriterator_data() { data(); }
+    void diriteratorSizes();
+    void diriteratorSizes_data() { data(); }
+    void paralleliterator();
+    void paralleliterator_data() { data(); }
+    void paralleliteratorSizes();
+    void paralleliteratorSizes_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
@@ -178,6 +185,69 @@ void tst_QDirIterator::diriterator()
     qDebug() << count;
 }
 
+void tst_QDirIterator::diriteratorSizes()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+    qint64 size = 0;
+
+    QBENCHMARK {
+        int c = 0;
+        qint64 s = 0;
+
+        QDirIterator dir(dirpath, QDir::Files, QDirIterator::Subdirectories);
+        while (dir.hasNext()) {
+            s += dir.nextFileInfo().size();
+            ++c;
+        }
+        count = c;
+        size = s;
+    }
+    qDebug() << count << size;
+}
+
+void tst_QDirIterator::paralleliterator()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+
+        QParallelDirIterator dir(dirpath, QDir::Files);
+        while (dir.hasNext()) {
+            dir.nextFileInfo();
+            ++c;
+        }
+        count = c;
+    }
+    qDebug() << count;
+}
+
+void tst_QDirIterator::paralleliteratorSizes()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+    qint64 size = 0;
+
+    QBENCHMARK {
+        int c = 0;
+        qint64 s = 0;
+
+        QParallelDirIterator dir(dirpath, QDir::Files, QParallelDirIterator::FetchMetaData);
+        while (dir.hasNext()) {
+            s += dir.nextFileInfo().size();
+            ++c;
+        }
+        count = c;
+        size = s;
+    }
+    qDebug() << count << size;
+}
+
 void tst_QDirIterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
@@ -5,6 +5,9 @@
 #include <QTemporaryFile>
 #include <QString>
 #include <QDirIterator>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 
 #include <private/qfsfileengine_p.h>
 
@@ -81,6 +84,9 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+    void readAllSmallFiles_data();
+    void readAllSmallFiles();
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -588,6 +594,45 @@ void tst_qfile::readSmallFiles()
     }
 }
 
+void tst_qfile::readAllSmallFiles_data()
+{
+    QTest::addColumn<bool>("async");
+    QTest::newRow("readAll") << false;
+#if QT_CONFIG(future)
+    QTest::newRow("readAllAsync") << true;
+#endif
+}
+
+void tst_qfile::readAllSmallFiles()
+{
+    QFETCH(bool, async);
+
+    QDir dir(tempDir.path());
+    QStringList files = dir.entryList(QDir::NoDotAndDotDot|QDir::NoSymLinks|QDir::Files);
+    for (QString &file : files)
+        file = dir.filePath(file);
+
+    qsizetype total = 0;
+    if (async) {
+#if QT_CONFIG(future)
+        QBENCHMARK {
+            const QList<QByteArray> contents = QFile::readAllAsync(files).results();
+            for (const QByteArray &data : contents)
+                total += data.size();
+        }
+#endif
+    } else {
+        QBENCHMARK {
+            for (const QString &fileName : std::as_const(files)) {
+                QFile file(fileName);
+                if (file.open(QIODevice::ReadOnly))
+                    total += file.readAll().size();
+            }
+        }
+    }
+    QVERIFY(total > 0);
+}
+
 QTEST_MAIN(tst_qfile)
 
 #include "tst_bench_qfile.moc"
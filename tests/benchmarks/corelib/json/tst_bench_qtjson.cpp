@@ -21,8 +21,14 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseLargeJson_data();
+    void parseLargeJson();
 
     void jsonObjectInsert();
+    void jsonObjectLookup_data();
+    void jsonObjectLookup();
+    void jsonObjectFromVariantHash_data();
+    void jsonObjectFromVariantHash();
     void variantMapInsert();
 };
 
@@ -93,6 +99,61 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtJson::parseLargeJson_data()
+{
+    QTest::addColumn<QByteArray>("text");
+    QTest::addColumn<bool>("view");
+
+    // log-like records with long string values, about 8 MB per document
+    auto makeLog = [](const QByteArray &message) {
+        QByteArray json = "[\n";
+        for (int i = 0; i < 20000; ++i) {
+            if (i)
+                json += ",\n";
+            json += "    {\"id\": " + QByteArray::number(i)
+                    + ", \"level\": \"info\", \"source\": \"/var/lib/service/worker.cpp\""
+                    + ", \"message\": \"" + message + "\"}";
+        }
+        return json + "\n]\n";
+    };
+    const QByteArray ascii = "Request completed without errors after retrying the upstream "
+                             "connection; the response was cached for later use by the other "
+                             "workers in this pool. ";
+    const QByteArray utf8 = "Anfrage ohne Fehler abgeschlossen, nachdem die Verbindung erneut "
+                            "aufgebaut wurde; die Antwort wurde für spätere Anfragen "
+                            "zwischengespeichert. ";
+    const QByteArray escaped = "Request completed:\\n\\tstatus \\\"ok\\\",\\n\\tpath "
+                               "\\\"C:\\\\data\\\\cache\\\", the response was cached for "
+                               "later use by the other workers in this pool. ";
+
+    for (bool view : { false, true }) {
+        const char *suffix = view ? "-view" : "";
+        QTest::addRow("ascii%s", suffix) << makeLog(ascii.repeated(3)) << view;
+        QTest::addRow("utf8%s", suffix) << makeLog(utf8.repeated(3)) << view;
+        QTest::addRow("escaped%s", suffix) << makeLog(escaped.repeated(3)) << view;
+    }
+}
+
+void BenchmarkQtJson::parseLargeJson()
+{
+    QFETCH(QByteArray, text);
+    QFETCH(bool, view);
+
+    QJsonParseError error;
+    QVERIFY(QJsonDocument::fromJson(text, &error).isArray());
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    if (view) {
+        QBENCHMARK {
+            QJsonDocument doc = QJsonDocument::fromJsonView(text);
+        }
+    } else {
+        QBENCHMARK {
+            QJsonDocument doc = QJsonDocument::fromJson(text);
+        }
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -105,6 +166,62 @@ void BenchmarkQtJson::jsonObjectInsert()
     }
 }
 
+static QStringList objectKeys(int count)
+{
+    QStringList keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; ++i)
+        keys.append(QStringLiteral("id-%1").arg(quint64(i) * 2654435761U % 1000003, 7, 10, QChar(u'0')));
+    return keys;
+}
+
+void BenchmarkQtJson::jsonObjectLookup_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("100k") << 100000;
+}
+
+void BenchmarkQtJson::jsonObjectLookup()
+{
+    QFETCH(int, count);
+
+    const QStringList keys = objectKeys(count);
+    QJsonObject object;
+    for (int i = 0; i < count; ++i)
+        object.insert(keys.at(i), i);
+
+    // every key once, plus as many keys that don't exist
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (const QString &key : keys) {
+            sum += object.value(key).toInteger();
+            sum += object.contains(QStringView(key).chopped(1));
+        }
+    }
+    QVERIFY(sum > 0 || count == 1);
+}
+
+void BenchmarkQtJson::jsonObjectFromVariantHash_data()
+{
+    jsonObjectLookup_data();
+}
+
+void BenchmarkQtJson::jsonObjectFromVariantHash()
+{
+    QFETCH(int, count);
+
+    QVariantHash hash;
+    for (const QString &key : objectKeys(count))
+        hash.insert(key, 1.5);
+
+    QBENCHMARK {
+        QJsonObject object = QJsonObject::fromVariantHash(hash);
+    }
+}
+
 void BenchmarkQtJson::variantMapInsert()
 {
     QVariantMap object;
@@ -0,0 +1,110 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QCoreApplication>
+#include <QSocketNotifier>
+
+#include <private/qeventdispatcher_unix_p.h>
+
+#include <memory>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void socketNotifierWakeUp_data();
+    void socketNotifierWakeUp();
+};
+
+void tst_QEventDispatcher::initTestCase()
+{
+    // the larger rows need two descriptors per notifier
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QEventDispatcher::socketNotifierWakeUp_data()
+{
+    QTest::addColumn<bool>("useEpoll");
+    QTest::addColumn<int>("count");
+
+    const int counts[] = { 1, 10, 100, 1000, 10000 };
+    for (int count : counts)
+        QTest::addRow("poll:%d", count) << false << count;
+#if QT_CONFIG(epoll)
+    for (int count : counts)
+        QTest::addRow("epoll:%d", count) << true << count;
+#endif
+}
+
+// Measures the cost of one wake-up of the dispatcher when exactly one of
+// "count" registered read notifiers is ready.
+void tst_QEventDispatcher::socketNotifierWakeUp()
+{
+    QFETCH(bool, useEpoll);
+    QFETCH(int, count);
+
+    // the mode is picked when the dispatcher is constructed
+    if (useEpoll)
+        qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    else
+        qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+    QEventDispatcherUNIX dispatcher;
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+
+    struct Pipe
+    {
+        int fds[2] = { -1, -1 };
+        std::unique_ptr<QSocketNotifier> notifier;
+        ~Pipe()
+        {
+            notifier.reset();
+            for (int fd : fds) {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        }
+    };
+    std::vector<Pipe> pipes(count);
+
+    int activations = 0;
+    for (Pipe &p : pipes) {
+        if (::pipe(p.fds) == -1)
+            QSKIP("Not enough file descriptors for this row");
+        p.notifier.reset(new QSocketNotifier(p.fds[0], QSocketNotifier::Read));
+        // drive the notifier from our dispatcher rather than the thread's
+        p.notifier->setEnabled(false);
+        dispatcher.registerSocketNotifier(p.notifier.get());
+        connect(p.notifier.get(), &QSocketNotifier::activated, this, [&activations](QSocketDescriptor fd) {
+            char c;
+            QCOMPARE(::read(fd, &c, 1), ssize_t(1));
+            ++activations;
+        });
+    }
+
+    int next = 0;
+    QBENCHMARK {
+        const char c = 'x';
+        QCOMPARE(::write(pipes[next].fds[1], &c, 1), ssize_t(1));
+        dispatcher.processEvents(QEventLoop::WaitForMoreEvents);
+        next = (next + 1) % count;
+    }
+    QVERIFY(activations > 0);
+
+    for (Pipe &p : pipes)
+        dispatcher.unregisterSocketNotifier(p.notifier.get());
+}
+
+QTEST_MAIN(tst_QEventDispatcher)
+
+#include "tst_bench_qeventdispatcher.moc"
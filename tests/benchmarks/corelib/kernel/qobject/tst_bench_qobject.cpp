@@ -26,6 +26,8 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void queued_connection_throughput_data();
+    void queued_connection_throughput();
 
     void stdAllocator();
 };
@@ -280,6 +282,53 @@ void tst_QObject::receiver_destroyed_benchmark()
     }
 }
 
+void tst_QObject::queued_connection_throughput_data()
+{
+    QTest::addColumn<int>("producerCount");
+    QTest::addColumn<bool>("batched");
+    for (int producers : { 1, 2, 4, 8 }) {
+        const QByteArray name = QByteArray::number(producers)
+                + (producers == 1 ? " producer" : " producers");
+        QTest::newRow(name.constData()) << producers << false;
+        QTest::newRow((name + ", batched").constData()) << producers << true;
+    }
+}
+
+void tst_QObject::queued_connection_throughput()
+{
+    QFETCH(int, producerCount);
+    QFETCH(bool, batched);
+    constexpr int EmissionsPerProducer = 20000;
+    const int total = producerCount * EmissionsPerProducer;
+
+    // the senders live in this thread, but emit from the producer threads;
+    // the receiver's thread (this one) drains the queued invocations
+    std::vector<Object> senders(producerCount);
+    QObject receiver;
+    int received = 0;
+    for (Object &sender : senders) {
+        QObject::connect(&sender, &Object::signal0, &receiver, [&received] { ++received; },
+                         batched ? Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)
+                                 : Qt::QueuedConnection);
+    }
+
+    QBENCHMARK {
+        received = 0;
+        std::vector<std::unique_ptr<QThread>> producers;
+        for (Object &sender : senders) {
+            producers.emplace_back(QThread::create([&sender] {
+                for (int i = 0; i < EmissionsPerProducer; ++i)
+                    sender.emitSignal0();
+            }));
+            producers.back()->start();
+        }
+        while (received < total)
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        for (auto &producer : producers)
+            producer->wait();
+    }
+}
+
 QTEST_MAIN(tst_QObject)
 
 #include "tst_bench_qobject.moc"
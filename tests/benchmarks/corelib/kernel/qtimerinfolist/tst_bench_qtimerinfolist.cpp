@@ -0,0 +1,97 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QObject>
+#include <QRandomGenerator>
+
+#include <private/qtimerinfo_unix_p.h>
+
+using namespace std::chrono_literals;
+
+class tst_QTimerInfoList : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void registerTimers_data();
+    void registerTimers();
+    void churn_data();
+    void churn();
+};
+
+static void addCountRows()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("timerType");
+
+    const int counts[] = { 1000, 10000, 100000 };
+    for (int count : counts) {
+        QTest::addRow("precise:%d", count) << count << Qt::PreciseTimer;
+        QTest::addRow("coarse:%d", count) << count << Qt::CoarseTimer;
+    }
+}
+
+static std::chrono::milliseconds randomInterval(QRandomGenerator &rng)
+{
+    // idle/retry style timeouts between 100 ms and 30 s
+    return std::chrono::milliseconds{ rng.bounded(100, 30000) };
+}
+
+void tst_QTimerInfoList::registerTimers_data()
+{
+    addCountRows();
+}
+
+void tst_QTimerInfoList::registerTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, timerType);
+
+    QObject receiver;
+    QRandomGenerator rng(count);
+
+    QBENCHMARK {
+        QTimerInfoList list;
+        for (int id = 1; id <= count; ++id)
+            list.registerTimer(id, randomInterval(rng), timerType, &receiver);
+        QCOMPARE(list.size(), qsizetype(count));
+        list.clearTimers();
+    }
+}
+
+void tst_QTimerInfoList::churn_data()
+{
+    addCountRows();
+}
+
+// Restarts a batch of timers the way per-connection idle timers get reset on
+// traffic, then lets the dispatcher compute its next wake-up.
+void tst_QTimerInfoList::churn()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, timerType);
+
+    QObject receiver;
+    QRandomGenerator rng(count);
+    QTimerInfoList list;
+    for (int id = 1; id <= count; ++id)
+        list.registerTimer(id, randomInterval(rng), timerType, &receiver);
+
+    constexpr int BatchSize = 1000;
+    QBENCHMARK {
+        for (int i = 0; i < BatchSize; ++i) {
+            const int id = 1 + rng.bounded(count);
+            QVERIFY(list.unregisterTimer(id));
+            list.registerTimer(id, randomInterval(rng), timerType, &receiver);
+        }
+        QVERIFY(list.timerWait().has_value());
+        list.activateTimers();
+    }
+    QCOMPARE(list.size(), qsizetype(count));
+    list.clearTimers();
+}
+
+QTEST_MAIN(tst_QTimerInfoList)
+
+#include "tst_bench_qtimerinfolist.moc"
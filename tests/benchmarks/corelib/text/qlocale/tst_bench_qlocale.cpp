@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include <QLocale>
+#include <QRandomGenerator>
 #include <QTest>
 
 using namespace Qt::StringLiterals;
@@ -37,6 +38,10 @@ private Q_SLOTS:
     void toULongLong();
     void toDouble_data();
     void toDouble();
+    void columnToDouble_data();
+    void columnToDouble();
+    void columnToLongLong_data();
+    void columnToLongLong();
 };
 
 static QString data()
@@ -588,6 +593,122 @@ void tst_QLocale::toDouble()
     QCOMPARE(actual, expected);
 }
 
+// Parsing a column of numbers, as when ingesting CSV or JSON data:
+
+enum class Parser { CLocale, EnLocale, String, ByteArray };
+Q_DECLARE_METATYPE(Parser)
+
+static QList<QByteArray> column(int kind)
+{
+    QRandomGenerator rng(kind);
+    QList<QByteArray> result;
+    for (int i = 0; i < 10000; ++i) {
+        const double value = rng.generateDouble();
+        switch (kind) {
+        case 0: // prices
+            result.append(QByteArray::number(rng.bounded(100000) / 100.0, 'f', 2));
+            break;
+        case 1: // measurements
+            result.append(QByteArray::number(value * 1000, 'g', 6));
+            break;
+        case 2: // round-trip precision, as JSON writers produce
+            result.append(QByteArray::number(value, 'g', QLocale::FloatingPointShortest));
+            break;
+        case 3: // scientific
+            result.append(QByteArray::number((value - 0.5) * 1e-20, 'e', 10));
+            break;
+        case 4: // identifiers
+            result.append(QByteArray::number(rng.generate64() >> (1 + rng.bounded(63))));
+            break;
+        case 5: // signed counts
+            result.append(QByteArray::number(qint64(rng.bounded(2000000)) - 1000000));
+            break;
+        }
+    }
+    return result;
+}
+
+static void column_data(std::initializer_list<std::pair<int, const char *>> kinds)
+{
+    QTest::addColumn<Parser>("parser");
+    QTest::addColumn<QList<QByteArray>>("data");
+
+    for (auto [kind, name] : kinds) {
+        const QList<QByteArray> data = column(kind);
+        QTest::addRow("%s-QLocale::c()", name) << Parser::CLocale << data;
+        QTest::addRow("%s-QLocale(en)", name) << Parser::EnLocale << data;
+        QTest::addRow("%s-QString", name) << Parser::String << data;
+        QTest::addRow("%s-QByteArray", name) << Parser::ByteArray << data;
+    }
+}
+
+template <typename T>
+static void column()
+{
+    QFETCH(const Parser, parser);
+    QFETCH(const QList<QByteArray>, data);
+
+    QList<QString> strings;
+    for (const QByteArray &number : data)
+        strings.append(QString::fromLatin1(number));
+    const QLocale c = QLocale::c();
+    QLocale en(QLocale::English);
+    en.setNumberOptions(QLocale::OmitGroupSeparator);
+
+    const auto convert = [&](qsizetype i, bool *ok) -> T {
+        if constexpr (std::is_same_v<T, double>) {
+            switch (parser) {
+            case Parser::CLocale: return c.toDouble(strings.at(i), ok);
+            case Parser::EnLocale: return en.toDouble(strings.at(i), ok);
+            case Parser::String: return strings.at(i).toDouble(ok);
+            case Parser::ByteArray: return data.at(i).toDouble(ok);
+            }
+        } else {
+            switch (parser) {
+            case Parser::CLocale: return c.toLongLong(strings.at(i), ok);
+            case Parser::EnLocale: return en.toLongLong(strings.at(i), ok);
+            case Parser::String: return strings.at(i).toLongLong(ok);
+            case Parser::ByteArray: return data.at(i).toLongLong(ok);
+            }
+        }
+        Q_UNREACHABLE_RETURN(T());
+    };
+
+    T sum = 0;
+    bool ok = true;
+    QBENCHMARK {
+        sum = 0;
+        ok = true;
+        for (qsizetype i = 0; i < data.size(); ++i) {
+            bool good = false;
+            sum += convert(i, &good);
+            ok &= good;
+        }
+    }
+    QVERIFY(ok);
+}
+
+void tst_QLocale::columnToDouble_data()
+{
+    column_data({ { 0, "prices" }, { 1, "measurements" }, { 2, "shortest" },
+                  { 3, "scientific" } });
+}
+
+void tst_QLocale::columnToDouble()
+{
+    column<double>();
+}
+
+void tst_QLocale::columnToLongLong_data()
+{
+    column_data({ { 4, "identifiers" }, { 5, "counts" } });
+}
+
+void tst_QLocale::columnToLongLong()
+{
+    column<qint64>();
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
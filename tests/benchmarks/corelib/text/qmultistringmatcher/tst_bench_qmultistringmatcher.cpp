@@ -0,0 +1,162 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QByteArrayMatcher>
+#include <QMultiByteArrayMatcher>
+#include <QMultiStringMatcher>
+#include <QRandomGenerator>
+#include <QStringMatcher>
+#include <QTest>
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_QMultiStringMatcher();
+
+private slots:
+    void multiByteArrayMatcher_data() { keywords_data(); }
+    void multiByteArrayMatcher();
+    void byteArrayMatcherLoop_data() { keywords_data(); }
+    void byteArrayMatcherLoop();
+    void multiStringMatcher_data() { keywords_data(); }
+    void multiStringMatcher();
+    void stringMatcherLoop_data() { keywords_data(); }
+    void stringMatcherLoop();
+
+private:
+    void keywords_data();
+
+    QList<QByteArray> words;
+    QList<QByteArray> lines;
+};
+
+// Lines of a log made of random words, and keywords to filter them, of which
+// the first few occur in the log.
+tst_QMultiStringMatcher::tst_QMultiStringMatcher()
+{
+    QRandomGenerator rng(42);
+    for (int i = 0; i < 1000; ++i) {
+        QByteArray word;
+        for (int n = 4 + rng.bounded(6); n > 0; --n)
+            word += char('a' + rng.bounded(26));
+        words.append(word);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        QByteArray line = "2023-10-18 12:34:56.789 [" + QByteArray::number(i % 17) + "] ";
+        for (int n = 5 + rng.bounded(10); n > 0; --n)
+            line += words.at(rng.bounded(100)) + ' ';
+        lines.append(line);
+    }
+}
+
+void tst_QMultiStringMatcher::keywords_data()
+{
+    QTest::addColumn<QList<QByteArray>>("keywords");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int count : { 1, 10, 100, 500 }) {
+        QList<QByteArray> keywords;
+        // one in the log, the others not
+        keywords.append(words.at(7));
+        for (int i = 1; i < count; ++i)
+            keywords.append(words.at(100 + i));
+        QTest::addRow("%d", count) << keywords << Qt::CaseSensitive;
+        QTest::addRow("%d-ci", count) << keywords << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QMultiStringMatcher::multiByteArrayMatcher()
+{
+    QFETCH(QList<QByteArray>, keywords);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    const QMultiByteArrayMatcher matcher(keywords, cs);
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QByteArray &line : std::as_const(lines))
+            found += matcher.indexIn(line) >= 0;
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::byteArrayMatcherLoop()
+{
+    QFETCH(QList<QByteArray>, keywords);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    // QByteArrayMatcher can't ignore case; lowercase the lines instead,
+    // which is what one would have to do
+    QList<QByteArrayMatcher> matchers;
+    for (const QByteArray &keyword : std::as_const(keywords))
+        matchers.append(QByteArrayMatcher(cs == Qt::CaseSensitive ? keyword : keyword.toLower()));
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QByteArray &line : std::as_const(lines)) {
+            const QByteArray text = cs == Qt::CaseSensitive ? line : line.toLower();
+            for (const QByteArrayMatcher &matcher : std::as_const(matchers)) {
+                if (matcher.indexIn(text) >= 0) {
+                    ++found;
+                    break;
+                }
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::multiStringMatcher()
+{
+    QFETCH(QList<QByteArray>, keywords);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    QList<QString> patterns;
+    for (const QByteArray &keyword : std::as_const(keywords))
+        patterns.append(QString::fromLatin1(keyword));
+    QList<QString> strings;
+    for (const QByteArray &line : std::as_const(lines))
+        strings.append(QString::fromLatin1(line));
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &line : std::as_const(strings))
+            found += matcher.indexIn(line) >= 0;
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::stringMatcherLoop()
+{
+    QFETCH(QList<QByteArray>, keywords);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    QList<QStringMatcher> matchers;
+    for (const QByteArray &keyword : std::as_const(keywords))
+        matchers.append(QStringMatcher(QString::fromLatin1(keyword), cs));
+    QList<QString> strings;
+    for (const QByteArray &line : std::as_const(lines))
+        strings.append(QString::fromLatin1(line));
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &line : std::as_const(strings)) {
+            for (const QStringMatcher &matcher : std::as_const(matchers)) {
+                if (matcher.indexIn(line) >= 0) {
+                    ++found;
+                    break;
+                }
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_bench_qmultistringmatcher.moc"
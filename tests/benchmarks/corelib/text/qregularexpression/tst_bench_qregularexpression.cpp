@@ -4,6 +4,8 @@
 #include <QRegularExpression>
 #include <QTest>
 
+using namespace Qt::StringLiterals;
+
 /*!
     \internal
     The main idea of the benchmark is to compare performance of QRE classes
@@ -33,6 +35,7 @@ private slots:
     void matchDefaultOptimized();
 
     void matchCustom();
+    void matchCustomUncached();
     void matchCustomOptimized();
 
     void globalMatchDefault();
@@ -45,6 +48,14 @@ private slots:
     void queryMatchResultsByGroupIndex();
     void queryMatchResultsByGroupName();
     void iterateThroughGlobalMatchResults();
+
+    void matchSet_data() { routes_data(); }
+    void matchSet();
+    void matchLoop_data() { routes_data(); }
+    void matchLoop();
+
+private:
+    void routes_data();
 };
 
 void tst_QRegularExpressionBenchmark::createDefault()
@@ -123,8 +134,8 @@ void tst_QRegularExpressionBenchmark::matchDefaultOptimized()
     \internal This benchmark measures the performance of the match() together
     with pattern compilation for an object with custom pattern and pattern
     options.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    We create the object every time, so that its compiled pattern has to be
+    looked up in the process-wide cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::matchCustom()
 {
@@ -135,6 +146,22 @@ void tst_QRegularExpressionBenchmark::matchCustom()
     }
 }
 
+/*!
+    \internal This benchmark measures the performance of the match() together
+    with pattern compilation for an object with custom pattern and pattern
+    options, which is never found in the cache of compiled patterns: every
+    iteration uses a different pattern (by means of a comment).
+*/
+void tst_QRegularExpressionBenchmark::matchCustomUncached()
+{
+    int i = 0;
+    QBENCHMARK {
+        QRegularExpression re(nonEmptyPattern + u"(?#%1)"_s.arg(++i), nonEmptyPatternOptions);
+        auto matchResult = re.match(textToMatch);
+        Q_UNUSED(matchResult);
+    }
+}
+
 /*!
     \internal This benchmark measures the performance of the match() without
     pattern compilation for an object with custom pattern and pattern
@@ -270,6 +297,79 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+/*!
+    \internal A routing table: URL patterns and URLs to dispatch through it,
+    most of which are handled by one of the last patterns.
+*/
+void tst_QRegularExpressionBenchmark::routes_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QStringList>("subjects");
+
+    for (int count : { 10, 100 }) {
+        QStringList patterns;
+        for (int i = 0; i < count; ++i)
+            patterns.append(u"^/api/v%1/(?<resource>users|groups)/(?<id>\\d+)$"_s.arg(i));
+        patterns.append(u"^/static/.*\\.(?:png|svg|css|js)$"_s);
+
+        QStringList subjects;
+        for (int i = 0; i < 100; ++i) {
+            subjects.append(u"/api/v%1/users/%2"_s.arg(count - 1 - i % 5).arg(i));
+            subjects.append(u"/static/images/icon%1.png"_s.arg(i));
+            subjects.append(u"/nowhere/%1"_s.arg(i));
+        }
+        QTest::addRow("%d", count) << patterns << subjects;
+    }
+}
+
+/*!
+    \internal This benchmark measures the performance of dispatching URLs
+    through a routing table with QRegularExpressionSet.
+*/
+void tst_QRegularExpressionBenchmark::matchSet()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QStringList, subjects);
+
+    const QRegularExpressionSet set(patterns);
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &subject : std::as_const(subjects))
+            found += set.firstMatchingPattern(subject) >= 0;
+    }
+    QCOMPARE(found, 200);
+}
+
+/*!
+    \internal This benchmark measures the performance of dispatching URLs
+    through a routing table with a list of QRegularExpression objects.
+*/
+void tst_QRegularExpressionBenchmark::matchLoop()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QStringList, subjects);
+
+    QList<QRegularExpression> expressions;
+    for (const QString &pattern : std::as_const(patterns)) {
+        expressions.append(QRegularExpression(pattern));
+        expressions.constLast().optimize();
+    }
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &subject : std::as_const(subjects)) {
+            for (const QRegularExpression &re : std::as_const(expressions)) {
+                if (re.match(subject).hasMatch()) {
+                    ++found;
+                    break;
+                }
+            }
+        }
+    }
+    QCOMPARE(found, 200);
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
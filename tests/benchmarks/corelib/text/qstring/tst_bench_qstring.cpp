@@ -3,6 +3,7 @@
 #include <QStringList>
 #include <QByteArray>
 #include <QLatin1StringView>
+#include <QUtf8StringView>
 #include <QFile>
 #include <QTest>
 #include <limits>
@@ -28,6 +29,14 @@ private slots:
     void toCaseFolded_data();
     void toCaseFolded();
 
+    // UTF-8 conversion
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data() { fromUtf8_data(); }
+    void toUtf8();
+    void isValidUtf8_data() { fromUtf8_data(); }
+    void isValidUtf8();
+
     // Serializing:
     void number_qlonglong_data();
     void number_qlonglong() { number_impl<qlonglong>(); }
@@ -197,6 +206,59 @@ void tst_QString::toCaseFolded()
     }
 }
 
+void tst_QString::fromUtf8_data()
+{
+    QTest::addColumn<QString>("s");
+
+    // Typical text of a few scripts, with ASCII spaces and punctuation
+    // between words, repeated up to about 64k characters.
+    const auto repeated = [](QStringView text) {
+        QString s;
+        while (s.size() < 64 * 1024)
+            s += text;
+        return s;
+    };
+    QTest::newRow("ascii") << repeated(u"The quick brown fox jumps over the lazy dog. ");
+    QTest::newRow("latin1") << repeated(u"Größere Übungen für Käse, Öl und Bücher. ");
+    QTest::newRow("greek") << repeated(u"Η γρήγορη καφέ αλεπού πηδά πάνω από τον σκύλο. ");
+    QTest::newRow("cyrillic") << repeated(u"Съешь же ещё этих мягких французских булок. ");
+    QTest::newRow("hebrew") << repeated(u"דג סקרן שט בים מאוכזב ולפתע מצא חברה. ");
+    QTest::newRow("chinese") << repeated(u"我能吞下玻璃而不伤身体。敏捷的棕色狐狸跳过了懒狗。");
+    QTest::newRow("japanese") << repeated(u"いろはにほへと ちりぬるを わかよたれそ つねならむ。");
+    QTest::newRow("emoji") << repeated(u"Good \U0001F600 night \U0001F319 sleep \U0001F634 well. ");
+}
+
+void tst_QString::fromUtf8()
+{
+    QFETCH(QString, s);
+    const QByteArray utf8 = s.toUtf8();
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = QString::fromUtf8(utf8);
+    }
+}
+
+void tst_QString::toUtf8()
+{
+    QFETCH(QString, s);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = s.toUtf8();
+    }
+}
+
+void tst_QString::isValidUtf8()
+{
+    QFETCH(QString, s);
+    const QByteArray utf8 = s.toUtf8();
+
+    bool valid = true;
+    QBENCHMARK {
+        valid = QUtf8StringView(utf8).isValidUtf8() && valid;
+    }
+    QVERIFY(valid);
+}
+
 template <typename Integer>
 void tst_QString::number_impl()
 {
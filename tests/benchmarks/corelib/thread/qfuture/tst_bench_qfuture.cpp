@@ -28,6 +28,8 @@ private slots:
 #endif
     void then();
     void thenVoid();
+    void thenChain_data();
+    void thenChain();
     void onCanceled();
     void onCanceledVoid();
 #ifndef QT_NO_EXCEPTIONS
@@ -156,6 +158,33 @@ void tst_QFuture::thenVoid()
     }
 }
 
+void tst_QFuture::thenChain_data()
+{
+    QTest::addColumn<int>("length");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+}
+
+void tst_QFuture::thenChain()
+{
+    QFETCH(int, length);
+
+    // time from fulfilling the promise until the result has passed through
+    // the whole chain of synchronous continuations
+    QBENCHMARK {
+        QPromise<int> promise;
+        QFuture<int> future = promise.future();
+        for (int i = 0; i < length; ++i)
+            future = future.then([](int value) { return value + 1; });
+        promise.start();
+        promise.addResult(0);
+        promise.finish();
+        QCOMPARE(future.result(), length);
+    }
+}
+
 void tst_QFuture::onCanceled()
 {
     QFutureInterface<int> fi;
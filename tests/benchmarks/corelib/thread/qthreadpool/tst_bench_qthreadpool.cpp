@@ -15,6 +15,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void spawnFromWorkers_data();
+    void spawnFromWorkers();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +52,53 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::spawnFromWorkers_data()
+{
+    QTest::addColumn<bool>("workStealing");
+    QTest::addColumn<int>("threadCount");
+
+    QList<int> threadCounts = { 1, 2, 4, 8 };
+    if (QThread::idealThreadCount() > threadCounts.constLast())
+        threadCounts << QThread::idealThreadCount();
+    for (int threads : std::as_const(threadCounts)) {
+        QTest::addRow("shared-queue:%d", threads) << false << threads;
+        QTest::addRow("work-stealing:%d", threads) << true << threads;
+    }
+}
+
+// Every worker floods the pool with tiny runnables, the way divide-and-conquer
+// algorithms do; shows how the pool scales with the number of threads.
+void tst_QThreadPool::spawnFromWorkers()
+{
+    QFETCH(bool, workStealing);
+    QFETCH(int, threadCount);
+
+    constexpr int TasksPerThread = 10000;
+    const int total = threadCount * TasksPerThread;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QAtomicInt remaining;
+    QSemaphore done;
+    QBENCHMARK {
+        remaining.storeRelaxed(total);
+        for (int i = 0; i < threadCount; ++i) {
+            threadPool.start([&] {
+                for (int j = 0; j < TasksPerThread; ++j) {
+                    threadPool.start([&] {
+                        if (!remaining.deref())
+                            done.release();
+                    });
+                }
+            });
+        }
+        done.acquire();
+    }
+    threadPool.waitForDone();
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
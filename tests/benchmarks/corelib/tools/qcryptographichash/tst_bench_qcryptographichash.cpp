@@ -9,6 +9,7 @@
 #include <QMessageAuthenticationCode>
 #include <QRandomGenerator>
 #include <QString>
+#include <QTemporaryFile>
 #include <QTest>
 
 #include <qxpfunctional.h>
@@ -33,6 +34,8 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void addDataFile_data();
+    void addDataFile();
 
     // QMessageAuthenticationCode:
     void hmac_hash_data() { hash_data(); }
@@ -41,6 +44,16 @@ private Q_SLOTS:
     void hmac_addData();
     void hmac_setKey_data();
     void hmac_setKey();
+
+    // many buffers at once, and tree hashing:
+    void hashLoop_data() { hashMany_data(); }
+    void hashLoop();
+    void hashMany_data();
+    void hashMany();
+    void hashLarge_data() { hashTree_data(); }
+    void hashLarge();
+    void hashTree_data();
+    void hashTree();
 };
 
 const int MaxBlockSize = 65536;
@@ -142,6 +155,45 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::addDataFile_data()
+{
+    QTest::addColumn<Algorithm>("algo");
+    QTest::addColumn<QIODevice::OpenMode>("mode");
+
+    for (Algorithm algo : { Algorithm::Md5, Algorithm::Sha1, Algorithm::Blake2s_256 }) {
+        const char *name = QMetaEnum::fromType<Algorithm>().valueToKey(algo);
+        QTest::addRow("%s-buffered", name) << algo << QIODevice::OpenMode(QIODevice::ReadOnly);
+        QTest::addRow("%s-unbuffered", name)
+                << algo << (QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+}
+
+void tst_QCryptographicHash::addDataFile()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const QIODevice::OpenMode, mode);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    // 64 MiB, in the page cache
+    QTemporaryFile temp;
+    QVERIFY(temp.open());
+    for (int i = 0; i < 1024; ++i)
+        QCOMPARE(temp.write(blockOfData), blockOfData.size());
+    temp.close();
+
+    QFile file(temp.fileName());
+    QVERIFY(file.open(mode));
+    QCryptographicHash hash(algo);
+    QBENCHMARK {
+        hash.reset();
+        file.seek(0);
+        hash.addData(&file);
+        [[maybe_unused]]
+        auto r = hash.resultView();
+    }
+}
+
 static QByteArray hmacKey() {
     static QByteArray key = [] {
             QByteArray result(277, Qt::Uninitialized);
@@ -216,6 +268,94 @@ void tst_QCryptographicHash::hmac_setKey()
     }
 }
 
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<Algorithm>("algo");
+    QTest::addColumn<QList<QByteArray>>("data");
+
+    // 1024 buffers, e.g. the chunks or the small files of a content-addressed
+    // cache; the total amount of data is what counts, to compare throughputs
+    for (int size : { 64, 1024, 16384 }) {
+        QList<QByteArray> data;
+        for (int i = 0; i < 1024; ++i)
+            data.append(QByteArray::fromRawData(blockOfData.constData() + i % 64, size - i % 64));
+        for (Algorithm algo : { Algorithm::Sha1, Algorithm::Sha256, Algorithm::Blake2s_256,
+                                Algorithm::Sha512 }) {
+            const char *name = QMetaEnum::fromType<Algorithm>().valueToKey(algo);
+            QTest::addRow("%s-1024x%d", name, size) << algo << data;
+        }
+    }
+}
+
+void tst_QCryptographicHash::hashLoop()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const QList<QByteArray>, data);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    QBENCHMARK {
+        for (const QByteArray &buffer : data) {
+            [[maybe_unused]]
+            auto r = QCryptographicHash::hash(buffer, algo);
+        }
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const QList<QByteArray>, data);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    QBENCHMARK {
+        [[maybe_unused]]
+        auto r = QCryptographicHash::hashMany(data, algo);
+    }
+}
+
+void tst_QCryptographicHash::hashTree_data()
+{
+    QTest::addColumn<Algorithm>("algo");
+    QTest::addColumn<QByteArray>("data");
+
+    // 64 MiB, as a large file would be
+    QByteArray data;
+    for (int i = 0; i < 1024; ++i)
+        data += blockOfData;
+    for (Algorithm algo : { Algorithm::Sha1, Algorithm::Sha256, Algorithm::Blake2s_256 }) {
+        const char *name = QMetaEnum::fromType<Algorithm>().valueToKey(algo);
+        QTest::addRow("%s-64MiB", name) << algo << data;
+    }
+}
+
+void tst_QCryptographicHash::hashLarge()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const QByteArray, data);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    QBENCHMARK {
+        [[maybe_unused]]
+        auto r = QCryptographicHash::hash(data, algo);
+    }
+}
+
+void tst_QCryptographicHash::hashTree()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const QByteArray, data);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    QBENCHMARK {
+        [[maybe_unused]]
+        auto r = QCryptographicHash::hashTree(data, algo);
+    }
+}
+
 #undef SKIP_IF_NOT_SUPPORTED
 
 QTEST_APPLESS_MAIN(tst_QCryptographicHash)